@@ -3,11 +3,11 @@
 #include "axz_error_codes.h"
 #include <cassert>
 #include <cstring>
+#include <cwchar>
 #include <stdexcept>
 #include <algorithm>
 #include <shared_mutex>
 #include <functional>
-#include <immintrin.h>  // For SIMD operations
 
 // Global performance counters
 namespace axz_performance {
@@ -15,10 +15,18 @@ namespace axz_performance {
     StringPool g_string_pool;
 }
 
-// Optimized axz_dict_object to use ultra-fast hash and equal functions
-using axz_dict_object_safe = std::unordered_map<axz_wstring, AxzDict, 
-                                               axz_hash_internal::UltraFastWStringHash, 
-                                               axz_hash_internal::UltraFastWStringEqual>;
+// Per-node statistics are compiled out together with the per-node locks. They are counted on the
+// heap node (inline scalars have none); the caller must not hold m_mutex exclusively.
+#if AXZDICT_UNSYNCHRONIZED
+#define _AXZ_STAT_INC( counter ) ((void)0)
+#else
+#define _AXZ_STAT_INC( counter ) \
+	do { \
+		std::shared_lock<axz_dict_mutex> _statLock( m_mutex ); \
+		if ( m_val ) m_val->stats.counter.fetch_add( 1, std::memory_order_relaxed ); \
+	} while ( 0 )
+#endif
+
 
 template<bool isDict>
 struct _AxzBool2Type
@@ -26,12 +34,49 @@ struct _AxzBool2Type
 	enum{ val = isDict };
 };
 
+// Active arena of the calling thread, see AxzDictArenaScope
+static thread_local axz_shared_arena _axz_current_arena;
+
+/*
+ * Allocator handing out arena memory - deallocation is a no-op, the control block keeps the arena alive
+ */
+template<class T>
+struct _AxzArenaAllocator
+{
+	using value_type = T;
+
+	explicit _AxzArenaAllocator( axz_shared_arena arena ) noexcept : m_arena( std::move( arena ) ) {}
+	template<class U>
+	_AxzArenaAllocator( const _AxzArenaAllocator<U>& other ) noexcept : m_arena( other.m_arena ) {}
+
+	T* allocate( size_t n )							{ return static_cast<T*>( this->m_arena->allocate( n * sizeof( T ), alignof( T ) ) ); }
+	void deallocate( T*, size_t ) noexcept			{}
+
+	template<class U>
+	bool operator==( const _AxzArenaAllocator<U>& other ) const noexcept { return this->m_arena == other.m_arena; }
+	template<class U>
+	bool operator!=( const _AxzArenaAllocator<U>& other ) const noexcept { return this->m_arena != other.m_arena; }
+
+	axz_shared_arena m_arena;
+};
+
+// Allocate a value node from the active arena, or from the heap when there is none
+template<class T, class... Args>
+std::shared_ptr<_AxzDicVal> _AxzMakeVal( Args&&... args )
+{
+	const axz_shared_arena& arena = _axz_current_arena;
+	if ( arena )
+	{
+		return std::allocate_shared<T>( _AxzArenaAllocator<T>( arena ), std::forward<Args>( args )... );
+	}
+	return std::make_shared<T>( std::forward<Args>( args )... );
+}
+
 class _AxzDictVal;
 struct _AxzDicDefault 
 {	
+	// Stands in for the node of inline scalars - rejects every string and container operation
 	static const std::shared_ptr<_AxzDicVal> nullVal;
-	static const std::shared_ptr<_AxzDicVal> trueVal;
-	static const std::shared_ptr<_AxzDicVal> falseVal;
 };
 
 namespace
@@ -67,6 +112,49 @@ namespace Internal
 }
 };
 
+/*
+ * Serialization cache of one container. parents are the containers whose cached text embeds this one; they
+ * are registered while serializing, so a change only has to walk the path it invalidates. Writes through a
+ * reference from the non-const operator[] or iterator never reach this container, so once one has been
+ * handed out the container is exposed and is written afresh, together with everything containing it.
+ */
+struct _AxzJsonCache
+{
+	std::mutex lock;
+	std::shared_ptr<const std::string> json;
+	bool valid = false;
+	std::vector<std::weak_ptr<_AxzDicVal>> parents;
+};
+
+// Lazily allocated cache pointer - containers that are never serialized pay one null pointer
+class _AxzJsonCacheSlot
+{
+public:
+	_AxzJsonCacheSlot() = default;
+	_AxzJsonCacheSlot( const _AxzJsonCacheSlot& ) {}
+	_AxzJsonCacheSlot& operator=( const _AxzJsonCacheSlot& ) = delete;
+	~_AxzJsonCacheSlot()														{ delete this->m_cache.load( std::memory_order_relaxed ); }
+
+	_AxzJsonCache* get() const noexcept										{ return this->m_cache.load( std::memory_order_acquire ); }
+	void expose() noexcept													{ this->m_exposed.store( true, std::memory_order_release ); }
+	bool exposed() const noexcept											{ return this->m_exposed.load( std::memory_order_acquire ); }
+	_AxzJsonCache* create()
+	{
+		_AxzJsonCache* cache = this->get();
+		if ( cache )
+			return cache;
+		auto* fresh = new _AxzJsonCache();
+		if ( this->m_cache.compare_exchange_strong( cache, fresh, std::memory_order_acq_rel ) )
+			return fresh;
+		delete fresh;
+		return cache;
+	}
+
+private:
+	std::atomic<_AxzJsonCache*> m_cache{ nullptr };
+	std::atomic<bool> m_exposed{ false };		// for good: references may be held indefinitely
+};
+
 class _AxzDicVal
 {
 public:
@@ -120,12 +208,15 @@ public:
 	virtual int32_t intVal() const                  						{ throw std::invalid_argument( "AxzDict::intVal available for number only" ); }
 	virtual bool boolVal() const                							{ throw std::invalid_argument( "AxzDict::boolVal available for boolean only" ); }
 	virtual axz_wstring stringVal() const									{ throw std::invalid_argument( "AxzDict::stringVal available for string only" ); }
+	virtual const axz_wstring& stringRef() const							{ throw std::invalid_argument( "AxzDict::stringRef available for string only" ); }
 	virtual axz_bytes bytesVal() const										{ throw std::invalid_argument( "AxzDict::bytesVal available for bytes only" ); }
 
 	virtual axz_rc add( const AxzDict& val )	                            { return AXZ_ERROR_NOT_SUPPORT; };
 	virtual axz_rc add( AxzDict&& val )			                            { return AXZ_ERROR_NOT_SUPPORT; };
 	virtual axz_rc add( const axz_wstring& key, const AxzDict& val )        { return AXZ_ERROR_NOT_SUPPORT; };
 	virtual axz_rc add( const axz_wstring& key, AxzDict&& val )		        { return AXZ_ERROR_NOT_SUPPORT; };
+	virtual axz_rc insert( const size_t, const AxzDict& )                   { return AXZ_ERROR_NOT_SUPPORT; };
+	virtual axz_rc replace( const size_t, const AxzDict& )                  { return AXZ_ERROR_NOT_SUPPORT; };
 
 	virtual void clear() {};
 	virtual axz_rc remove( const size_t idx )		                        { return AXZ_ERROR_NOT_SUPPORT; };
@@ -139,7 +230,25 @@ public:
 	// Reserve capacity for containers
 	virtual void reserve( size_t capacity ) {}
 
+	// Serialization cache slot - containers only
+	virtual _AxzJsonCacheSlot* jsonCache()									{ return nullptr; }
+
+	// The node holding the actual data - differs from this only for deferred (lazy) nodes
+	virtual _AxzDicVal* resolve()											{ return this; }
+	virtual const _AxzDicVal* resolve() const								{ return this; }
+
 	virtual axz_rc step( axz_shared_dict_stepper stepper ) = 0;	
+
+#if !AXZDICT_UNSYNCHRONIZED
+	// AxzDict::get_access_count() / reset_stats(), kept here rather than in every AxzDict value
+	struct Stats
+	{
+		std::atomic<uint32_t> access_count{ 0 };
+		std::atomic<uint32_t> set_operations{ 0 };
+		std::atomic<uint32_t> memory_reallocations{ 0 };
+	};
+	mutable Stats stats;
+#endif
 };
 
 template<AxzDictType _type, class T>
@@ -170,59 +279,7 @@ public:
 	_AxzNull(): _AxzTVal( nullptr ) {}	
 };
 
-class _AxzBool final: public _AxzTVal< AxzDictType::BOOL, bool >
-{
-public:
-	explicit _AxzBool( bool val = true ): _AxzTVal( val ) {}		
-	virtual axz_rc val( bool& val ) const override	                        { val = this->m_val; return AXZ_OK; }
-	virtual bool boolVal() const override			                        { return this->m_val; }
-};
-
 const std::shared_ptr<_AxzDicVal> _AxzDicDefault::nullVal = std::make_shared<_AxzNull>();
-const std::shared_ptr<_AxzDicVal> _AxzDicDefault::trueVal = std::make_shared<_AxzBool>( true );
-const std::shared_ptr<_AxzDicVal> _AxzDicDefault::falseVal = std::make_shared<_AxzBool>( false );
-
-class _AxzDouble final: public _AxzTVal< AxzDictType::NUMBER, double >
-{
-public:
-	explicit _AxzDouble( double val = 0. ): _AxzTVal( val ) {}
-
-	virtual axz_rc val( double& val ) const override
-	{		
-		val = this->m_val;		
-		return AXZ_OK;
-	}
-
-	virtual axz_rc val( int32_t& val ) const override
-	{		
-		val = ( int32_t )this->m_val;
-		return AXZ_OK;
-	}	
-
-	virtual double numberVal() const override	{ return this->m_val; }
-	virtual int32_t intVal() const override		{ return ( int32_t )this->m_val; }
-};
-
-class _AxzInt final: public _AxzTVal< AxzDictType::INTEGRAL, int32_t >
-{
-public:
-	explicit _AxzInt( int32_t val = 0 ): _AxzTVal( val ) {}
-
-	virtual axz_rc val( double& val ) const override
-	{		
-		val = ( double )this->m_val;
-		return AXZ_OK;
-	}
-
-	virtual axz_rc val( int32_t& val ) const override
-	{		
-		val = this->m_val;
-		return AXZ_OK;
-	}
-
-	virtual double numberVal() const override	{ return ( double )this->m_val; }
-	virtual int32_t intVal() const override		{ return this->m_val; }
-};
 
 class _AxzString final: public _AxzTVal< AxzDictType::STRING, axz_wstring >
 {
@@ -233,6 +290,7 @@ public:
 	virtual axz_rc val( axz_wstring& val ) const override	                { val = this->m_val; return AXZ_OK; }
 	virtual axz_rc steal( axz_wstring& val ) override						{ val = std::move( this->m_val ); return AXZ_OK; }
 	virtual axz_wstring stringVal() const override		                    { return this->m_val; }
+	virtual const axz_wstring& stringRef() const override					{ return this->m_val; }
 	virtual void clear() override						                    { this->m_val.clear(); }
 };
 
@@ -292,6 +350,24 @@ public:
 		this->m_val.erase( this->m_val.begin() + idx );
 		return AXZ_OK;
 	}	
+
+	virtual axz_rc insert( const size_t idx, const AxzDict& val ) override
+	{
+		if ( idx > this->m_val.size() )
+			return AXZ_ERROR_OUT_OF_RANGE;
+
+		this->m_val.insert( this->m_val.begin() + idx, val );
+		return AXZ_OK;
+	}
+
+	virtual axz_rc replace( const size_t idx, const AxzDict& val ) override
+	{
+		if ( idx >= this->m_val.size() )
+			return AXZ_ERROR_OUT_OF_RANGE;
+
+		this->m_val[idx] = val;
+		return AXZ_OK;
+	}
     
 	const AxzDict& at( const size_t idx ) const override
 	{
@@ -311,6 +387,8 @@ public:
 	{
 		this->m_val.reserve(capacity);
 	}
+
+	_AxzJsonCacheSlot* jsonCache() override									{ return &this->m_jsonCache; }
 	
 private:
 	
@@ -331,26 +409,178 @@ private:
 
 		return Internal::stealVal( this->m_val[idx], val, _AxzBool2Type<isDict>() );		
 	}	
+
+	_AxzJsonCacheSlot m_jsonCache;
+};
+
+/*
+ * Hidden class of an object: its ordered key list plus the key -> slot index. Objects that receive the
+ * same keys in the same order share one shape through a global transition tree and only store their
+ * values, densely, in slot order. Shared shapes are immutable and live for the rest of the process.
+ * Removing a key, growing past MAX_SHARED_KEYS or running out of MAX_SHARED_SHAPES switches an object
+ * to dictionary mode: a private shape that it edits in place.
+ */
+class _AxzShape final
+{
+public:
+	static constexpr size_t MAX_SHARED_KEYS = 64;
+	static constexpr size_t MAX_SHARED_SHAPES = 64 * 1024;
+	static constexpr size_t LINEAR_SEARCH_KEYS = 8;		// up to this many keys a scan beats the index
+	static constexpr size_t npos = static_cast<size_t>( -1 );
+
+	explicit _AxzShape( bool shared ) : m_shared( shared ) {}
+	_AxzShape( const _AxzShape& parent, bool shared ) : m_keys( parent.m_keys ), m_index( parent.m_index ), m_shared( shared ) {}
+
+	static const std::shared_ptr<_AxzShape>& root()
+	{
+		static const std::shared_ptr<_AxzShape> empty = std::make_shared<_AxzShape>( true );
+		return empty;
+	}
+
+	bool shared() const noexcept						{ return m_shared; }
+	size_t size() const noexcept						{ return m_keys.size(); }
+	AxzKey key( const size_t slot ) const noexcept		{ return m_keys[slot]; }
+
+	size_t find( const AxzKey key ) const noexcept
+	{
+		if ( m_index.empty() )
+		{
+			for ( size_t slot = 0; slot < m_keys.size(); ++slot )
+			{
+				if ( m_keys[slot] == key )
+					return slot;
+			}
+			return npos;
+		}
+
+		auto found = m_index.find( key );
+		return found == m_index.end() ? npos : found->second;
+	}
+
+	// Lookup by characters. Small shapes compare the key text directly (length first), which is cheaper
+	// than hashing it into the atom table and taking its lock; larger ones resolve the atom and use the index.
+	size_t find( const axz_wstring& key ) const
+	{
+		if ( m_index.empty() )
+		{
+			const size_t length = key.size();
+			for ( size_t slot = 0; slot < m_keys.size(); ++slot )
+			{
+				const axz_wstring& candidate = m_keys[slot].str();
+				if ( candidate.size() == length && std::wmemcmp( candidate.data(), key.data(), length ) == 0 )
+					return slot;
+			}
+			return npos;
+		}
+
+		auto atom = axz_performance::g_string_pool.find( key );
+		return atom ? this->find( AxzKey( atom ) ) : npos;
+	}
+
+	// The shared shape with key appended; nullptr when the object has to switch to dictionary mode
+	std::shared_ptr<_AxzShape> transition( const AxzKey key ) const
+	{
+		if ( m_keys.size() >= MAX_SHARED_KEYS )
+			return nullptr;
+
+		{
+			std::shared_lock<std::shared_mutex> lock( s_tree_mutex );
+			auto found = m_transitions.find( key );
+			if ( found != m_transitions.end() )
+				return found->second;
+		}
+
+		std::unique_lock<std::shared_mutex> lock( s_tree_mutex );
+		auto found = m_transitions.find( key );
+		if ( found != m_transitions.end() )
+			return found->second;
+		if ( s_shared_shapes >= MAX_SHARED_SHAPES )
+			return nullptr;
+
+		auto next = std::make_shared<_AxzShape>( *this, true );
+		next->_push( key );
+		m_transitions.emplace( key, next );
+		++s_shared_shapes;
+		return next;
+	}
+
+	// Private copy for dictionary mode
+	std::shared_ptr<_AxzShape> unshare() const
+	{
+		return std::make_shared<_AxzShape>( *this, false );
+	}
+
+	// Dictionary mode only
+	void append( const AxzKey key )
+	{
+		assert( !m_shared );
+		this->_push( key );
+	}
+
+	void erase( const size_t slot )
+	{
+		assert( !m_shared && slot < m_keys.size() );
+		m_keys.erase( m_keys.begin() + slot );
+		m_index.clear();
+		if ( m_keys.size() > LINEAR_SEARCH_KEYS )
+		{
+			this->_reindex();
+		}
+	}
+
+private:
+	void _push( const AxzKey key )
+	{
+		m_keys.push_back( key );
+		if ( !m_index.empty() )
+		{
+			m_index.emplace( key, static_cast<uint32_t>( m_keys.size() - 1 ) );
+		}
+		else if ( m_keys.size() > LINEAR_SEARCH_KEYS )
+		{
+			this->_reindex();
+		}
+	}
+
+	void _reindex()
+	{
+		m_index.reserve( m_keys.size() );
+		for ( size_t slot = 0; slot < m_keys.size(); ++slot )
+		{
+			m_index.emplace( m_keys[slot], static_cast<uint32_t>( slot ) );
+		}
+	}
+
+	std::vector<AxzKey> m_keys;
+	std::unordered_map<AxzKey, uint32_t, AxzKey::Hash> m_index;		// only past LINEAR_SEARCH_KEYS
+	const bool m_shared;
+
+	// transition tree, guarded by s_tree_mutex
+	mutable std::unordered_map<AxzKey, std::shared_ptr<_AxzShape>, AxzKey::Hash> m_transitions;
+	static inline std::shared_mutex s_tree_mutex;
+	static inline size_t s_shared_shapes = 0;
 };
 
-class _AxzObject final: public _AxzTVal< AxzDictType::OBJECT, axz_dict_object_safe >
+class _AxzObject final: public _AxzTVal< AxzDictType::OBJECT, axz_dict_array >
 {
 public:
-	_AxzObject() : _AxzTVal( axz_dict_object_safe() ) {}
-	_AxzObject( const axz_dict_object& val ) : _AxzTVal( axz_dict_object_safe() ) {
-		// Convert standard object to safe object
+	_AxzObject() : _AxzTVal( axz_dict_array() ), m_shape( _AxzShape::root() ) {}
+	_AxzObject( const axz_dict_object& val ) : _AxzObject() {
+		this->m_val.reserve( val.size() );
 		for (const auto& pair : val) {
-			this->m_val.emplace(pair.first, pair.second);
+			this->_append( _atom( pair.first ), pair.second );
 		}
 	}
-	_AxzObject( axz_dict_object&& val ) : _AxzTVal( axz_dict_object_safe() ) {
-		// Convert standard object to safe object
+	_AxzObject( axz_dict_object&& val ) : _AxzObject() {
+		this->m_val.reserve( val.size() );
 		for (auto& pair : val) {
-			this->m_val.emplace(std::move(pair.first), std::move(pair.second));
+			this->_append( _atom( pair.first ), std::move( pair.second ) );
 		}
 	}
-	_AxzObject( const axz_dict_object_safe& val ) : _AxzTVal( val ) {}
-	_AxzObject( axz_dict_object_safe&& val ) : _AxzTVal( std::move( val ) ) {}
+
+	// Key of a value slot; slots follow insertion order
+	AxzKey keyAt( const size_t slot ) const									{ return m_shape->key( slot ); }
+	_AxzJsonCacheSlot* jsonCache() override										{ return &this->m_jsonCache; }
 
 	virtual axz_rc val( const axz_wstring& key, AxzDict& val ) override			{ return this->_val<AxzDict, true>( key, val ); }
 	virtual axz_rc val( const axz_wstring& key, double& val ) override			{ return this->_val<double, false>( key, val ); }
@@ -367,7 +597,7 @@ public:
 	virtual axz_rc steal( const axz_wstring& key, axz_bytes& val ) override			{ return this->_steal<axz_bytes, false>( key, val ); }			
 
 	virtual size_t size() const override	                                    { return this->m_val.size(); }
-	virtual void clear() override			                                    { this->m_val.clear(); }
+	virtual void clear() override			                                    { this->m_val.clear(); m_shape = _AxzShape::root(); }
 
 	virtual axz_rc add( const AxzDict& val ) override	
 	{
@@ -380,7 +610,7 @@ public:
 		for( auto key: keys )
 		{
 			try {
-				this->m_val.emplace( key, val[key] );
+				this->add( key, val[key] );
 			} catch (const std::exception&) {
 				// Continue on individual key failures
 			}
@@ -399,7 +629,7 @@ public:
 		for( auto key: keys )
 		{
 			try {
-				this->m_val.emplace( key, std::move( val[key] ) );
+				this->add( key, std::move( val[key] ) );
 			} catch (const std::exception&) {
 				// Continue on individual key failures
 			}
@@ -410,13 +640,13 @@ public:
 	virtual axz_rc add( const axz_wstring& key, const AxzDict& val ) override 
 	{ 
 		try {
-			auto found = this->m_val.find( key );
-			if ( found == this->m_val.end() )
+			const size_t slot = m_shape->find( key );
+			if ( slot == _AxzShape::npos )
 			{
-				this->m_val.emplace( key, val );
+				this->_append( _atom( key ), val );
 				return AXZ_OK;
 			}
-			found->second = val;
+			this->m_val[slot] = val;
 			return AXZ_OK_REPLACED;
 		} catch (const std::exception&) {
 			return AXZ_ERROR_HASH_ERROR;
@@ -426,13 +656,13 @@ public:
 	virtual axz_rc add( const axz_wstring& key, AxzDict&& val ) override
 	{
 		try {
-			auto found = this->m_val.find( key );
-			if ( found == this->m_val.end() )
+			const size_t slot = m_shape->find( key );
+			if ( slot == _AxzShape::npos )
 			{
-				this->m_val.emplace( key, std::move( val ) );
+				this->_append( _atom( key ), std::move( val ) );
 				return AXZ_OK;
 			}
-			found->second = std::move( val );
+			this->m_val[slot] = std::move( val );
 			return AXZ_OK_REPLACED;
 		} catch (const std::exception&) {
 			return AXZ_ERROR_HASH_ERROR;
@@ -442,7 +672,17 @@ public:
 	virtual axz_rc remove( const axz_wstring& key ) override	
 	{ 
 		try {
-			this->m_val.erase( key ); 
+			const size_t slot = this->_find( key );
+			if ( slot != _AxzShape::npos )
+			{
+				// removal never goes back to a shared shape - the object keeps a private one from now on
+				if ( m_shape->shared() )
+				{
+					m_shape = m_shape->unshare();
+				}
+				m_shape->erase( slot );
+				this->m_val.erase( this->m_val.begin() + slot );
+			}
 			return AXZ_OK;
 		} catch (const std::exception&) {
 			return AXZ_ERROR_HASH_ERROR;
@@ -452,13 +692,13 @@ public:
 	AxzDict& at( const axz_wstring& key ) override
 	{
 		try {
-			auto found = this->m_val.find( key );
-			if ( found == this->m_val.end() ) {
+			const size_t slot = m_shape->find( key );
+			if ( slot == _AxzShape::npos ) {
 				// Create key with null value if it doesn't exist (for operator[] behavior)
-				auto [iter, inserted] = this->m_val.emplace( key, AxzDict() );
-				return iter->second;
+				this->_append( _atom( key ), AxzDict() );
+				return this->m_val.back();
 			}
-			return found->second;
+			return this->m_val[slot];
 		} catch (const std::exception&) {
 			// Return reference to a static null dict in case of error
 			static AxzDict null_dict;
@@ -468,19 +708,11 @@ public:
 	
 	const AxzDict& at( const axz_wstring& key ) const override
 	{
-		try {
-			auto found = this->m_val.find( key );
-			if ( found == this->m_val.end() ) {
-				throw std::out_of_range("Key not found");
-			}
-			return found->second;
-		} catch (const std::out_of_range&) {
-			throw; // Re-throw out_of_range
-		} catch (const std::exception&) {
-			// Return reference to a static null dict in case of other errors
-			static const AxzDict null_dict;
-			return null_dict;
+		const size_t slot = this->_find( key );
+		if ( slot == _AxzShape::npos ) {
+			throw std::out_of_range("Key not found");
 		}
+		return this->m_val[slot];
 	}
 	
 	virtual void reserve( size_t capacity ) override
@@ -492,17 +724,64 @@ public:
 		}
 	}
 
+	virtual axz_rc step( axz_shared_dict_stepper stepper ) override
+	{
+		axz_dict_object object;
+		object.reserve( this->m_val.size() );
+		for ( size_t slot = 0; slot < this->m_val.size(); ++slot )
+		{
+			object.emplace( m_shape->key( slot ).str(), this->m_val[slot] );
+		}
+		return stepper->step( object );
+	}
+
 private:	
 
+	// Keys are interned when they are added; lookups never intern
+	static AxzKey _atom( const axz_wstring& key )
+	{
+		return AxzKey( axz_performance::g_string_pool.intern( key ) );
+	}
+
+	size_t _find( const axz_wstring& key ) const
+	{
+		return m_shape->find( key );
+	}
+
+	template<class V>
+	void _append( const AxzKey key, V&& value )
+	{
+		this->m_val.emplace_back( std::forward<V>( value ) );
+		try {
+			if ( !m_shape->shared() )
+			{
+				m_shape->append( key );
+			}
+			else if ( auto next = m_shape->transition( key ) )
+			{
+				m_shape = std::move( next );
+			}
+			else
+			{
+				auto own = m_shape->unshare();
+				own->append( key );
+				m_shape = std::move( own );
+			}
+		} catch (...) {
+			this->m_val.pop_back();
+			throw;
+		}
+	}
+
 	template<class V, bool isDict>
 	axz_rc _val( const axz_wstring& key, V& val )
 	{	
 		try {
-			auto found = this->m_val.find( key );
-			if ( found == this->m_val.end() )
+			const size_t slot = this->_find( key );
+			if ( slot == _AxzShape::npos )
 				return AXZ_ERROR_NOT_FOUND;
 
-			return Internal::getVal( found->second, val, _AxzBool2Type<isDict>() );
+			return Internal::getVal( this->m_val[slot], val, _AxzBool2Type<isDict>() );
 		} catch (const std::exception&) {
 			return AXZ_ERROR_HASH_ERROR;
 		}
@@ -512,30 +791,143 @@ private:
 	axz_rc _steal( const axz_wstring& key, V& val )
 	{	
 		try {
-			auto found = this->m_val.find( key );
-			if ( found == this->m_val.end() )
+			const size_t slot = this->_find( key );
+			if ( slot == _AxzShape::npos )
 				return AXZ_ERROR_NOT_FOUND;
 			
-			return Internal::stealVal( found->second, val, _AxzBool2Type<isDict>() );	
+			return Internal::stealVal( this->m_val[slot], val, _AxzBool2Type<isDict>() );	
 		} catch (const std::exception&) {
 			return AXZ_ERROR_HASH_ERROR;
 		}
 	}
+
+	std::shared_ptr<_AxzShape> m_shape;
+	_AxzJsonCacheSlot m_jsonCache;
 };
 
-// Iterator implementations for AxzDict
-AxzDict::iterator::iterator(std::shared_ptr<_AxzDicVal> val, size_t index) 
-    : m_val(val), m_index(index), m_is_array(true) {}
+/*
+ * Deferred object or array - the source range is only parsed on first access. Every call is
+ * forwarded to the built node; owners keep pointing at this proxy so all copies share the result.
+ * A range that fails to build throws AxzDictDeferredError on every access; nothing is cached for it.
+ */
+class _AxzLazy final: public _AxzDicVal
+{
+public:
+	_AxzLazy( AxzDictType type, axz_json_source source, size_t offset, axz_dict_builder builder )
+		: m_type( type ), m_source( std::move( source ) ), m_offset( offset ), m_builder( builder ) {}
+
+	AxzDictType type() const override												{ return this->m_type; }
+	bool isType( const AxzDictType type ) const override							{ return ( this->m_type == type ); }
+	size_t size() const override													{ return this->_built()->size(); }
+
+	axz_rc val( const axz_wstring& key, AxzDict& val ) override						{ return this->_built()->val( key, val ); }
+	axz_rc val( const axz_wstring& key, double& val ) override						{ return this->_built()->val( key, val ); }
+	axz_rc val( const axz_wstring& key, int32_t& val ) override						{ return this->_built()->val( key, val ); }
+	axz_rc val( const axz_wstring& key, bool& val ) override						{ return this->_built()->val( key, val ); }
+	axz_rc val( const axz_wstring& key, axz_wstring& val ) override					{ return this->_built()->val( key, val ); }
+	axz_rc val( const axz_wstring& key, axz_bytes& val ) override					{ return this->_built()->val( key, val ); }
+
+	axz_rc steal( const axz_wstring& key, AxzDict& val ) override					{ return this->_built()->steal( key, val ); }
+	axz_rc steal( const axz_wstring& key, double& val ) override					{ return this->_built()->steal( key, val ); }
+	axz_rc steal( const axz_wstring& key, int32_t& val ) override					{ return this->_built()->steal( key, val ); }
+	axz_rc steal( const axz_wstring& key, bool& val ) override						{ return this->_built()->steal( key, val ); }
+	axz_rc steal( const axz_wstring& key, axz_wstring& val ) override				{ return this->_built()->steal( key, val ); }
+	axz_rc steal( const axz_wstring& key, axz_bytes& val ) override					{ return this->_built()->steal( key, val ); }
+
+	axz_rc val( const size_t idx, AxzDict& val ) override							{ return this->_built()->val( idx, val ); }
+	axz_rc val( const size_t idx, double& val ) override							{ return this->_built()->val( idx, val ); }
+	axz_rc val( const size_t idx, int32_t& val ) override							{ return this->_built()->val( idx, val ); }
+	axz_rc val( const size_t idx, bool& val ) override								{ return this->_built()->val( idx, val ); }
+	axz_rc val( const size_t idx, axz_wstring& val ) override						{ return this->_built()->val( idx, val ); }
+	axz_rc val( const size_t idx, axz_bytes& val ) override							{ return this->_built()->val( idx, val ); }
+
+	axz_rc steal( const size_t idx, AxzDict& val ) override							{ return this->_built()->steal( idx, val ); }
+	axz_rc steal( const size_t idx, double& val ) override							{ return this->_built()->steal( idx, val ); }
+	axz_rc steal( const size_t idx, int32_t& val ) override							{ return this->_built()->steal( idx, val ); }
+	axz_rc steal( const size_t idx, bool& val ) override							{ return this->_built()->steal( idx, val ); }
+	axz_rc steal( const size_t idx, axz_wstring& val ) override						{ return this->_built()->steal( idx, val ); }
+	axz_rc steal( const size_t idx, axz_bytes& val ) override						{ return this->_built()->steal( idx, val ); }
+
+	axz_rc add( const AxzDict& val ) override										{ return this->_built()->add( val ); }
+	axz_rc add( AxzDict&& val ) override											{ return this->_built()->add( std::move( val ) ); }
+	axz_rc add( const axz_wstring& key, const AxzDict& val ) override				{ return this->_built()->add( key, val ); }
+	axz_rc add( const axz_wstring& key, AxzDict&& val ) override					{ return this->_built()->add( key, std::move( val ) ); }
+	axz_rc insert( const size_t idx, const AxzDict& val ) override					{ return this->_built()->insert( idx, val ); }
+	axz_rc replace( const size_t idx, const AxzDict& val ) override					{ return this->_built()->replace( idx, val ); }
+
+	void clear() override															{ this->_built()->clear(); }
+	axz_rc remove( const size_t idx ) override										{ return this->_built()->remove( idx ); }
+	axz_rc remove( const axz_wstring& key ) override								{ return this->_built()->remove( key ); }
+
+	AxzDict& at( const size_t idx ) override										{ return this->_built()->at( idx ); }
+	const AxzDict& at( const size_t idx ) const override							{ return this->_built()->at( idx ); }
+	AxzDict& at( const axz_wstring& key ) override									{ return this->_built()->at( key ); }
+	const AxzDict& at( const axz_wstring& key ) const override						{ return this->_built()->at( key ); }
+
+	void reserve( size_t capacity ) override										{ this->_built()->reserve( capacity ); }
+	_AxzJsonCacheSlot* jsonCache() override											{ return this->_built()->jsonCache(); }
+	_AxzDicVal* resolve() override													{ return this->_built(); }
+	const _AxzDicVal* resolve() const override										{ return this->_built(); }
+
+	axz_rc step( axz_shared_dict_stepper stepper ) override							{ return this->_built()->step( stepper ); }
 
-AxzDict::iterator::iterator(std::shared_ptr<_AxzDicVal> val, axz_dict_object_safe::iterator it)
-    : m_val(val), m_obj_it(it), m_is_array(false) {}
+private:
+	_AxzDicVal* _built() const
+	{
+		std::call_once( this->m_once, [this]() {
+			// a throw leaves m_once unset, so the next access tries (and fails) again
+			AxzDict built;
+			if ( AXZ_FAILED( this->m_builder( this->m_source, this->m_offset, built ) ) || !built.isType( this->m_type ) )
+			{
+				throw AxzDictDeferredError( "AxzDict: invalid JSON in deferred container at offset " + std::to_string( this->m_offset ) );
+			}
+			this->m_val = std::move( built.m_val );
+			this->m_source.reset();		// the built node keeps its own references to the source
+		} );
+		return this->m_val.get();
+	}
+
+	const AxzDictType m_type;
+	mutable axz_json_source m_source;
+	const size_t m_offset;
+	const axz_dict_builder m_builder;
+	mutable std::once_flag m_once;
+	mutable std::shared_ptr<_AxzDicVal> m_val;
+};
+
+// Arena implementations
+AxzDictArena::AxzDictArena( size_t initial_size ) : m_resource( initial_size ) {}
+
+void* AxzDictArena::allocate( size_t bytes, size_t alignment ) {
+    m_used += bytes;
+    return m_resource.allocate(bytes, alignment);
+}
+
+AxzDictArenaScope::AxzDictArenaScope( axz_shared_arena arena ) : m_previous( std::move(_axz_current_arena) ) {
+    _axz_current_arena = std::move(arena);
+}
+
+AxzDictArenaScope::~AxzDictArenaScope() {
+    _axz_current_arena = std::move(m_previous);
+}
+
+const axz_shared_arena& AxzDictArenaScope::current() noexcept {
+    return _axz_current_arena;
+}
+
+// Dense value storage of an array or object node: array elements or object value slots
+static axz_dict_array& _AxzItems( const std::shared_ptr<_AxzDicVal>& node, AxzDictType type ) {
+    _AxzDicVal* resolved = node->resolve();
+    return type == AxzDictType::ARRAY ? static_cast<_AxzArray*>(resolved)->data()
+                                      : static_cast<_AxzObject*>(resolved)->data();
+}
+
+// Iterator implementations for AxzDict
+AxzDict::iterator::iterator(std::shared_ptr<_AxzDicVal> val, AxzDict* items, size_t index, bool is_array) 
+    : m_val(std::move(val)), m_items(items), m_index(index), m_is_array(is_array) {}
 
 AxzDict::iterator::reference AxzDict::iterator::operator*() const {
-    if (m_is_array) {
-        return m_val->at(m_index);
-    } else {
-        return m_obj_it->second;
-    }
+    return m_items[m_index];
 }
 
 AxzDict::iterator::pointer AxzDict::iterator::operator->() const {
@@ -543,11 +935,7 @@ AxzDict::iterator::pointer AxzDict::iterator::operator->() const {
 }
 
 AxzDict::iterator& AxzDict::iterator::operator++() {
-    if (m_is_array) {
-        ++m_index;
-    } else {
-        ++m_obj_it;
-    }
+    ++m_index;
     return *this;
 }
 
@@ -557,13 +945,15 @@ AxzDict::iterator AxzDict::iterator::operator++(int) {
     return tmp;
 }
 
-bool AxzDict::iterator::operator==(const iterator& other) const {
-    if (m_is_array != other.m_is_array) return false;
-    if (m_is_array) {
-        return m_index == other.m_index;
-    } else {
-        return m_obj_it == other.m_obj_it;
+const axz_wstring& AxzDict::iterator::key() const {
+    if (m_is_array || !m_val) {
+        throw std::invalid_argument("AxzDict::iterator::key available for object only");
     }
+    return static_cast<const _AxzObject*>(m_val->resolve())->keyAt(m_index).str();
+}
+
+bool AxzDict::iterator::operator==(const iterator& other) const {
+    return m_is_array == other.m_is_array && m_index == other.m_index;
 }
 
 bool AxzDict::iterator::operator!=(const iterator& other) const {
@@ -571,26 +961,14 @@ bool AxzDict::iterator::operator!=(const iterator& other) const {
 }
 
 // const_iterator implementations
-AxzDict::const_iterator::const_iterator(std::shared_ptr<_AxzDicVal> val, size_t index) 
-    : m_val(val), m_index(index), m_is_array(true) {}
-
-AxzDict::const_iterator::const_iterator(std::shared_ptr<_AxzDicVal> val, axz_dict_object_safe::const_iterator it)
-    : m_val(val), m_obj_it(it), m_is_array(false) {}
+AxzDict::const_iterator::const_iterator(std::shared_ptr<_AxzDicVal> val, const AxzDict* items, size_t index, bool is_array) 
+    : m_val(std::move(val)), m_items(items), m_index(index), m_is_array(is_array) {}
 
 AxzDict::const_iterator::const_iterator(const iterator& it) 
-    : m_val(it.m_val), m_index(it.m_index), m_is_array(it.m_is_array) {
-    if (!m_is_array) {
-        // Convert iterator to const_iterator for object case
-        m_obj_it = it.m_obj_it;
-    }
-}
+    : m_val(it.m_val), m_items(it.m_items), m_index(it.m_index), m_is_array(it.m_is_array) {}
 
 AxzDict::const_iterator::reference AxzDict::const_iterator::operator*() const {
-    if (m_is_array) {
-        return m_val->at(m_index);
-    } else {
-        return m_obj_it->second;
-    }
+    return m_items[m_index];
 }
 
 AxzDict::const_iterator::pointer AxzDict::const_iterator::operator->() const {
@@ -598,11 +976,7 @@ AxzDict::const_iterator::pointer AxzDict::const_iterator::operator->() const {
 }
 
 AxzDict::const_iterator& AxzDict::const_iterator::operator++() {
-    if (m_is_array) {
-        ++m_index;
-    } else {
-        ++m_obj_it;
-    }
+    ++m_index;
     return *this;
 }
 
@@ -612,62 +986,55 @@ AxzDict::const_iterator AxzDict::const_iterator::operator++(int) {
     return tmp;
 }
 
-bool AxzDict::const_iterator::operator==(const const_iterator& other) const {
-    if (m_is_array != other.m_is_array) return false;
-    if (m_is_array) {
-        return m_index == other.m_index;
-    } else {
-        return m_obj_it == other.m_obj_it;
+const axz_wstring& AxzDict::const_iterator::key() const {
+    if (m_is_array || !m_val) {
+        throw std::invalid_argument("AxzDict::const_iterator::key available for object only");
     }
+    return static_cast<const _AxzObject*>(m_val->resolve())->keyAt(m_index).str();
+}
+
+bool AxzDict::const_iterator::operator==(const const_iterator& other) const {
+    return m_is_array == other.m_is_array && m_index == other.m_index;
 }
 
 bool AxzDict::const_iterator::operator!=(const const_iterator& other) const {
     return !(*this == other);
 }
 
-// Iterator methods for AxzDict
+// Iterator methods for AxzDict - arrays walk their elements, objects their value slots in insertion order
 AxzDict::iterator AxzDict::begin() {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    if (m_val->type() == AxzDictType::ARRAY) {
-        return iterator(m_val, 0);
-    } else if (m_val->type() == AxzDictType::OBJECT) {
-        auto obj_ptr = static_cast<_AxzObject*>(m_val.get());
-        return iterator(m_val, obj_ptr->m_val.begin());
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    if (m_type == AxzDictType::ARRAY || m_type == AxzDictType::OBJECT) {
+        _exposedNode();     // elements are writable through the iterator
+        return iterator(m_val, _AxzItems(m_val, m_type).data(), 0, m_type == AxzDictType::ARRAY);
     }
-    return end();
+    return iterator(m_val, nullptr, 0);
 }
 
 AxzDict::iterator AxzDict::end() {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    if (m_val->type() == AxzDictType::ARRAY) {
-        return iterator(m_val, m_val->size());
-    } else if (m_val->type() == AxzDictType::OBJECT) {
-        auto obj_ptr = static_cast<_AxzObject*>(m_val.get());
-        return iterator(m_val, obj_ptr->m_val.end());
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    if (m_type == AxzDictType::ARRAY || m_type == AxzDictType::OBJECT) {
+        auto& items = _AxzItems(m_val, m_type);
+        return iterator(m_val, items.data(), items.size(), m_type == AxzDictType::ARRAY);
     }
-    return iterator(m_val, 0);
+    return iterator(m_val, nullptr, 0);
 }
 
 AxzDict::const_iterator AxzDict::begin() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    if (m_val->type() == AxzDictType::ARRAY) {
-        return const_iterator(m_val, 0);
-    } else if (m_val->type() == AxzDictType::OBJECT) {
-        auto obj_ptr = static_cast<const _AxzObject*>(m_val.get());
-        return const_iterator(m_val, obj_ptr->m_val.begin());
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    if (m_type == AxzDictType::ARRAY || m_type == AxzDictType::OBJECT) {
+        return const_iterator(m_val, _AxzItems(m_val, m_type).data(), 0, m_type == AxzDictType::ARRAY);
     }
-    return end();
+    return const_iterator(m_val, nullptr, 0);
 }
 
 AxzDict::const_iterator AxzDict::end() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    if (m_val->type() == AxzDictType::ARRAY) {
-        return const_iterator(m_val, m_val->size());
-    } else if (m_val->type() == AxzDictType::OBJECT) {
-        auto obj_ptr = static_cast<const _AxzObject*>(m_val.get());
-        return const_iterator(m_val, obj_ptr->m_val.end());
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    if (m_type == AxzDictType::ARRAY || m_type == AxzDictType::OBJECT) {
+        const auto& items = _AxzItems(m_val, m_type);
+        return const_iterator(m_val, items.data(), items.size(), m_type == AxzDictType::ARRAY);
     }
-    return const_iterator(m_val, 0);
+    return const_iterator(m_val, nullptr, 0);
 }
 
 AxzDict::const_iterator AxzDict::cbegin() const {
@@ -678,96 +1045,186 @@ AxzDict::const_iterator AxzDict::cend() const {
     return end();
 }
 
-// AxzDict constructor implementations - optimized with caching
-AxzDict::AxzDict() noexcept : m_val( _AxzDicDefault::nullVal ) {}
+// AxzDict constructor implementations - scalars are stored inline
+AxzDict::AxzDict() noexcept {}
 
-AxzDict::AxzDict( const AxzDict& other ) : m_val( other.m_val ) {}
+AxzDict::AxzDict( std::shared_ptr<_AxzDicVal> other ) : m_type( other->type() ), m_val( std::move(other) ) {}
 
-AxzDict::AxzDict( AxzDict&& other ) noexcept : m_val( std::move(other.m_val) ) {}
+AxzDict::AxzDict( const AxzDict& other ) : m_scalar( other.m_scalar ), m_type( other.m_type ), m_val( other.m_val ) {}
 
-AxzDict::AxzDict( int value ) {
-    // Use simple caching for common integer values to avoid allocation overhead
-    if (value >= -10 && value <= 100) {
-        static std::array<std::shared_ptr<_AxzInt>, 111> cached_ints;
-        static std::once_flag cache_init;
-        
-        std::call_once(cache_init, []() {
-            for (int i = 0; i < 111; ++i) {
-                cached_ints[i] = std::make_shared<_AxzInt>(i - 10);
-            }
-        });
-        
-        m_val = cached_ints[value + 10];
-    } else {
-        m_val = std::make_shared<_AxzInt>(value);
-    }
+AxzDict::AxzDict( AxzDict&& other ) noexcept : m_scalar( other.m_scalar ), m_type( other.m_type ), m_val( std::move(other.m_val) ) {
+    other.m_type = AxzDictType::NUL;
 }
 
-AxzDict::AxzDict( double value ) {
-    m_val = std::make_shared<_AxzDouble>(value);
+AxzDict::AxzDict( int32_t value ) : m_type( AxzDictType::INTEGRAL ) {
+    m_scalar.integral = value;
 }
 
-AxzDict::AxzDict( bool value ) : m_val( value ? _AxzDicDefault::trueVal : _AxzDicDefault::falseVal ) {}
-
-AxzDict::AxzDict( const wchar_t* value ) {
-    m_val = std::make_shared<_AxzString>(axz_wstring(value));
+AxzDict::AxzDict( double value ) : m_type( AxzDictType::NUMBER ) {
+    m_scalar.number = value;
 }
 
-AxzDict::AxzDict( const axz_wstring& value ) {
-    m_val = std::make_shared<_AxzString>(value);
+AxzDict::AxzDict( bool value ) : m_type( AxzDictType::BOOL ) {
+    m_scalar.boolean = value;
 }
 
-AxzDict::AxzDict( axz_dict_array&& value ) noexcept {
-    m_val = std::make_shared<_AxzArray>(std::move(value));
-}
+AxzDict::AxzDict( const wchar_t* value ) : m_type( AxzDictType::STRING ), m_val( _AxzMakeVal<_AxzString>(axz_wstring(value)) ) {}
 
-AxzDict::AxzDict( axz_dict_object&& value ) noexcept {
-    m_val = std::make_shared<_AxzObject>(std::move(value));
-}
+AxzDict::AxzDict( const axz_wstring& value ) : m_type( AxzDictType::STRING ), m_val( _AxzMakeVal<_AxzString>(value) ) {}
+
+AxzDict::AxzDict( axz_wstring&& value ) noexcept : m_type( AxzDictType::STRING ), m_val( _AxzMakeVal<_AxzString>(std::move(value)) ) {}
+
+AxzDict::AxzDict( const axz_bytes& value ) : m_type( AxzDictType::BYTES ), m_val( _AxzMakeVal<_AxzBytes>(value) ) {}
+
+AxzDict::AxzDict( axz_bytes&& value ) noexcept : m_type( AxzDictType::BYTES ), m_val( _AxzMakeVal<_AxzBytes>(std::move(value)) ) {}
+
+AxzDict::AxzDict( axz_dict_array&& value ) noexcept : m_type( AxzDictType::ARRAY ), m_val( _AxzMakeVal<_AxzArray>(std::move(value)) ) {}
+
+AxzDict::AxzDict( axz_dict_object&& value ) noexcept : m_type( AxzDictType::OBJECT ), m_val( _AxzMakeVal<_AxzObject>(std::move(value)) ) {}
 
 // Constructor with AxzDictType
 AxzDict::AxzDict( AxzDictType type ) noexcept {
+    _reset(type);
+}
+
+// Turn into an empty value of the given type
+void AxzDict::_reset( AxzDictType type ) {
+    m_scalar = {};
+    m_type = type;
     switch (type) {
         case AxzDictType::NUL:
-            m_val = _AxzDicDefault::nullVal;
-            break;
         case AxzDictType::BOOL:
-            m_val = _AxzDicDefault::falseVal;
-            break;
         case AxzDictType::NUMBER:
-            m_val = std::make_shared<_AxzDouble>(0.0);
-            break;
         case AxzDictType::INTEGRAL:
-            m_val = std::make_shared<_AxzInt>(0);
+            m_val.reset();
             break;
         case AxzDictType::STRING:
-            m_val = std::make_shared<_AxzString>(axz_wstring());
+            m_val = _AxzMakeVal<_AxzString>(axz_wstring());
             break;
         case AxzDictType::ARRAY:
-            m_val = std::make_shared<_AxzArray>(axz_dict_array());
+            m_val = _AxzMakeVal<_AxzArray>(axz_dict_array());
             break;
         case AxzDictType::OBJECT:
-            m_val = std::make_shared<_AxzObject>(axz_dict_object_safe());
+            m_val = _AxzMakeVal<_AxzObject>();
             break;
         default:
-            m_val = _AxzDicDefault::nullVal;
+            m_type = AxzDictType::NUL;
+            m_val.reset();
             break;
     }
 }
 
+_AxzDicVal* AxzDict::_node() const {
+    return m_val ? m_val.get() : _AxzDicDefault::nullVal.get();
+}
+
+// Drop the cached text of a container and of every container it was serialized into. Stops at caches
+// that are already stale: their parents were dropped together with them.
+static void _AxzDropJsonCache( _AxzDicVal* node ) {
+    _AxzJsonCacheSlot* slot = node->jsonCache();
+    _AxzJsonCache* cache = slot ? slot->get() : nullptr;
+    if (!cache) {
+        return;
+    }
+
+    std::vector<std::shared_ptr<_AxzDicVal>> parents;
+    {
+        std::lock_guard<std::mutex> lock(cache->lock);
+        if (!cache->valid) {
+            return;
+        }
+        cache->valid = false;
+        cache->json.reset();
+        for (const auto& weak : cache->parents) {
+            if (auto parent = weak.lock()) {
+                parents.push_back(std::move(parent));
+            }
+        }
+        cache->parents.clear();     // registered again by the next serialization
+    }
+    for (const auto& parent : parents) {
+        _AxzDropJsonCache(parent->resolve());
+    }
+}
+
+_AxzDicVal* AxzDict::_mutableNode() {
+    if (m_type == AxzDictType::ARRAY || m_type == AxzDictType::OBJECT) {
+        _AxzDropJsonCache(m_val->resolve());
+    }
+    return _node();
+}
+
+_AxzDicVal* AxzDict::_exposedNode() {
+    if (m_type == AxzDictType::ARRAY || m_type == AxzDictType::OBJECT) {
+        _AxzDicVal* node = m_val->resolve();
+        node->jsonCache()->expose();    // before the drop, so no serialization can store it again
+        _AxzDropJsonCache(node);
+    }
+    return _node();
+}
+
+std::shared_ptr<const std::string> AxzDict::jsonCache( const AxzDict* parent ) const {
+    if (m_type != AxzDictType::ARRAY && m_type != AxzDictType::OBJECT) {
+        return nullptr;
+    }
+
+    _AxzJsonCacheSlot* slot = m_val->resolve()->jsonCache();
+    if (slot->exposed()) {
+        return nullptr;     // never stored, so the parent is not cached either and needs no link
+    }
+    _AxzJsonCache* cache = slot->create();
+    std::lock_guard<std::mutex> lock(cache->lock);
+    if (parent && parent->m_val) {
+        // remember the parent once; expired ones are pruned on the way
+        bool known = false;
+        auto& parents = cache->parents;
+        for (size_t i = 0; i < parents.size();) {
+            if (parents[i].expired()) {
+                parents[i] = std::move(parents.back());
+                parents.pop_back();
+                continue;
+            }
+            known = known || (!parents[i].owner_before(parent->m_val) && !parent->m_val.owner_before(parents[i]));
+            ++i;
+        }
+        if (!known) {
+            parents.emplace_back(parent->m_val);
+        }
+    }
+    return cache->valid ? cache->json : nullptr;
+}
+
+bool AxzDict::storeJsonCache( std::shared_ptr<const std::string> json ) const {
+    if (m_type != AxzDictType::ARRAY && m_type != AxzDictType::OBJECT) {
+        return false;
+    }
+
+    _AxzJsonCacheSlot* slot = m_val->resolve()->jsonCache();
+    if (slot->exposed()) {
+        return false;
+    }
+    _AxzJsonCache* cache = slot->create();
+    std::lock_guard<std::mutex> lock(cache->lock);
+    cache->json = std::move(json);
+    cache->valid = true;
+    return true;
+}
+
 // Modern C++17 Enhanced Implementation for AxzDict
 
 // High-performance constructors with string view support
 AxzDict::AxzDict( std::wstring_view val ) {
     axz_performance::g_counters.memory_allocations.fetch_add(1, std::memory_order_relaxed);
     
-    // Use string pool for frequently used strings
-    if (val.size() <= SMALL_STRING_OPTIMIZATION_SIZE) {
-        auto pooled = axz_performance::g_string_pool.intern(axz_wstring(val));
-        m_val = std::make_shared<_AxzString>(*pooled);
-    } else {
-        m_val = std::make_shared<_AxzString>(axz_wstring(val));
+    m_val = _AxzMakeVal<_AxzString>(axz_wstring(val));
+    m_type = AxzDictType::STRING;
+}
+
+AxzDict AxzDict::lazy( AxzDictType type, axz_json_source source, size_t offset, axz_dict_builder builder ) {
+    if ((type != AxzDictType::ARRAY && type != AxzDictType::OBJECT) || !source || !builder) {
+        throw std::invalid_argument("AxzDict::lazy available for object or array only");
     }
+    return AxzDict(_AxzMakeVal<_AxzLazy>(type, std::move(source), offset, builder));
 }
 
 // Initializer list constructors for convenient syntax
@@ -789,15 +1246,9 @@ AxzDict::AxzDict( std::initializer_list<std::pair<axz_wstring, AxzDict>> vals )
 
 // Enhanced assignment operators
 AxzDict& AxzDict::operator=( std::wstring_view val ) {
-    stats.set_operations.fetch_add(1, std::memory_order_relaxed);
+    _AXZ_STAT_INC(set_operations);
     
-    // Use string pool for efficiency
-    if (val.size() <= SMALL_STRING_OPTIMIZATION_SIZE) {
-        auto pooled = axz_performance::g_string_pool.intern(axz_wstring(val));
-        *this = *pooled;
-    } else {
-        *this = axz_wstring(val);
-    }
+    *this = axz_wstring(val);
     return *this;
 }
 
@@ -822,9 +1273,8 @@ AxzDict& AxzDict::operator=( std::initializer_list<std::pair<axz_wstring, AxzDic
 }
 
 // Enhanced utility methods
-bool AxzDict::empty() const noexcept {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    access_count.fetch_add(1, std::memory_order_relaxed);
+bool AxzDict::empty() const {
+    _AXZ_STAT_INC(access_count);
     
     if AXZ_CONSTEXPR_IF (true) {
         switch (type()) {
@@ -844,8 +1294,8 @@ bool AxzDict::empty() const noexcept {
 }
 
 void AxzDict::shrink_to_fit() {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    stats.memory_reallocations.fetch_add(1, std::memory_order_relaxed);
+    _AXZ_STAT_INC(memory_reallocations);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
     
     // Implementation depends on internal data structure
     // This is a placeholder - actual implementation would optimize storage
@@ -853,8 +1303,7 @@ void AxzDict::shrink_to_fit() {
 
 // Path-based operations with SIMD-optimized path parsing
 axz_rc AxzDict::get_path(std::wstring_view path, AxzDict& result) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    access_count.fetch_add(1, std::memory_order_relaxed);
+    _AXZ_STAT_INC(access_count);
     
     // Fast path for simple keys (no dots)
     if (path.find(L'.') == std::wstring_view::npos) {
@@ -866,8 +1315,7 @@ axz_rc AxzDict::get_path(std::wstring_view path, AxzDict& result) const {
 }
 
 axz_rc AxzDict::set_path(std::wstring_view path, const AxzDict& value) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    stats.set_operations.fetch_add(1, std::memory_order_relaxed);
+    _AXZ_STAT_INC(set_operations);
     
     // Fast path for simple keys
     if (path.find(L'.') == std::wstring_view::npos) {
@@ -880,8 +1328,7 @@ axz_rc AxzDict::set_path(std::wstring_view path, const AxzDict& value) {
 }
 
 axz_rc AxzDict::set_path(std::wstring_view path, AxzDict&& value) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    stats.set_operations.fetch_add(1, std::memory_order_relaxed);
+    _AXZ_STAT_INC(set_operations);
     
     // Fast path for simple keys
     if (path.find(L'.') == std::wstring_view::npos) {
@@ -894,8 +1341,7 @@ axz_rc AxzDict::set_path(std::wstring_view path, AxzDict&& value) {
 
 bool AxzDict::has_path(std::wstring_view path) const noexcept {
     try {
-        std::shared_lock<std::shared_mutex> lock(m_mutex);
-        access_count.fetch_add(1, std::memory_order_relaxed);
+        _AXZ_STAT_INC(access_count);
         
         if (path.find(L'.') == std::wstring_view::npos) {
             return AXZ_SUCCESS(contain(axz_wstring(path)));
@@ -909,7 +1355,6 @@ bool AxzDict::has_path(std::wstring_view path) const noexcept {
 
 // Memory-efficient merge operations
 void AxzDict::merge(const AxzDict& other, bool overwrite) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
     
     if (!isObject() || !other.isObject()) {
         return;  // Can only merge objects
@@ -927,8 +1372,7 @@ void AxzDict::merge(const AxzDict& other, bool overwrite) {
     }
 }
 
-void AxzDict::merge(AxzDict&& other, bool overwrite) noexcept {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
+void AxzDict::merge(AxzDict&& other, bool overwrite) {
     
     if (!isObject() || !other.isObject()) {
         return;
@@ -946,16 +1390,55 @@ void AxzDict::merge(AxzDict&& other, bool overwrite) noexcept {
     }
 }
 
+AxzDict AxzDict::clone() const {
+    switch (type()) {
+        case AxzDictType::STRING:
+            return AxzDict(stringRef());
+        case AxzDictType::BYTES:
+            return AxzDict(bytesVal());
+        case AxzDictType::ARRAY: {
+            AxzDict copy(AxzDictType::ARRAY);
+            copy.reserve(size());
+            for (const auto& item : *this) {
+                copy.add(item.clone());
+            }
+            return copy;
+        }
+        case AxzDictType::OBJECT: {
+            AxzDict copy(AxzDictType::OBJECT);
+            copy.reserve(size());
+            for (auto it = cbegin(), last = cend(); it != last; ++it) {
+                copy.add(it.key(), (*it).clone());
+            }
+            return copy;
+        }
+        default:
+            return *this;   // scalars are inline, callables are immutable
+    }
+}
+
 // Performance monitoring
 void AxzDict::reset_stats() noexcept {
-    access_count.store(0, std::memory_order_relaxed);
-    stats.get_operations.store(0, std::memory_order_relaxed);
-    stats.set_operations.store(0, std::memory_order_relaxed);
-    stats.memory_reallocations.store(0, std::memory_order_relaxed);
+#if !AXZDICT_UNSYNCHRONIZED
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    if (m_val) {
+        m_val->stats.access_count.store(0, std::memory_order_relaxed);
+        m_val->stats.set_operations.store(0, std::memory_order_relaxed);
+        m_val->stats.memory_reallocations.store(0, std::memory_order_relaxed);
+    }
+#endif
 }
 
-size_t AxzDict::memory_usage() const noexcept {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+uint32_t AxzDict::get_access_count() const noexcept {
+#if AXZDICT_UNSYNCHRONIZED
+    return 0;
+#else
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return m_val ? m_val->stats.access_count.load(std::memory_order_relaxed) : 0;
+#endif
+}
+
+size_t AxzDict::memory_usage() const {
     
     // Estimate memory usage - this is a simplified calculation
     size_t base_size = sizeof(AxzDict);
@@ -977,8 +1460,7 @@ size_t AxzDict::memory_usage() const noexcept {
 }
 
 void AxzDict::compact() {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    stats.memory_reallocations.fetch_add(1, std::memory_order_relaxed);
+    _AXZ_STAT_INC(memory_reallocations);
     
     // Compact internal data structures
     // This is a placeholder for actual optimization
@@ -988,7 +1470,7 @@ void AxzDict::compact() {
 // Template specialization for get_if with compile-time optimization
 template<>
 std::optional<double> AxzDict::get_if<double>() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
     
     if AXZ_CONSTEXPR_IF (true) {
         if (isNumber() || isIntegral()) {
@@ -1000,7 +1482,7 @@ std::optional<double> AxzDict::get_if<double>() const {
 
 template<>
 std::optional<int32_t> AxzDict::get_if<int32_t>() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
     
     if AXZ_CONSTEXPR_IF (true) {
         if (isIntegral() || isNumber()) {
@@ -1012,7 +1494,7 @@ std::optional<int32_t> AxzDict::get_if<int32_t>() const {
 
 template<>
 std::optional<bool> AxzDict::get_if<bool>() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
     
     if AXZ_CONSTEXPR_IF (true) {
         if (isType(AxzDictType::BOOL)) {
@@ -1024,7 +1506,7 @@ std::optional<bool> AxzDict::get_if<bool>() const {
 
 template<>
 std::optional<axz_wstring> AxzDict::get_if<axz_wstring>() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
     
     if AXZ_CONSTEXPR_IF (true) {
         if (isString()) {
@@ -1036,7 +1518,7 @@ std::optional<axz_wstring> AxzDict::get_if<axz_wstring>() const {
 
 template<>
 std::optional<axz_bytes> AxzDict::get_if<axz_bytes>() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
     
     if AXZ_CONSTEXPR_IF (true) {
         if (isBytes()) {
@@ -1048,13 +1530,13 @@ std::optional<axz_bytes> AxzDict::get_if<axz_bytes>() const {
 
 // Missing basic method implementations
 AxzDictType AxzDict::type() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->type();
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return m_type;
 }
 
 bool AxzDict::isType(const AxzDictType type) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->isType(type);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return m_type == type;
 }
 
 bool AxzDict::isNull() const {
@@ -1091,122 +1573,179 @@ bool AxzDict::isCallable() const {
 
 // Value getters
 axz_rc AxzDict::val(int32_t& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    switch (m_type) {
+        case AxzDictType::INTEGRAL: val = m_scalar.integral; return AXZ_OK;
+        case AxzDictType::NUMBER:   val = static_cast<int32_t>(m_scalar.number); return AXZ_OK;
+        default:                    return AXZ_ERROR_NOT_SUPPORT;
+    }
 }
 
 axz_rc AxzDict::val(double& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    switch (m_type) {
+        case AxzDictType::NUMBER:   val = m_scalar.number; return AXZ_OK;
+        case AxzDictType::INTEGRAL: val = static_cast<double>(m_scalar.integral); return AXZ_OK;
+        default:                    return AXZ_ERROR_NOT_SUPPORT;
+    }
 }
 
 axz_rc AxzDict::val(bool& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    if (m_type != AxzDictType::BOOL) {
+        return AXZ_ERROR_NOT_SUPPORT;
+    }
+    val = m_scalar.boolean;
+    return AXZ_OK;
 }
 
 axz_rc AxzDict::val(axz_wstring& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(val);
 }
 
 axz_rc AxzDict::val(axz_bytes& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(val);
 }
 
 // Steal methods
 axz_rc AxzDict::steal(int32_t& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->steal(val);
+    return this->val(val);
 }
 
 axz_rc AxzDict::steal(double& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->steal(val);
+    return this->val(val);
 }
 
 axz_rc AxzDict::steal(bool& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->steal(val);
+    return this->val(val);
 }
 
 axz_rc AxzDict::steal(axz_wstring& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->steal(val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->steal(val);
 }
 
 axz_rc AxzDict::steal(axz_bytes& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->steal(val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->steal(val);
 }
 
 // Key-based operations
 axz_rc AxzDict::val(const axz_wstring& key, AxzDict& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(key, val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(key, val);
 }
 
 axz_rc AxzDict::val(const axz_wstring& key, int32_t& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(key, val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(key, val);
 }
 
 axz_rc AxzDict::val(const axz_wstring& key, double& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(key, val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(key, val);
 }
 
 axz_rc AxzDict::val(const axz_wstring& key, bool& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(key, val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(key, val);
 }
 
 axz_rc AxzDict::val(const axz_wstring& key, axz_wstring& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(key, val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(key, val);
 }
 
 axz_rc AxzDict::val(const axz_wstring& key, axz_bytes& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->val(key, val);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(key, val);
+}
+
+axz_rc AxzDict::val(const size_t idx, AxzDict& val) const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(idx, val);
+}
+
+axz_rc AxzDict::val(const size_t idx, int32_t& val) const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(idx, val);
+}
+
+axz_rc AxzDict::val(const size_t idx, double& val) const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(idx, val);
+}
+
+axz_rc AxzDict::val(const size_t idx, bool& val) const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(idx, val);
+}
+
+axz_rc AxzDict::val(const size_t idx, axz_wstring& val) const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(idx, val);
+}
+
+axz_rc AxzDict::val(const size_t idx, axz_bytes& val) const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->val(idx, val);
 }
 
 // Value accessors
 double AxzDict::numberVal() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->numberVal();
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    switch (m_type) {
+        case AxzDictType::NUMBER:   return m_scalar.number;
+        case AxzDictType::INTEGRAL: return static_cast<double>(m_scalar.integral);
+        default:                    throw std::invalid_argument( "AxzDict::numberVal available for number only" );
+    }
 }
 
 int32_t AxzDict::intVal() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->intVal();
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    switch (m_type) {
+        case AxzDictType::INTEGRAL: return m_scalar.integral;
+        case AxzDictType::NUMBER:   return static_cast<int32_t>(m_scalar.number);
+        default:                    throw std::invalid_argument( "AxzDict::intVal available for number only" );
+    }
 }
 
 bool AxzDict::boolVal() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->boolVal();
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    if (m_type != AxzDictType::BOOL) {
+        throw std::invalid_argument( "AxzDict::boolVal available for boolean only" );
+    }
+    return m_scalar.boolean;
 }
 
 axz_wstring AxzDict::stringVal() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->stringVal();
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->stringVal();
+}
+
+const axz_wstring& AxzDict::stringRef() const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->stringRef();
 }
 
 axz_bytes AxzDict::bytesVal() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->bytesVal();
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->bytesVal();
 }
 
 size_t AxzDict::size() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->size();
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->size();
 }
 
 // Assignment operators
 AxzDict& AxzDict::operator=(const AxzDict& other) {
     if (this != &other) {
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        std::unique_lock<axz_dict_mutex> lock(m_mutex);
+        m_scalar = other.m_scalar;
+        m_type = other.m_type;
         m_val = other.m_val;
     }
     return *this;
@@ -1214,93 +1753,135 @@ AxzDict& AxzDict::operator=(const AxzDict& other) {
 
 AxzDict& AxzDict::operator=(AxzDict&& other) noexcept {
     if (this != &other) {
-        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        std::unique_lock<axz_dict_mutex> lock(m_mutex);
+        m_scalar = other.m_scalar;
+        m_type = other.m_type;
         m_val = std::move(other.m_val);
+        other.m_type = AxzDictType::NUL;
     }
     return *this;
 }
 
 AxzDict& AxzDict::operator=(std::nullptr_t) noexcept {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = _AxzDicDefault::nullVal;
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_type = AxzDictType::NUL;
+    m_val.reset();
     return *this;
 }
 
 AxzDict& AxzDict::operator=(int32_t val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = std::make_shared<_AxzInt>(val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_scalar.integral = val;
+    m_type = AxzDictType::INTEGRAL;
+    m_val.reset();
     return *this;
 }
 
 AxzDict& AxzDict::operator=(double val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = std::make_shared<_AxzDouble>(val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_scalar.number = val;
+    m_type = AxzDictType::NUMBER;
+    m_val.reset();
     return *this;
 }
 
 AxzDict& AxzDict::operator=(bool val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = val ? _AxzDicDefault::trueVal : _AxzDicDefault::falseVal;
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_scalar.boolean = val;
+    m_type = AxzDictType::BOOL;
+    m_val.reset();
     return *this;
 }
 
 AxzDict& AxzDict::operator=(const axz_wstring& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = std::make_shared<_AxzString>(val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_val = _AxzMakeVal<_AxzString>(val);
+    m_type = AxzDictType::STRING;
     return *this;
 }
 
 AxzDict& AxzDict::operator=(axz_wstring&& val) noexcept {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = std::make_shared<_AxzString>(std::move(val));
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_val = _AxzMakeVal<_AxzString>(std::move(val));
+    m_type = AxzDictType::STRING;
     return *this;
 }
 
 AxzDict& AxzDict::operator=(const axz_wchar* val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = std::make_shared<_AxzString>(axz_wstring(val));
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_val = _AxzMakeVal<_AxzString>(axz_wstring(val));
+    m_type = AxzDictType::STRING;
     return *this;
 }
 
 // Array/Object access
+const AxzDict& AxzDict::operator[](const size_t idx) const {
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->at(idx);
+}
+
+AxzDict& AxzDict::operator[](const size_t idx) {
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _exposedNode()->at(idx);
+}
+
 const AxzDict& AxzDict::operator[](const axz_wstring& key) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->at(key);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    return _node()->at(key);
 }
 
 AxzDict& AxzDict::operator[](const axz_wstring& key) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->at(key);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _exposedNode()->at(key);
 }
 
 // Container operations
 axz_rc AxzDict::add(const AxzDict& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->add(val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->add(val);
+}
+
+axz_rc AxzDict::add(AxzDict&& val) {
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->add(std::move(val));
 }
 
 axz_rc AxzDict::add(const axz_wstring& key, const AxzDict& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->add(key, val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->add(key, val);
 }
 
 axz_rc AxzDict::add(const axz_wstring& key, AxzDict&& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->add(key, std::move(val));
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->add(key, std::move(val));
+}
+
+axz_rc AxzDict::insert(const size_t idx, const AxzDict& val) {
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->insert(idx, val);
+}
+
+axz_rc AxzDict::replace(const size_t idx, const AxzDict& val) {
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->replace(idx, val);
 }
 
 void AxzDict::clear() {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val->clear();
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    _mutableNode()->clear();
+}
+
+axz_rc AxzDict::remove(const size_t idx) {
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->remove(idx);
 }
 
 axz_rc AxzDict::remove(const axz_wstring& key) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->remove(key);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->remove(key);
 }
 
 axz_rc AxzDict::contain(const axz_wstring& key) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
     // Implementation for contain method
     if (!isObject()) {
         return AXZ_ERROR_NOT_SUPPORT;
@@ -1311,14 +1892,14 @@ axz_rc AxzDict::contain(const axz_wstring& key) const {
 }
 
 axz_dict_keys AxzDict::keys() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
     axz_dict_keys result;
     
-    if (isObject()) {
+    if (m_type == AxzDictType::OBJECT) {
         // Iterate through object and collect keys
-        auto obj_ptr = static_cast<const _AxzObject*>(m_val.get());
-        for (const auto& pair : obj_ptr->m_val) {
-            result.insert(pair.first);
+        auto obj_ptr = static_cast<const _AxzObject*>(m_val->resolve());
+        for (size_t slot = 0; slot < obj_ptr->size(); ++slot) {
+            result.insert(obj_ptr->keyAt(slot).str());
         }
     }
     
@@ -1326,60 +1907,41 @@ axz_dict_keys AxzDict::keys() const {
 }
 
 void AxzDict::become(AxzDictType type) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    
-    switch (type) {
-        case AxzDictType::NUL:
-            m_val = _AxzDicDefault::nullVal;
-            break;
-        case AxzDictType::BOOL:
-            m_val = _AxzDicDefault::falseVal;
-            break;
-        case AxzDictType::NUMBER:
-            m_val = std::make_shared<_AxzDouble>(0.0);
-            break;
-        case AxzDictType::INTEGRAL:
-            m_val = std::make_shared<_AxzInt>(0);
-            break;
-        case AxzDictType::STRING:
-            m_val = std::make_shared<_AxzString>(axz_wstring());
-            break;
-        case AxzDictType::ARRAY:
-            m_val = std::make_shared<_AxzArray>(axz_dict_array());
-            break;
-        case AxzDictType::OBJECT:
-            m_val = std::make_shared<_AxzObject>(axz_dict_object_safe());
-            break;
-        default:
-            m_val = _AxzDicDefault::nullVal;
-            break;
-    }
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    _reset(type);
 }
 
 void AxzDict::drop() {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val = _AxzDicDefault::nullVal;
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    m_type = AxzDictType::NUL;
+    m_val.reset();
 }
 
 axz_rc AxzDict::step(std::shared_ptr<AxzDictStepper> stepper) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->step(stepper);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
+    switch (m_type) {
+        case AxzDictType::NUL:      return stepper->step(nullptr);
+        case AxzDictType::BOOL:     return stepper->step(m_scalar.boolean);
+        case AxzDictType::INTEGRAL: return stepper->step(m_scalar.integral);
+        case AxzDictType::NUMBER:   return stepper->step(m_scalar.number);
+        default:                    return _node()->step(stepper);
+    }
 }
 
 void AxzDict::reserve(size_t capacity) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    m_val->reserve(capacity);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    _node()->reserve(capacity);
 }
 
 // Steal with key
 axz_rc AxzDict::steal(const axz_wstring& key, AxzDict& val) {
-    std::unique_lock<std::shared_mutex> lock(m_mutex);
-    return m_val->steal(key, val);
+    std::unique_lock<axz_dict_mutex> lock(m_mutex);
+    return _mutableNode()->steal(key, val);
 }
 
 // Dot notation support
 axz_rc AxzDict::dotVal(const axz_wstring& key_list, AxzDict& val) const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    std::shared_lock<axz_dict_mutex> lock(m_mutex);
     
     // Simple implementation - just treat as regular key for now
     // A full implementation would parse the dot notation
@@ -3,8 +3,10 @@
 
 #include "axz_types.h"
 #include "axz_export.h"
+#include "axz_hash.h"
 #include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <memory>
 #include <functional>
 #include <optional>
@@ -12,11 +14,18 @@
 #include <mutex>
 #include <shared_mutex>
 #include <atomic>
-#include <immintrin.h>  // For SIMD optimizations
+#include <stdexcept>
+#include <thread>
+#include <memory_resource>
+#include <cwchar>
 #include <version>      // C++17 feature detection
 #include <cstdint>
 #include <cstring>
 #include <type_traits>
+#include <random>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 // C++17 Feature Detection and Performance Macros
 #if __cpp_if_constexpr >= 201606L
@@ -25,12 +34,118 @@
 #define AXZ_CONSTEXPR_IF 
 #endif
 
-#if defined(__AVX2__) && defined(__BMI2__)
-#define AXZ_SIMD_SUPPORT 1
+// Per-node synchronization. Build with AXZDICT_UNSYNCHRONIZED=1 when every document has a single
+// owner or is guarded from outside (e.g. by UniversalObservableJson's data mutex): AxzDict then
+// takes no locks and keeps no statistics counters. The macro changes the layout of AxzDict and its
+// nodes, so the library and everything linking against it must agree on it (the CMake option takes
+// care of that).
+#ifndef AXZDICT_UNSYNCHRONIZED
+#define AXZDICT_UNSYNCHRONIZED 0
+#endif
+
+#if AXZDICT_UNSYNCHRONIZED
+struct _AxzNullMutex
+{
+	void lock() noexcept {}
+	bool try_lock() noexcept { return true; }
+	void unlock() noexcept {}
+	void lock_shared() noexcept {}
+	bool try_lock_shared() noexcept { return true; }
+	void unlock_shared() noexcept {}
+};
+using axz_dict_mutex = _AxzNullMutex;
 #else
-#define AXZ_SIMD_SUPPORT 0
+// Reader-writer lock in one word, so every AxzDict value does not carry a 56-byte std::shared_mutex.
+// The top bit marks a writer, the next one a waiting writer and the rest count readers. A waiting
+// writer holds off new readers so a steady read load cannot starve it, but only for a bounded number
+// of rounds: a reader already holding a shared lock on the same value, which takes it again, gets in
+// late instead of deadlocking. Waiters spin briefly and then yield: per-value locks are held for a
+// single container operation.
+class _AxzSpinSharedMutex
+{
+public:
+	void lock() noexcept
+	{
+		for ( unsigned spins = 0; ; ++spins )
+		{
+			uint32_t state = m_state.load( std::memory_order_relaxed );
+			if ( ( state & ~WRITER_WAITING ) == 0 )
+			{
+				if ( m_state.compare_exchange_weak( state, WRITER, std::memory_order_acquire, std::memory_order_relaxed ) ) return;
+				continue;
+			}
+			if ( !( state & WRITER_WAITING ) ) m_state.fetch_or( WRITER_WAITING, std::memory_order_relaxed );
+			_backoff( spins );
+		}
+	}
+	bool try_lock() noexcept
+	{
+		uint32_t state = m_state.load( std::memory_order_relaxed );
+		return ( state & ~WRITER_WAITING ) == 0
+			&& m_state.compare_exchange_strong( state, WRITER, std::memory_order_acquire, std::memory_order_relaxed );
+	}
+	// keeps WRITER_WAITING: other writers may still be queued
+	void unlock() noexcept { m_state.fetch_and( ~WRITER, std::memory_order_release ); }
+
+	void lock_shared() noexcept
+	{
+		for ( unsigned spins = 0; !_try_lock_shared( spins >= READER_PATIENCE ); ++spins ) _backoff( spins );
+	}
+	bool try_lock_shared() noexcept { return _try_lock_shared( false ); }
+	void unlock_shared() noexcept { m_state.fetch_sub( 1, std::memory_order_release ); }
+
+private:
+	static constexpr uint32_t WRITER = 1u << 31;
+	static constexpr uint32_t WRITER_WAITING = 1u << 30;
+	static constexpr unsigned READER_PATIENCE = 1024;	// rounds a reader yields to a waiting writer
+
+	bool _try_lock_shared( bool ignore_waiting_writer ) noexcept
+	{
+		uint32_t state = m_state.load( std::memory_order_relaxed );
+		while ( !( state & WRITER ) && ( ignore_waiting_writer || !( state & WRITER_WAITING ) ) )
+		{
+			if ( m_state.compare_exchange_weak( state, state + 1, std::memory_order_acquire, std::memory_order_relaxed ) ) return true;
+		}
+		return false;
+	}
+
+	static void _backoff( unsigned spins ) noexcept
+	{
+		if ( spins >= 64 ) std::this_thread::yield();
+	}
+
+	std::atomic<uint32_t> m_state{ 0 };
+};
+using axz_dict_mutex = _AxzSpinSharedMutex;
 #endif
 
+// Key hashing (see axz_hash.h)
+namespace axz_hash_internal {
+    
+    inline std::size_t hash_wstring(const wchar_t* data, size_t len, uint64_t seed = process_seed()) noexcept {
+        return static_cast<std::size_t>(hash_bytes(data, len * sizeof(wchar_t), seed));
+    }
+    
+    // Wide string hash for the key tables
+    struct UltraFastWStringHash {
+        std::size_t operator()(const axz_wstring& s) const noexcept {
+            return hash_wstring(s.data(), s.size());
+        }
+    };
+    
+    // Wide string equality. wmemcmp is dispatched to the widest vector unit by the C library at load
+    // time, which is what a hand-written AVX2 loop compiled with -march would try to do.
+    struct UltraFastWStringEqual {
+        bool operator()(const axz_wstring& lhs, const axz_wstring& rhs) const noexcept {
+            const size_t len = lhs.size();
+            if (len != rhs.size()) return false;
+            if (lhs.data() == rhs.data()) return true;
+            return std::wmemcmp(lhs.data(), rhs.data(), len) == 0;
+        }
+    };
+}
+
+
 // Performance monitoring and caching
 namespace axz_performance {
     // Cache-line aligned atomic counters for performance tracking
@@ -52,36 +167,45 @@ namespace axz_performance {
     
     extern PerformanceCounters g_counters;
     
-    // High-performance string pool for commonly used keys
+    // Atom table for object keys. Every distinct key is stored once for the lifetime of the process,
+    // so objects keep a pointer to it and compare keys by address. The table only grows - documents
+    // with unbounded key sets (ids used as keys) grow it with them.
     class StringPool {
     private:
-        static constexpr size_t POOL_SIZE = 1024;
         mutable std::shared_mutex pool_mutex;
-        std::unordered_map<axz_wstring, std::shared_ptr<axz_wstring>> pool;
+        // node based: atom addresses never move
+        std::unordered_set<axz_wstring, axz_hash_internal::UltraFastWStringHash, axz_hash_internal::UltraFastWStringEqual> pool;
         
     public:
-        std::shared_ptr<axz_wstring> intern(const axz_wstring& str) {
+        const axz_wstring* intern(const axz_wstring& str) {
             // Fast read path
             {
                 std::shared_lock<std::shared_mutex> lock(pool_mutex);
                 auto it = pool.find(str);
                 if (it != pool.end()) {
                     g_counters.cache_hits.fetch_add(1, std::memory_order_relaxed);
-                    return it->second;
+                    return &*it;
                 }
             }
             
             // Slow write path
             {
                 std::unique_lock<std::shared_mutex> lock(pool_mutex);
-                auto [it, inserted] = pool.emplace(str, std::make_shared<axz_wstring>(str));
+                auto [it, inserted] = pool.insert(str);
                 if (inserted) {
                     g_counters.cache_misses.fetch_add(1, std::memory_order_relaxed);
                 }
-                return it->second;
+                return &*it;
             }
         }
         
+        // Lookup without interning: nullptr when no object ever used this key
+        const axz_wstring* find(const axz_wstring& str) const {
+            std::shared_lock<std::shared_mutex> lock(pool_mutex);
+            auto it = pool.find(str);
+            return it != pool.end() ? &*it : nullptr;
+        }
+        
         size_t size() const {
             std::shared_lock<std::shared_mutex> lock(pool_mutex);
             return pool.size();
@@ -107,187 +231,43 @@ enum class AxzDictType
 class AxzDict;
 using axz_dict_array    = std::vector<AxzDict>;
 
-// Ultra-fast hash and comparison implementation with SIMD optimization
-namespace axz_hash_internal {
-    
-    // Compile-time FNV-1a hash for string literals
-    constexpr std::size_t fnv1a_hash(const wchar_t* str, size_t len) noexcept {
-        constexpr std::size_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
-        constexpr std::size_t FNV_PRIME = 1099511628211ULL;
-        
-        std::size_t hash = FNV_OFFSET_BASIS;
-        for (size_t i = 0; i < len; ++i) {
-            hash ^= static_cast<std::size_t>(str[i]);
-            hash *= FNV_PRIME;
-        }
-        return hash;
-    }
-    
-    // High-performance wide string hash with SIMD acceleration
-    struct UltraFastWStringHash {
-        std::size_t operator()(const axz_wstring& s) const noexcept {
-            axz_performance::g_counters.hash_operations.fetch_add(1, std::memory_order_relaxed);
-            
-            const size_t len = s.size();
-            const wchar_t* data = s.data();
-            
-            if (len == 0) return 0;
-            
-            // Fast path for short strings (most common case)
-            if (len <= 8) {
-                return fnv1a_hash(data, len);
-            }
-            
-#if AXZ_SIMD_SUPPORT
-            // SIMD-accelerated hashing for longer strings
-            return simd_hash(data, len);
-#else
-            // Fallback high-performance hash
-            return fallback_hash(data, len);
-#endif
-        }
-        
-    private:
-#if AXZ_SIMD_SUPPORT
-        std::size_t simd_hash(const wchar_t* data, size_t len) const noexcept {
-            constexpr std::size_t FNV_PRIME = 1099511628211ULL;
-            std::size_t hash = 14695981039346656037ULL;
-            
-            const size_t chunks = len / 8;
-            const wchar_t* ptr = data;
-            
-            // Process 8 wchar_t at a time with AVX2
-            for (size_t i = 0; i < chunks; ++i) {
-                __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
-                
-                // Extract hash contribution from each element
-                alignas(32) uint32_t values[8];
-                _mm256_store_si256(reinterpret_cast<__m256i*>(values), chunk);
-                
-                for (int j = 0; j < 8; ++j) {
-                    hash ^= values[j];
-                    hash *= FNV_PRIME;
-                }
-                
-                ptr += 8;
-            }
-            
-            // Handle remaining elements
-            for (size_t i = chunks * 8; i < len; ++i) {
-                hash ^= static_cast<std::size_t>(data[i]);
-                hash *= FNV_PRIME;
-            }
-            
-            return hash;
-        }
-#endif
-        
-        std::size_t fallback_hash(const wchar_t* data, size_t len) const noexcept {
-            // Optimized FNV-1a with loop unrolling
-            constexpr std::size_t FNV_PRIME = 1099511628211ULL;
-            std::size_t hash = 14695981039346656037ULL;
-            
-            const size_t chunks = len / 4;
-            size_t i = 0;
-            
-            // Unrolled loop for better performance
-            for (size_t c = 0; c < chunks; ++c) {
-                hash ^= static_cast<std::size_t>(data[i]); hash *= FNV_PRIME; ++i;
-                hash ^= static_cast<std::size_t>(data[i]); hash *= FNV_PRIME; ++i;
-                hash ^= static_cast<std::size_t>(data[i]); hash *= FNV_PRIME; ++i;
-                hash ^= static_cast<std::size_t>(data[i]); hash *= FNV_PRIME; ++i;
-            }
-            
-            // Handle remaining elements
-            for (; i < len; ++i) {
-                hash ^= static_cast<std::size_t>(data[i]);
-                hash *= FNV_PRIME;
-            }
-            
-            return hash;
-        }
-    };
-    
-    // Ultra-fast string comparison with SIMD optimization
-    struct UltraFastWStringEqual {
-        bool operator()(const axz_wstring& lhs, const axz_wstring& rhs) const noexcept {
-            axz_performance::g_counters.string_comparisons.fetch_add(1, std::memory_order_relaxed);
-            
-            const size_t len = lhs.size();
-            if (len != rhs.size()) return false;
-            if (len == 0) return true;
-            
-            const wchar_t* data1 = lhs.data();
-            const wchar_t* data2 = rhs.data();
-            
-            // Fast pointer equality check
-            if (data1 == data2) return true;
-            
-#if AXZ_SIMD_SUPPORT
-            return simd_compare(data1, data2, len);
-#else
-            return fallback_compare(data1, data2, len);
-#endif
-        }
-        
-    private:
-#if AXZ_SIMD_SUPPORT
-        bool simd_compare(const wchar_t* data1, const wchar_t* data2, size_t len) const noexcept {
-            const size_t chunks = len / 8;
-            
-            // Compare 8 wchar_t at a time with AVX2
-            for (size_t i = 0; i < chunks; ++i) {
-                __m256i chunk1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data1 + i * 8));
-                __m256i chunk2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data2 + i * 8));
-                __m256i cmp = _mm256_cmpeq_epi32(chunk1, chunk2);
-                
-                if (_mm256_movemask_epi8(cmp) != 0xFFFFFFFF) {
-                    return false;
-                }
-            }
-            
-            // Compare remaining elements
-            for (size_t i = chunks * 8; i < len; ++i) {
-                if (data1[i] != data2[i]) return false;
-            }
-            
-            return true;
-        }
-#endif
-        
-        bool fallback_compare(const wchar_t* data1, const wchar_t* data2, size_t len) const noexcept {
-            // Optimized comparison with loop unrolling
-            const size_t chunks = len / 4;
-            size_t i = 0;
-            
-            for (size_t c = 0; c < chunks; ++c) {
-                if (data1[i] != data2[i]) return false; 
-                ++i;
-                if (data1[i] != data2[i]) return false; 
-                ++i;
-                if (data1[i] != data2[i]) return false; 
-                ++i;
-                if (data1[i] != data2[i]) return false; 
-                ++i;
-            }
-            
-            for (; i < len; ++i) {
-                if (data1[i] != data2[i]) return false;
-            }
-            
-            return true;
-        }
-    };
-}
+// Interned object key - a pointer into axz_performance::g_string_pool. Equal keys share one atom,
+// so object shapes hash and compare the address and never touch the characters.
+class AxzKey final
+{
+public:
+	explicit AxzKey( const axz_wstring* atom ) noexcept : m_atom( atom ) {}
+
+	const axz_wstring& str() const noexcept					{ return *m_atom; }
+	operator const axz_wstring&() const noexcept			{ return *m_atom; }
+
+	bool operator==( const AxzKey& other ) const noexcept	{ return m_atom == other.m_atom; }
+	bool operator!=( const AxzKey& other ) const noexcept	{ return m_atom != other.m_atom; }
+
+	struct Hash
+	{
+		std::size_t operator()( const AxzKey& key ) const noexcept { return std::hash<const void*>()( key.m_atom ); }
+	};
+
+private:
+	const axz_wstring* m_atom;
+};
 
 using axz_dict_object   = std::unordered_map<axz_wstring, AxzDict>;
-using axz_dict_object_safe = std::unordered_map<axz_wstring, AxzDict, 
-                                               axz_hash_internal::UltraFastWStringHash, 
-                                               axz_hash_internal::UltraFastWStringEqual>;
 
 using axz_dict_keys     = std::set<axz_wstring>;
 using axz_dict_callable = std::function<AxzDict ( AxzDict&& )>;
 
+using axz_json_source   = std::shared_ptr<const axz_wstring>;
+using axz_dict_builder  = axz_rc (*)( const axz_json_source& source, size_t offset, AxzDict& out_dict );
+
+// Thrown by every access to a deferred (lazy) container whose text turns out not to be valid JSON
+class AxzDictDeferredError : public std::runtime_error
+{
+public:
+	using std::runtime_error::runtime_error;
+};
+
 using axz_shared_dict   = std::shared_ptr<AxzDict>;
 using axz_weak_dict     = std::weak_ptr<AxzDict>;
 using axz_unique_dict   = std::unique_ptr<AxzDict>;
@@ -295,6 +275,44 @@ using axz_unique_dict   = std::unique_ptr<AxzDict>;
 class _AxzDicVal;
 class AxzDictStepper;
 
+/*
+ * Document-scoped node arena. While an AxzDictArenaScope is active on a thread, every value node
+ * created on that thread (parser, constructors, assignments) is carved out of the arena instead of
+ * the heap. Nodes never free individually; the arena memory is released in one go once the arena
+ * and the last node allocated from it are gone. An arena is not synchronized - only one thread at a
+ * time may have it in scope.
+ */
+class AXZDICT_DECLCLASS AxzDictArena final
+{
+public:
+	explicit AxzDictArena( size_t initial_size = 64 * 1024 );
+	AxzDictArena( const AxzDictArena& ) = delete;
+	AxzDictArena& operator=( const AxzDictArena& ) = delete;
+
+	void* allocate( size_t bytes, size_t alignment );
+	size_t used() const noexcept { return m_used; }		// bytes handed out so far
+
+private:
+	std::pmr::monotonic_buffer_resource m_resource;
+	size_t m_used = 0;
+};
+
+using axz_shared_arena  = std::shared_ptr<AxzDictArena>;
+
+class AXZDICT_DECLCLASS AxzDictArenaScope final
+{
+public:
+	explicit AxzDictArenaScope( axz_shared_arena arena );	// nullptr suspends an outer scope
+	~AxzDictArenaScope();
+	AxzDictArenaScope( const AxzDictArenaScope& ) = delete;
+	AxzDictArenaScope& operator=( const AxzDictArenaScope& ) = delete;
+
+	static const axz_shared_arena& current() noexcept;
+
+private:
+	axz_shared_arena m_previous;
+};
+
 class AXZDICT_DECLCLASS AxzDict final
 {
 public:
@@ -302,16 +320,6 @@ public:
     static constexpr size_t SMALL_STRING_OPTIMIZATION_SIZE = 15;
     static constexpr size_t DEFAULT_RESERVE_SIZE = 16;
     
-    // Cache-line aligned for better performance
-    alignas(64) mutable std::atomic<uint32_t> access_count{0};
-    
-    // Performance statistics for this instance
-    mutable struct {
-        std::atomic<uint32_t> get_operations{0};
-        std::atomic<uint32_t> set_operations{0};
-        std::atomic<uint32_t> memory_reallocations{0};
-    } stats;
-    
 public:	
 	AxzDict() noexcept;
 	AxzDict( AxzDictType type ) noexcept;
@@ -345,6 +353,11 @@ public:
 	AxzDict( AxzDict&& val ) noexcept;
 
 	AxzDict( const axz_dict_callable& val );
+
+	// Deferred object/array: keeps the unparsed range of source starting at offset and runs builder
+	// on first access (operator[], val, size, iteration). The built value is cached and shared by all copies;
+	// when the range is not valid JSON, every access throws AxzDictDeferredError instead.
+	static AxzDict lazy( AxzDictType type, axz_json_source source, size_t offset, axz_dict_builder builder );
 	
 	// Initializer list constructors for convenient syntax
 	AxzDict( std::initializer_list<AxzDict> vals );
@@ -462,6 +475,7 @@ public:
 	int32_t		intVal()	const;
 	bool		boolVal()	const;
 	axz_wstring	stringVal() const;
+	const axz_wstring& stringRef() const;	// no copy; valid until the value is modified
 	axz_bytes	bytesVal()	const;	
 
 	size_t size() const;
@@ -491,6 +505,8 @@ public:
 	axz_rc add( AxzDict&& val );
 	axz_rc add( const axz_wstring& key, const AxzDict& val );
 	axz_rc add( const axz_wstring& key, AxzDict&& val );
+	axz_rc insert( const size_t idx, const AxzDict& val );		// array only; idx may equal size()
+	axz_rc replace( const size_t idx, const AxzDict& val );		// array only
 
 	void clear();	// remove the internal data only, not reset to null
 	axz_rc remove( const size_t idx );
@@ -530,7 +546,7 @@ public:
     };
     
     // Utility methods with performance optimizations
-    bool empty() const noexcept;
+    bool empty() const;
     void reserve( size_t capacity );  // for array and object types
     void shrink_to_fit();  // Reduce memory usage
     
@@ -548,7 +564,21 @@ public:
     
     // Memory-efficient merge operations
     void merge(const AxzDict& other, bool overwrite = true);
-    void merge(AxzDict&& other, bool overwrite = true) noexcept;
+    void merge(AxzDict&& other, bool overwrite = true);
+    
+    // Deep copy. Copies share their containers with the source; a clone shares nothing but callables.
+    AxzDict clone() const;
+    
+    // True when both refer to the same string, bytes or container node, which makes them equal without a look inside.
+    // Copies share their node; clones and parsed documents never do.
+    bool sharesValue( const AxzDict& other ) const noexcept { return this->m_val && this->m_val == other.m_val; }
+    
+    // Serialization cache behind AxzJson::serialize into std::string. A container keeps its last compact UTF-8
+    // text and the containers it was written into; a change through this API drops its text and theirs.
+    // Writes through references from the non-const operator[] and iterators bypass that, so a container that
+    // handed one out is never cached again, and neither is anything containing it.
+    std::shared_ptr<const std::string> jsonCache( const AxzDict* parent ) const;	// nullptr: write it again
+    bool storeJsonCache( std::shared_ptr<const std::string> json ) const;			// json may be nullptr for small containers; false when exposed
     
     // Path-based operations with caching
     axz_rc get_path(std::wstring_view path, AxzDict& result) const;
@@ -560,12 +590,13 @@ public:
     template<typename... Args>
     AxzDict& emplace(Args&&... args);
     
-    // Performance monitoring
+    // Performance monitoring. The counters live in the heap node, so they are shared by copies that
+    // share it and are not kept for inline scalars (or at all when AXZDICT_UNSYNCHRONIZED).
     void reset_stats() noexcept;
-    uint32_t get_access_count() const noexcept { return access_count.load(std::memory_order_relaxed); }
+    uint32_t get_access_count() const noexcept;
     
     // Memory management
-    size_t memory_usage() const noexcept;  // Estimate memory used by this dict
+    size_t memory_usage() const;  // Estimate memory used by this dict
     void compact();  // Optimize internal data structures
     
     // Iterator support for arrays and objects
@@ -585,19 +616,32 @@ public:
     void append(const AxzDict& value);
 
 private:
-	AxzDict( std::shared_ptr<_AxzDicVal> other ): m_val( other ){}
+	AxzDict( std::shared_ptr<_AxzDicVal> other );
+	void _reset( AxzDictType type );
+	_AxzDicVal* _node() const;
+	_AxzDicVal* _mutableNode();		// _node() for a change: drops the serialization cache
+	_AxzDicVal* _exposedNode();		// _node() handing out writable elements: turns the cache off for good
 	void _set( const AxzDict& val );
 	void _set( AxzDict&& val );
 	
-	// Thread safety
-	mutable std::shared_mutex m_mutex;
-	
 	// Internal helper methods
 	axz_wstring _to_wstring_key( std::wstring_view key ) const;
 
 private:
+	// NUL, NUMBER, INTEGRAL and BOOL live inline in m_scalar and never touch the heap;
+	// m_val is only set for strings, bytes, containers and callables
+	union _AxzScalar
+	{
+		double number;
+		int32_t integral;
+		bool boolean;
+	};
+	_AxzScalar m_scalar{};
+	AxzDictType m_type = AxzDictType::NUL;
+	mutable axz_dict_mutex m_mutex;		// no-op type when AXZDICT_UNSYNCHRONIZED
 	std::shared_ptr<_AxzDicVal> m_val;	
 	friend class _AxzDot;	
+	friend class _AxzLazy;
 };
 
 // Iterator classes for AxzDict
@@ -615,6 +659,7 @@ public:
     
     reference operator*() const;
     pointer operator->() const;
+    const axz_wstring& key() const;     // objects only: key of the current value slot
     iterator& operator++();
     iterator operator++(int);
     bool operator==(const iterator& other) const;
@@ -622,12 +667,11 @@ public:
     
 private:
     friend class AxzDict;
-    iterator(std::shared_ptr<_AxzDicVal> val, size_t index);
-    iterator(std::shared_ptr<_AxzDicVal> val, axz_dict_object_safe::iterator it);
+    iterator(std::shared_ptr<_AxzDicVal> val, AxzDict* items, size_t index, bool is_array = true);
     
-    std::shared_ptr<_AxzDicVal> m_val;
+    std::shared_ptr<_AxzDicVal> m_val;      // keeps the container alive
+    AxzDict* m_items = nullptr;    // contiguous elements (arrays) or value slots (objects)
     size_t m_index = 0;
-    axz_dict_object_safe::iterator m_obj_it;
     bool m_is_array = true;
 };
 
@@ -646,6 +690,7 @@ public:
     
     reference operator*() const;
     pointer operator->() const;
+    const axz_wstring& key() const;     // objects only: key of the current value slot
     const_iterator& operator++();
     const_iterator operator++(int);
     bool operator==(const const_iterator& other) const;
@@ -653,20 +698,17 @@ public:
     
 private:
     friend class AxzDict;
-    const_iterator(std::shared_ptr<_AxzDicVal> val, size_t index);
-    const_iterator(std::shared_ptr<_AxzDicVal> val, axz_dict_object_safe::const_iterator it);
+    const_iterator(std::shared_ptr<_AxzDicVal> val, const AxzDict* items, size_t index, bool is_array = true);
     
-    std::shared_ptr<_AxzDicVal> m_val;
+    std::shared_ptr<_AxzDicVal> m_val;      // keeps the container alive
+    const AxzDict* m_items = nullptr;    // contiguous elements (arrays) or value slots (objects)
     size_t m_index = 0;
-    axz_dict_object_safe::const_iterator m_obj_it;
     bool m_is_array = true;
 };
 
 // Template implementation for get_if
 template<typename T>
 std::optional<T> AxzDict::get_if() const {
-    std::shared_lock<std::shared_mutex> lock(m_mutex);
-    
     if constexpr (std::is_same_v<T, double>) {
         if (isNumber() || isIntegral()) {
             return numberVal();
@@ -11,8 +11,13 @@
 // Implementation stubs for missing AxzDict methods with thread safety
 namespace AxzDictCompat {
     
-    // Thread-safe mutex for AxzDict operations
-    static std::mutex axz_operation_mutex;
+    // Thread-safe mutex for AxzDict operations (a no-op when AxzDict is built unsynchronized)
+#if AXZDICT_UNSYNCHRONIZED
+    using axz_operation_mutex_type = _AxzNullMutex;
+#else
+    using axz_operation_mutex_type = std::mutex;
+#endif
+    static axz_operation_mutex_type axz_operation_mutex;
     
     // Create AxzDict with specific type
     inline AxzDict create_typed(AxzDictType type) {
@@ -25,13 +30,9 @@ namespace AxzDictCompat {
     
     // Safe wrapper for contain method with thread safety and bounds checking
     inline bool safe_contain(const AxzDict& dict, const axz_wstring& key) {
-        if (key.empty()) {
-            return false;
-        }
-        
         try {
             // Use lock guard to prevent race conditions in hash table operations
-            std::lock_guard<std::mutex> lock(axz_operation_mutex);
+            std::lock_guard<axz_operation_mutex_type> lock(axz_operation_mutex);
             
             // Validate dict state before operation
             if (dict.type() != AxzDictType::OBJECT) {
@@ -39,6 +40,8 @@ namespace AxzDictCompat {
             }
             
             return dict.has(key);
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container, not a failed lookup
         } catch (const std::exception&) {
             return false; // Safe fallback
         } catch (...) {
@@ -48,13 +51,9 @@ namespace AxzDictCompat {
     
     // Safe wrapper for val method with thread safety and bounds checking
     inline bool safe_val(const AxzDict& dict, const axz_wstring& key, AxzDict& result) {
-        if (key.empty()) {
-            return false;
-        }
-        
         try {
             // Use lock guard to prevent race conditions
-            std::lock_guard<std::mutex> lock(axz_operation_mutex);
+            std::lock_guard<axz_operation_mutex_type> lock(axz_operation_mutex);
             
             // Validate dict state before operation
             if (dict.type() != AxzDictType::OBJECT) {
@@ -62,6 +61,8 @@ namespace AxzDictCompat {
             }
             
             return AXZ_SUCCESS(dict.val(key, result));
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container, not a failed lookup
         } catch (const std::exception&) {
             return false; // Safe fallback
         } catch (...) {
@@ -73,7 +74,7 @@ namespace AxzDictCompat {
     inline bool safe_val(const AxzDict& dict, size_t index, AxzDict& result) {
         try {
             // Use lock guard to prevent race conditions
-            std::lock_guard<std::mutex> lock(axz_operation_mutex);
+            std::lock_guard<axz_operation_mutex_type> lock(axz_operation_mutex);
             
             // Validate dict state and bounds before operation
             if (dict.type() != AxzDictType::ARRAY || index >= dict.size()) {
@@ -81,6 +82,8 @@ namespace AxzDictCompat {
             }
             
             return AXZ_SUCCESS(dict.val(index, result));
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container, not a failed lookup
         } catch (const std::exception&) {
             return false; // Safe fallback
         } catch (...) {
@@ -0,0 +1,96 @@
+#ifndef __axz_hash__
+#define __axz_hash__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Key hashing. wyhash-style: 8-byte loads folded through 64x64->128 bit multiplies, so a 16-char key
+// costs a handful of multiplies instead of one multiply per character like FNV. Plain 64-bit scalar
+// code is the fastest option at key lengths (no SIMD lane shuffling, no CPU dispatch to get wrong).
+// Header-only with no AxzDict dependency, so the JSON adapter shares it on every backend.
+namespace axz_hash_internal {
+    
+    // Full 64x64->128 bit product: a receives the low half, b the high half
+    inline void multiply(uint64_t& a, uint64_t& b) noexcept {
+#if defined(_MSC_VER) && defined(_M_X64)
+        a = _umul128(a, b, &b);
+#else
+        const __uint128_t product = static_cast<__uint128_t>(a) * b;
+        a = static_cast<uint64_t>(product);
+        b = static_cast<uint64_t>(product >> 64);
+#endif
+    }
+    
+    inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+        multiply(a, b);
+        return a ^ b;
+    }
+    
+    inline uint64_t read64(const uint8_t* p) noexcept { uint64_t v; std::memcpy(&v, p, 8); return v; }
+    inline uint64_t read32(const uint8_t* p) noexcept { uint32_t v; std::memcpy(&v, p, 4); return v; }
+    
+    inline uint64_t hash_bytes(const void* data, size_t len, uint64_t seed) noexcept {
+        constexpr uint64_t S0 = 0xa0761d6478bd642full, S1 = 0xe7037ed1a0b428dbull;
+        constexpr uint64_t S2 = 0x8ebc6af09c88c6e3ull, S3 = 0x589965cc75374cc3ull;
+        
+        const uint8_t* p = static_cast<const uint8_t*>(data);
+        seed ^= mix(seed ^ S0, S1);
+        uint64_t a = 0, b = 0;
+        
+        if (len <= 16) {
+            if (len >= 4) {
+                const size_t mid = (len >> 3) << 2;
+                a = (read32(p) << 32) | read32(p + mid);
+                b = (read32(p + len - 4) << 32) | read32(p + len - 4 - mid);
+            } else if (len > 0) {
+                a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[len >> 1]) << 8) | p[len - 1];
+            }
+        } else {
+            size_t i = len;
+            if (i > 48) {
+                uint64_t seed1 = seed, seed2 = seed;
+                do {
+                    seed = mix(read64(p) ^ S1, read64(p + 8) ^ seed);
+                    seed1 = mix(read64(p + 16) ^ S2, read64(p + 24) ^ seed1);
+                    seed2 = mix(read64(p + 32) ^ S3, read64(p + 40) ^ seed2);
+                    p += 48;
+                    i -= 48;
+                } while (i > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while (i > 16) {
+                seed = mix(read64(p) ^ S1, read64(p + 8) ^ seed);
+                p += 16;
+                i -= 16;
+            }
+            a = read64(p + i - 16);
+            b = read64(p + i - 8);
+        }
+        
+        a ^= S1;
+        b ^= seed;
+        multiply(a, b);
+        return mix(a ^ S0 ^ len, b ^ S1);
+    }
+    
+    // Per-process seed so key sets cannot be precomputed to collide (hash flooding)
+    inline uint64_t process_seed() noexcept {
+        static const uint64_t seed = [] {
+            uint64_t value = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(&value));
+            try {
+                std::random_device device;
+                value ^= (static_cast<uint64_t>(device()) << 32) | device();
+            } catch (...) {
+            }
+            return mix(value, 0x9e3779b97f4a7c15ull);
+        }();
+        return seed;
+    }
+}
+
+#endif
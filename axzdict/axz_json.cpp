@@ -1,74 +1,116 @@
 #include "axz_json.h"
 #include "axz_error_codes.h"
 #include "axz_dict_stepper.h"
+#include "axz_simd.h"
 #include <stack>
 #include <algorithm>
 #include <cwctype>
 #include <string>
 #include <sstream>
+#include <charconv>
+#include <cstring>
+#include <ostream>
+#include <type_traits>
 
 namespace
 {
 namespace Internal
 {    
     /*
-     * Json stepper class - serialize the dictionary in json format to raw json string
+     * Json writer - serialize the dictionary in json format straight into the output. It walks AxzDict
+     * directly (no stepper, no virtual dispatch per node); the Output policy owns the encoding, so the same
+     * walk feeds a wide string or UTF-8 bytes.
      */
-	class AxzJsonStepper: public AxzDictStepper
+	template <class Output>
+	class AxzJsonWriter final
 	{
 	public:
-		AxzJsonStepper(): AxzDictStepper() {};
-		virtual ~AxzJsonStepper() {}
-		axz_rc build( const AxzDict& in_dict, axz_wstring& out_json );
-
-		virtual axz_rc step( std::nullptr_t )              override;	
-		virtual axz_rc step( const bool val )              override;
-		virtual axz_rc step( const int32_t val )           override;
-		virtual axz_rc step( const double val )            override;
-		virtual axz_rc step( const axz_wstring& val )      override;
-		virtual axz_rc step( const axz_bytes& val )        override;
-		virtual axz_rc step( const axz_dict_array& vals )  override;
-		virtual axz_rc step( const axz_dict_object& vals ) override;
-
-	protected:
-		axz_wstring _encodeString( const axz_wstring & to_encode ) const;
-
-	protected:
-		axz_wstring m_json;
+		AxzJsonWriter( Output& out, bool nice_format, bool use_cache = false ): m_out( out ), m_nice( nice_format ), m_cache( use_cache ) {}
+		axz_rc write( const AxzDict& value );
+
+	private:
+		axz_rc _writeContainer( const AxzDict& container );
+		axz_rc _writeCached( const AxzDict& container );
+		axz_rc _writeArray( const AxzDict& array );
+		axz_rc _writeObject( const AxzDict& object );
+		void _writeString( const axz_wstring& str );
+		void _writeNumber( const double val );
+		void _writeInteger( const int32_t val );
+		void _writeSeparator( bool first );
+		void _writeClose( char bracket, bool empty );
+
+	private:
+		Output& m_out;
+		const bool m_nice;
+		const bool m_cache;						// compact UTF-8 into a string only, see AxzDict::jsonCache
+		const AxzDict* m_parent = nullptr;		// container being written, while m_cache
+		bool m_uncacheable = false;				// a container written inside m_parent could not be cached
+		int m_indent = 0;
 	};
 
-    /*
-     * Nice json stepper class - serialize the dictionary in json format to pretty printed json string
-     */
-	class AxzNiceJsonStepper final: public AxzJsonStepper
+	// containers below this many bytes are cheaper to write again than to keep a copy of
+	constexpr size_t MIN_CACHED_JSON = 256;
+
+	// Output policy appending to an axz_wstring
+	class AxzWideOutput final
 	{
 	public:
-		AxzNiceJsonStepper(): AxzJsonStepper(), m_indent( 0 ) {};
-		virtual ~AxzNiceJsonStepper() {}
+		explicit AxzWideOutput( axz_wstring& out_json ): m_json( out_json ) {}
+		bool failed() const { return false; }
+		void put( char c ) { this->m_json += static_cast<wchar_t>( c ); }
+		void ascii( const char* data, size_t size );
+		void spaces( size_t count ) { this->m_json.append( count, L' ' ); }
+		void text( const wchar_t* data, size_t size ) { this->m_json.append( data, size ); }
 
-		virtual axz_rc step( const axz_dict_array& vals )  override;
-		virtual axz_rc step( const axz_dict_object& vals ) override;
+	private:
+		axz_wstring& m_json;
+	};
+
+	// Output policy encoding UTF-8. Without a sink everything stays in the buffer; with one, the buffer is
+	// handed over whenever the next token would push it past the chunk size.
+	class AxzUtf8Output final
+	{
+	public:
+		AxzUtf8Output( std::string& buffer, const axz_json_sink* sink, size_t chunk_size ): m_buffer( buffer ), m_sink( sink ), m_chunk( chunk_size ) {}
+		bool failed() const { return AXZ_FAILED( this->m_rc ); }
+		void put( char c ) { this->_reserve( 1 ); this->m_buffer += c; }
+		void ascii( const char* data, size_t size ) { this->_reserve( size ); this->m_buffer.append( data, size ); }
+		void spaces( size_t count );
+		void text( const wchar_t* data, size_t size );
+		axz_rc finish();
+
+		// everything written so far, while there is no sink
+		size_t size() const { return this->m_buffer.size(); }
+		const char* data() const { return this->m_buffer.data(); }
 
 	private:
-		int m_indent;
-		
-		void append_indent() {
-			for (int i = 0; i < m_indent; i++) {
-				this->m_json += L" ";
-			}
-		}
+		void _reserve( size_t size );
+		void _flush();
+
+	private:
+		std::string& m_buffer;
+		const axz_json_sink* m_sink;
+		const size_t m_chunk;
+		axz_rc m_rc = AXZ_OK;
 	};
 
+	// worst case UTF-8 bytes per wchar_t code unit - a UTF-16 surrogate pair takes 4 bytes for 2 units
+	constexpr size_t UTF8_PER_UNIT = ( sizeof( wchar_t ) == 2 ) ? 3 : 4;
+	size_t _encodeUtf8( const wchar_t* data, size_t size, char* out );
+	void _appendCodePoint( uint32_t cp, axz_wstring& out );
+
 	/*
 	 * AxzJsonBuilder class - deserialize a string in json format to dictionary type.
      * The work is inspired from 4V WaJsonFactory class. Anything changes in WaJsonFactory needs to be synchronized here
 	 */
 	namespace AxzJsonBuilder
 	{
-		axz_rc build( axz_wstring json_in, AxzDict & json_value );
-		axz_rc _build( const axz_wstring & str, size_t & pos, AxzDict & json_value );
-		axz_rc _buildObject( const axz_wstring & str, size_t & pos, AxzDict & json_object );	
-		axz_rc _buildArray( const axz_wstring & str, size_t & pos, AxzDict& json_array );
+		axz_rc build( axz_wstring json_in, AxzDict & json_value, bool lazy );
+		axz_rc _build( const axz_wstring & str, size_t & pos, AxzDict & json_value, const axz_json_source & lazy_source );
+		axz_rc _buildObject( const axz_wstring & str, size_t & pos, AxzDict & json_object, const axz_json_source & lazy_source );	
+		axz_rc _buildArray( const axz_wstring & str, size_t & pos, AxzDict& json_array, const axz_json_source & lazy_source );
+		axz_rc _buildDeferred( const axz_json_source & source, size_t offset, AxzDict & json_value );
+		axz_rc _skipContainer( const axz_wstring & str, size_t & pos );
 		axz_rc _buildString( const axz_wstring & str, size_t & pos, axz_wstring & json_string );
 		axz_rc _buildSpecialCase( const axz_wstring & str, size_t & pos, AxzDict & json_special );
 		axz_rc _buildNumber( const axz_wstring & str, size_t & pos, AxzDict & json_number );
@@ -84,13 +126,109 @@ namespace AxzJson
 {
     axz_rc serialize( const AxzDict& in_dict, axz_wstring& out_json, bool in_nice_format /*= false*/ )
     {
-        auto stepper = ( in_nice_format )? ( std::make_shared<Internal::AxzNiceJsonStepper>() ): ( std::make_shared<Internal::AxzJsonStepper>() );
-        return stepper->build( in_dict, out_json );
+        out_json.clear();
+        out_json.reserve( 256 );
+        Internal::AxzWideOutput out( out_json );
+        const axz_rc rc = Internal::AxzJsonWriter<Internal::AxzWideOutput>( out, in_nice_format ).write( in_dict );
+        if ( AXZ_FAILED( rc ) ) {
+            out_json.clear();
+        }
+        return rc;
+    }
+
+    axz_rc serialize( const AxzDict& in_dict, std::string& out_json, bool in_nice_format /*= false*/, bool in_use_cache /*= false*/ )
+    {
+        out_json.clear();
+        out_json.reserve( 256 );
+        Internal::AxzUtf8Output out( out_json, nullptr, 0 );
+        axz_rc rc = Internal::AxzJsonWriter<Internal::AxzUtf8Output>( out, in_nice_format, in_use_cache && !in_nice_format ).write( in_dict );
+        if ( AXZ_SUCCESS( rc ) ) {
+            rc = out.finish();
+        }
+        if ( AXZ_FAILED( rc ) ) {
+            out_json.clear();
+        }
+        return rc;
+    }
+
+    axz_rc serialize( const AxzDict& in_dict, const axz_json_sink& in_sink, bool in_nice_format /*= false*/, size_t in_chunk_size /*= 64 * 1024*/ )
+    {
+        if ( !in_sink ) {
+            return AXZ_ERROR_INVALID_INPUT;
+        }
+        // a single text piece encodes to at most 4 KiB, see AxzUtf8Output::text()
+        const size_t chunk_size = std::max<size_t>( in_chunk_size, 4096 );
+        std::string buffer;
+        buffer.reserve( chunk_size );
+        Internal::AxzUtf8Output out( buffer, &in_sink, chunk_size );
+        const axz_rc rc = Internal::AxzJsonWriter<Internal::AxzUtf8Output>( out, in_nice_format ).write( in_dict );
+        const axz_rc flush_rc = out.finish();
+        return AXZ_FAILED( rc ) ? rc : flush_rc;
+    }
+
+	axz_rc deserialize( const axz_wstring& in_json, AxzDict& out_dict, bool in_lazy /*= false*/ )
+    {
+        return Internal::AxzJsonBuilder::build( in_json, out_dict, in_lazy );
+    }
+
+	axz_rc deserialize( axz_wstring&& in_json, AxzDict& out_dict, bool in_lazy /*= false*/ )
+    {
+        return Internal::AxzJsonBuilder::build( std::move( in_json ), out_dict, in_lazy );
+    }
+
+    axz_json_sink streamSink( std::ostream& out_stream )
+    {
+        return [&out_stream]( const char* data, size_t size ) -> axz_rc
+        {
+            out_stream.write( data, static_cast<std::streamsize>( size ) );
+            return out_stream ? AXZ_OK : AXZ_ERROR_INVALID_OUTPUT;
+        };
+    }
+
+    void toUtf8( const wchar_t* in_data, size_t in_size, std::string& out_utf8 )
+    {
+        const size_t start = out_utf8.size();
+        out_utf8.resize( start + in_size * Internal::UTF8_PER_UNIT );
+        const size_t written = Internal::_encodeUtf8( in_data, in_size, &out_utf8[start] );
+        out_utf8.resize( start + written );
     }
-    
-	axz_rc deserialize( const axz_wstring& in_json, AxzDict& out_dict )
+
+    void fromUtf8( const char* in_data, size_t in_size, axz_wstring& out_wide )
     {
-        return Internal::AxzJsonBuilder::build( in_json, out_dict );
+        out_wide.reserve( out_wide.size() + in_size );
+        const unsigned char* p = reinterpret_cast<const unsigned char*>( in_data );
+        const unsigned char* const end = p + in_size;
+        while ( p < end )
+        {
+            if ( *p < 0x80 ) {
+                out_wide += static_cast<wchar_t>( *p++ );
+                continue;
+            }
+
+            uint32_t cp;
+            size_t trail;
+            uint32_t smallest;
+            if ( ( *p & 0xE0 ) == 0xC0 )      { cp = *p & 0x1F; trail = 1; smallest = 0x80; }
+            else if ( ( *p & 0xF0 ) == 0xE0 ) { cp = *p & 0x0F; trail = 2; smallest = 0x800; }
+            else if ( ( *p & 0xF8 ) == 0xF0 ) { cp = *p & 0x07; trail = 3; smallest = 0x10000; }
+            else {
+                out_wide += static_cast<wchar_t>( 0xFFFD );	// stray continuation or invalid lead byte
+                ++p;
+                continue;
+            }
+
+            size_t used = 1;
+            while ( used <= trail && p + used < end && ( p[used] & 0xC0 ) == 0x80 )
+            {
+                cp = ( cp << 6 ) | ( p[used++] & 0x3F );
+            }
+            // truncated, overlong, surrogate or past U+10FFFF - one replacement for the bytes looked at
+            if ( used <= trail || cp < smallest || cp > 0x10FFFF || ( cp >= 0xD800 && cp <= 0xDFFF ) ) {
+                cp = 0xFFFD;
+            }
+            Internal::_appendCodePoint( cp, out_wide );
+            p += used;
+        }
     }
 };
 
@@ -98,236 +236,350 @@ namespace
 {
 namespace Internal
 {	
-	//-------------< Start - AxzJsonStepper Implementation >----------------------
+	//-------------< Start - AxzJsonWriter Implementation >----------------------
 	//
-	axz_rc AxzJsonStepper::build( const AxzDict& in_dict, axz_wstring& out_json )
-	{
-        out_json.clear();
-        this->m_json.clear();
-        
-        // Reserve memory for better performance - use adaptive sizing
-        size_t estimated_size = 512; // Conservative base size
-        this->m_json.reserve(estimated_size);
-
-        auto rc = in_dict.step( this->shared_from_this() );
-        if ( AXZ_SUCCESS( rc ) ) 
-        {
-            out_json = std::move( this->m_json );
-        }
-    
-		return rc;
-	}
-
-	axz_rc AxzJsonStepper::step( std::nullptr_t )
-	{
-		this->m_json += L"null";
-		return AXZ_OK;
-	}
-
-	axz_rc AxzJsonStepper::step( const bool val )
+	template <class Output>
+	axz_rc AxzJsonWriter<Output>::write( const AxzDict& value )
 	{
-		this->m_json += ( val ? L"true" : L"false" );
-		return AXZ_OK;
+		switch ( value.type() )
+		{
+		case AxzDictType::NUL:
+		case AxzDictType::CALLABLE:
+			this->m_out.ascii( "null", 4 );
+			return AXZ_OK;
+		case AxzDictType::BOOL:
+			if ( value.boolVal() ) {
+				this->m_out.ascii( "true", 4 );
+			} else {
+				this->m_out.ascii( "false", 5 );
+			}
+			return AXZ_OK;
+		case AxzDictType::INTEGRAL:
+			this->_writeInteger( value.intVal() );
+			return AXZ_OK;
+		case AxzDictType::NUMBER:
+			this->_writeNumber( value.numberVal() );
+			return AXZ_OK;
+		case AxzDictType::STRING:
+			this->_writeString( value.stringRef() );
+			return AXZ_OK;
+		case AxzDictType::BYTES:
+			this->m_out.ascii( "\"not supported\"", 15 );	// we will encode the bytes with base64 later, not supported for now
+			return AXZ_OK;
+		case AxzDictType::ARRAY:
+		case AxzDictType::OBJECT:
+			return this->_writeContainer( value );
+		}
+		return AXZ_ERROR_NOT_SUPPORT;
 	}
 
-	axz_rc AxzJsonStepper::step( const int32_t val )
+	template <class Output>
+	axz_rc AxzJsonWriter<Output>::_writeContainer( const AxzDict& container )
 	{
-		this->m_json += std::to_wstring( ( long )val );	
-		return AXZ_OK;
+		if constexpr ( std::is_same_v<Output, AxzUtf8Output> )
+		{
+			if ( this->m_cache ) {
+				return this->_writeCached( container );
+			}
+		}
+		return container.isArray() ? this->_writeArray( container ) : this->_writeObject( container );
 	}
 
-	axz_rc AxzJsonStepper::step( const double val )
+	template <class Output>
+	axz_rc AxzJsonWriter<Output>::_writeCached( const AxzDict& container )
 	{
-		this->m_json += std::to_wstring( val );	
-		return AXZ_OK;
-	}
+		// the lookup also records the enclosing container, so a change in here drops its text too
+		if ( const auto cached = container.jsonCache( this->m_parent ) ) {
+			this->m_out.ascii( cached->data(), cached->size() );
+			return AXZ_OK;
+		}
 
-	axz_rc AxzJsonStepper::step( const axz_wstring& val )
-	{
-		this->m_json += L"\"" + this->_encodeString( val ) + L"\"";
-		return AXZ_OK;
+		const size_t start = this->m_out.size();
+		const AxzDict* outer = this->m_parent;
+		const bool outer_uncacheable = this->m_uncacheable;
+		this->m_parent = &container;
+		this->m_uncacheable = false;
+		const axz_rc rc = container.isArray() ? this->_writeArray( container ) : this->_writeObject( container );
+		this->m_parent = outer;
+
+		// text embedding an uncacheable container could go stale without notice
+		bool stored = false;
+		if ( AXZ_SUCCESS( rc ) && !this->m_uncacheable ) {
+			const size_t length = this->m_out.size() - start;
+			stored = container.storeJsonCache( length >= MIN_CACHED_JSON ? std::make_shared<const std::string>( this->m_out.data() + start, length ) : nullptr );
+		}
+		this->m_uncacheable = outer_uncacheable || !stored;
+		return rc;
 	}
 
-	axz_rc AxzJsonStepper::step( const axz_bytes& )
+	template <class Output>
+	axz_rc AxzJsonWriter<Output>::_writeArray( const AxzDict& array )
 	{
-		this->m_json += L"\"not supported\"";	// we will encode the bytes with base64 later, not supported for now
+		this->m_out.put( '[' );
+		bool first = true;
+		for ( const auto& item : array )
+		{
+			// a sink that gave up will not take the rest of the document
+			if ( this->m_out.failed() ) {
+				return AXZ_OK;
+			}
+			this->_writeSeparator( first );
+			const axz_rc rc = this->write( item );
+			if ( AXZ_FAILED( rc ) ) {
+				return rc;
+			}
+			first = false;
+		}
+		this->_writeClose( ']', first );
 		return AXZ_OK;
 	}
 
-	axz_rc AxzJsonStepper::step( const axz_dict_array& vals )
+	template <class Output>
+	axz_rc AxzJsonWriter<Output>::_writeObject( const AxzDict& object )
 	{
+		// insertion order - the object's shape, not a temporary hash map
+		this->m_out.put( '{' );
 		bool first = true;
-		this->m_json += L"[";
-        axz_rc rc = AXZ_OK;
-
-		for (const auto &item : vals ) 
+		for ( auto it = object.begin(), end = object.end(); it != end; ++it )
 		{
-			if (!first) {
-				this->m_json += L", ";
-            }
-		
-			if ( AXZ_FAILED( rc = item.step( this->shared_from_this() ) ) ) {
-                break;
-            }
+			if ( this->m_out.failed() ) {
+				return AXZ_OK;
+			}
+			this->_writeSeparator( first );
+			this->_writeString( it.key() );
+			this->m_out.ascii( ": ", 2 );
+			const axz_rc rc = this->write( *it );
+			if ( AXZ_FAILED( rc ) ) {
+				return rc;
+			}
 			first = false;
 		}
-
-        if ( AXZ_SUCCESS( rc ) ) {
-    		this->m_json += L"]";
-        }
-		return rc;
+		this->_writeClose( '}', first );
+		return AXZ_OK;
 	}
 
-	axz_rc AxzJsonStepper::step( const axz_dict_object& vals )
+	template <class Output>
+	void AxzJsonWriter<Output>::_writeSeparator( bool first )
 	{
-		bool first = true;
-		this->m_json += L"{";
-        axz_rc rc = AXZ_OK;
-
-		for ( const auto &kv : vals ) {
-			if (!first) {
-				this->m_json += L", ";
-            }
-
-			this->m_json += L"\"" + this->_encodeString( kv.first ) + L"\": ";				
-			if ( AXZ_FAILED( rc = kv.second.step( this->shared_from_this() ) ) ) {
-                break;
-            }
-		
-			first = false;
+		if ( !this->m_nice ) {
+			if ( !first ) {
+				this->m_out.ascii( ", ", 2 );
+			}
+			return;
 		}
-        
-        if ( AXZ_SUCCESS( rc ) ) {
-    		this->m_json += L"}";
-        }
 
-		return rc;
+		if ( first ) {
+			this->m_indent += 4;
+			this->m_out.put( '\n' );
+		} else {
+			this->m_out.ascii( ",\n", 2 );
+		}
+		this->m_out.spaces( this->m_indent );
 	}
 
-	axz_wstring AxzJsonStepper::_encodeString( const axz_wstring & to_encode ) const
+	template <class Output>
+	void AxzJsonWriter<Output>::_writeClose( char bracket, bool empty )
 	{
-		// Early return for empty strings
-		if (to_encode.empty()) return L"";
-		
-		// Check if encoding is needed - fast scan first
-		bool needs_encoding = false;
-		for (const wchar_t c : to_encode) {
-			if (c < 0x20 || c == L'"' || c == L'\\') {
-				needs_encoding = true;
-				break;
-			}
+		if ( this->m_nice && !empty ) {
+			this->m_indent -= 4;
+			this->m_out.put( '\n' );
+			this->m_out.spaces( this->m_indent );
 		}
-		
-		// If no encoding needed, return original
-		if (!needs_encoding) return to_encode;
+		this->m_out.put( bracket );
+	}
 
-		// Pre-allocate with estimated size
-		axz_wstring ret;
-		ret.reserve(to_encode.size() + (to_encode.size() >> 3)); // +12.5% for escapes
+	template <class Output>
+	void AxzJsonWriter<Output>::_writeString( const axz_wstring& str )
+	{
+		static constexpr char HEX[] = "0123456789abcdef";
+		const wchar_t* data = str.data();
+		const size_t length = str.size();
 
-		for (const wchar_t c : to_encode) {
-			// Fast path for common characters  
-			if (c >= 0x20 && c != L'"' && c != L'\\') {
-				ret += c;
-				continue;
+		this->m_out.put( '"' );
+		size_t pos = 0;
+		while ( true )
+		{
+			// verbatim run up to the next character that needs escaping
+			const size_t run = AxzSimd::findJsonSpecial( data + pos, length - pos );
+			this->m_out.text( data + pos, run );
+			pos += run;
+			if ( pos == length ) {
+				break;
 			}
 
-			// Handle escapes
-			switch (c) {
-			case L'"':  ret += L"\\\""; break;
-			case L'\\': ret += L"\\\\"; break;
-			case L'\t': ret += L"\\t";  break;
-			case L'\n': ret += L"\\n";  break;
-			case L'\r': ret += L"\\r";  break;
-			case L'\b': ret += L"\\b";  break;
-			case L'\f': ret += L"\\f";  break;
+			const wchar_t c = data[pos++];
+			switch ( c )
+			{
+			case L'"':  this->m_out.ascii( "\\\"", 2 ); break;
+			case L'\\': this->m_out.ascii( "\\\\", 2 ); break;
+			case L'\t': this->m_out.ascii( "\\t", 2 );  break;
+			case L'\n': this->m_out.ascii( "\\n", 2 );  break;
+			case L'\r': this->m_out.ascii( "\\r", 2 );  break;
+			case L'\b': this->m_out.ascii( "\\b", 2 );  break;
+			case L'\f': this->m_out.ascii( "\\f", 2 );  break;
 			default:
-				if (c < 0x20) {
-					wchar_t buff[8];
-					std::swprintf(buff, 8, L"\\u%04x", c);
-					ret += buff;
-				} else {
-					ret += c;
+				{
+					const char escape[] = { '\\', 'u', '0', '0', HEX[( c >> 4 ) & 0xF], HEX[c & 0xF] };
+					this->m_out.ascii( escape, 6 );
 				}
 				break;
 			}
 		}
-		return ret;
+		this->m_out.put( '"' );
 	}
-    //
-  	//-------------< End - AxzJsonStepper Implementation >----------------------
 
+	template <class Output>
+	void AxzJsonWriter<Output>::_writeNumber( const double val )
+	{
+		// NaN and infinities have no JSON form. Checked on the bits: -ffast-math folds std::isfinite away.
+		uint64_t bits;
+		std::memcpy( &bits, &val, sizeof( bits ) );
+		if ( ( ( bits >> 52 ) & 0x7FF ) == 0x7FF ) {
+			this->m_out.ascii( "null", 4 );
+			return;
+		}
 
-   	//-------------< Start - AxzNiceJsonStepper Implementation >----------------------
-	//	
-	axz_rc AxzNiceJsonStepper::step( const axz_dict_array& vals )
-	{			
-		bool first = true;
-		this->m_json += L"[\n";
-		axz_rc rc = AXZ_OK;
-		
-		for ( const auto &item : vals ) 
-		{
-			if ( !first ) {
-				this->m_json += L",\n";
-            }
+		// shortest text that parses back to the same double
+		char buffer[32];
+		char* end = std::to_chars( buffer, buffer + sizeof( buffer ) - 2, val ).ptr;
+		if ( std::find_if( buffer, end, []( char c ) { return c == '.' || c == 'e'; } ) == end ) {
+			*end++ = '.';		// keep it a NUMBER when parsed back, not an INTEGRAL
+			*end++ = '0';
+		}
+		this->m_out.ascii( buffer, static_cast<size_t>( end - buffer ) );
+	}
 
-			this->m_indent += 4;
-			append_indent();
+	template <class Output>
+	void AxzJsonWriter<Output>::_writeInteger( const int32_t val )
+	{
+		char buffer[16];
+		const char* end = std::to_chars( buffer, buffer + sizeof( buffer ), val ).ptr;
+		this->m_out.ascii( buffer, static_cast<size_t>( end - buffer ) );
+	}
+    //
+  	//-------------< End - AxzJsonWriter Implementation >----------------------
 
-			if ( AXZ_FAILED( rc = item.step( this->shared_from_this() ) ) ) {
-                break;
-            }
-			this->m_indent -= 4;
-			first = false;
-		}	
+	//-------------< Start - Output policies >----------------------
+	//
+	void AxzWideOutput::ascii( const char* data, size_t size )
+	{
+		// widen in place - append( first, last ) with char iterators builds a temporary wide string
+		wchar_t wide[32];
+		while ( size > 0 )
+		{
+			const size_t piece = std::min( size, sizeof( wide ) / sizeof( wide[0] ) );
+			std::copy( data, data + piece, wide );
+			this->m_json.append( wide, piece );
+			data += piece;
+			size -= piece;
+		}
+	}
 
-        if ( AXZ_SUCCESS( rc ) ) {	
-		    this->m_json += L"\n";
-		    append_indent();
-		    this->m_json += L"]";		
-        }
+	void AxzUtf8Output::spaces( size_t count )
+	{
+		static constexpr char SPACES[] = "                                                                ";
+		while ( count > 0 )
+		{
+			const size_t piece = std::min( count, sizeof( SPACES ) - 1 );
+			this->ascii( SPACES, piece );
+			count -= piece;
+		}
+	}
 
-		return rc;
+	void AxzUtf8Output::text( const wchar_t* data, size_t size )
+	{
+		// encode 1024 units at a time so one piece never outgrows the smallest chunk
+		char bytes[1024 * UTF8_PER_UNIT];
+		while ( size > 0 )
+		{
+			size_t piece = std::min<size_t>( size, 1024 );
+			if ( sizeof( wchar_t ) == 2 && piece < size && ( data[piece - 1] & 0xFC00 ) == 0xD800 ) {
+				--piece;	// keep a surrogate pair in the same piece
+			}
+			const size_t written = _encodeUtf8( data, piece, bytes );
+			this->ascii( bytes, written );
+			data += piece;
+			size -= piece;
+		}
 	}
 
-	axz_rc AxzNiceJsonStepper::step( const axz_dict_object& vals )
-	{		
-		bool first = true;
-		this->m_json += L"{\n";				
-        axz_rc rc = AXZ_OK;
+	axz_rc AxzUtf8Output::finish()
+	{
+		if ( this->m_sink ) {
+			this->_flush();
+		}
+		return this->m_rc;
+	}
 
-		for ( const auto &kv : vals ) {
-			if (!first) {
-				this->m_json += L",\n";
-            }
+	void AxzUtf8Output::_reserve( size_t size )
+	{
+		if ( this->m_sink && this->m_buffer.size() + size > this->m_chunk ) {
+			this->_flush();
+		}
+	}
 
-			this->m_indent += 4;
-			append_indent();
-			this->m_json += L"\"" + this->_encodeString(kv.first) + L"\": ";
+	void AxzUtf8Output::_flush()
+	{
+		// after a failure the output is only drained, so memory stays bounded until the writer unwinds
+		if ( AXZ_SUCCESS( this->m_rc ) && !this->m_buffer.empty() ) {
+			this->m_rc = ( *this->m_sink )( this->m_buffer.data(), this->m_buffer.size() );
+		}
+		this->m_buffer.clear();
+	}
 
-    		if ( AXZ_FAILED( rc = kv.second.step( this->shared_from_this() ) ) ) {
-                break;
-            }
-			this->m_indent -= 4;
-			first = false;
-		}	
+	size_t _encodeUtf8( const wchar_t* data, size_t size, char* out )
+	{
+		char* const begin = out;
+		for ( size_t i = 0; i < size; ++i )
+		{
+			uint32_t cp = static_cast<uint32_t>( data[i] );
+			if ( cp < 0x80 ) {
+				*out++ = static_cast<char>( cp );
+				continue;
+			}
+			if ( sizeof( wchar_t ) == 2 ) {
+				cp &= 0xFFFF;
+				if ( ( cp & 0xFC00 ) == 0xD800 && i + 1 < size && ( static_cast<uint32_t>( data[i + 1] ) & 0xFC00 ) == 0xDC00 ) {
+					cp = 0x10000 + ( ( cp - 0xD800 ) << 10 ) + ( ( static_cast<uint32_t>( data[++i] ) & 0xFFFF ) - 0xDC00 );
+				}
+			}
+			if ( cp > 0x10FFFF || ( cp >= 0xD800 && cp <= 0xDFFF ) ) {
+				cp = 0xFFFD;
+			}
+
+			if ( cp < 0x800 ) {
+				*out++ = static_cast<char>( 0xC0 | ( cp >> 6 ) );
+			} else if ( cp < 0x10000 ) {
+				*out++ = static_cast<char>( 0xE0 | ( cp >> 12 ) );
+				*out++ = static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+			} else {
+				*out++ = static_cast<char>( 0xF0 | ( cp >> 18 ) );
+				*out++ = static_cast<char>( 0x80 | ( ( cp >> 12 ) & 0x3F ) );
+				*out++ = static_cast<char>( 0x80 | ( ( cp >> 6 ) & 0x3F ) );
+			}
+			*out++ = static_cast<char>( 0x80 | ( cp & 0x3F ) );
+		}
+		return static_cast<size_t>( out - begin );
+	}
 
-        if ( AXZ_SUCCESS( rc ) ) {	
-		    this->m_json += L"\n";
-		    append_indent();
-		    this->m_json += L"}";		
+	void _appendCodePoint( uint32_t cp, axz_wstring& out )
+	{
+		if ( sizeof( wchar_t ) == 2 && cp >= 0x10000 ) {
+			cp -= 0x10000;
+			out += static_cast<wchar_t>( 0xD800 + ( cp >> 10 ) );
+			out += static_cast<wchar_t>( 0xDC00 + ( cp & 0x3FF ) );
+			return;
 		}
-		return rc;
+		out += static_cast<wchar_t>( cp );
 	}
     //
-    //-------------< End - AxzNiceJsonStepper Implementation >----------------------
+  	//-------------< End - Output policies >----------------------
 
 	//-------------< Start - AxzJsonBuilder Implementation >----------------------
 	//
 	namespace AxzJsonBuilder
     {
-	    axz_rc build( axz_wstring json_in, AxzDict & json_value )
+	    axz_rc build( axz_wstring json_in, AxzDict & json_value, bool lazy )
 	    {
 		    // validate against null
 		    if( json_in.empty() )
@@ -339,9 +591,17 @@ namespace Internal
 		    // clear all new lines so we are working with 1 constant string
 		    AxzJsonBuilder::_replaceChars( json_in, L"\n\r\t", L' ');
 
+		    // lazy mode keeps the text alive for the deferred containers instead of building them now
+		    axz_json_source lazy_source;
+		    if( lazy )
+		    {
+			    lazy_source = std::make_shared<const axz_wstring>( std::move( json_in ) );
+		    }
+		    const axz_wstring & str = lazy ? *lazy_source : json_in;
+
 		    // pass to recursive creator
 		    std::size_t pos = 0;
-		    axz_int rc = AxzJsonBuilder::_build( json_in, pos, json_value );
+		    axz_int rc = AxzJsonBuilder::_build( str, pos, json_value, lazy_source );
 		    if( AXZ_FAILED( rc ) )
 		    {
 			    // if failed, clear values
@@ -352,10 +612,10 @@ namespace Internal
 		    else
 		    {
 			    // clear any left behind trailing whitespace
-			    AxzJsonBuilder::_ignoreWhiteSpace( json_in, pos );
+			    AxzJsonBuilder::_ignoreWhiteSpace( str, pos );
 		    }
 		    // check for any additional trailing content
-		    if( pos < json_in.length() )
+		    if( pos < str.length() )
 		    {
 			    json_value.clear();
 			    //return WAAPI_LOG_RET( WAAPI_ERROR_INVALID_JSON, L"JSON trailing content cannot guarantee accuracy of intended JSON" );
@@ -365,7 +625,7 @@ namespace Internal
 		    return AXZ_OK;
 	    }
 
-	    axz_rc _build( const axz_wstring & str, size_t & pos, AxzDict & json_value )
+	    axz_rc _build( const axz_wstring & str, size_t & pos, AxzDict & json_value, const axz_json_source & lazy_source )
 	    {
 		    // ignore all white space and non-ascii we dislike
 		    AxzJsonBuilder::_ignoreWhiteSpace( str, pos );
@@ -379,13 +639,25 @@ namespace Internal
 		    // holder for converting strings
 		    axz_wstring json_string;
 
+		    // lazy mode: only find the end of the container and remember where it starts
+		    if( lazy_source && ( str[ pos ] == L'{' || str[ pos ] == L'[' ) )
+		    {
+			    size_t offset = pos;
+			    axz_rc rc = AxzJsonBuilder::_skipContainer( str, pos );
+			    if( AXZ_SUCCESS( rc ) )
+			    {
+				    json_value = AxzDict::lazy( ( str[ offset ] == L'{' ) ? AxzDictType::OBJECT : AxzDictType::ARRAY, lazy_source, offset, &AxzJsonBuilder::_buildDeferred );
+			    }
+			    return rc;
+		    }
+
 		    switch( str[ pos ] )
 		    {
 		    case L'{' :
 			    //return WAAPI_LOG_FUNC_RET( _buildObject( str, ++pos, json_value ) );
-			    return AxzJsonBuilder::_buildObject( str, ++pos, json_value );
+			    return AxzJsonBuilder::_buildObject( str, ++pos, json_value, lazy_source );
 		    case L'[':
-			    return AxzJsonBuilder::_buildArray( str, ++pos, json_value );
+			    return AxzJsonBuilder::_buildArray( str, ++pos, json_value, lazy_source );
 		    case L'"':
 			    if( AXZ_FAILED( AxzJsonBuilder::_buildString( str, ++pos, json_string ) ) )
 			    {
@@ -415,7 +687,52 @@ namespace Internal
 		    }
 	    }
 
-	    axz_rc _buildObject( const axz_wstring & str, size_t & pos, AxzDict & json_object )
+	    axz_rc _buildDeferred( const axz_json_source & source, size_t offset, AxzDict & json_value )
+	    {
+		    // build one level only - nested containers stay deferred
+		    const axz_wstring & str = *source;
+		    size_t pos = offset + 1;
+		    if( str[ offset ] == L'{' )
+		    {
+			    return AxzJsonBuilder::_buildObject( str, pos, json_value, source );
+		    }
+		    return AxzJsonBuilder::_buildArray( str, pos, json_value, source );
+	    }
+
+	    axz_rc _skipContainer( const axz_wstring & str, size_t & pos )
+	    {
+		    // bracket matching only - the content is validated when the container gets built
+		    size_t depth = 0;
+		    const size_t length = str.length();
+		    while( pos < length )
+		    {
+			    const axz_wchar c = str[ pos++ ];
+			    if( c == L'"' )
+			    {
+				    while( pos < length )
+				    {
+					    pos += AxzSimd::findJsonSpecial( str.data() + pos, length - pos );
+					    if( pos >= length || str[ pos ] == L'"' )
+					    {
+						    break;
+					    }
+					    pos += ( str[ pos ] == L'\\' ) ? 2 : 1;
+				    }
+				    ++pos;
+			    }
+			    else if( c == L'{' || c == L'[' )
+			    {
+				    ++depth;
+			    }
+			    else if( ( c == L'}' || c == L']' ) && --depth == 0 )
+			    {
+				    return AXZ_OK;
+			    }
+		    }
+		    return AXZ_ERROR_INVALID_INPUT;
+	    }
+
+	    axz_rc _buildObject( const axz_wstring & str, size_t & pos, AxzDict & json_object, const axz_json_source & lazy_source )
 	    {
 		    // make the passed in value an empty object
 		    json_object.become( AxzDictType::OBJECT );
@@ -462,7 +779,7 @@ namespace Internal
 			    ++pos;
 
 			    // retrieve the value for the map key
-			    if( AXZ_FAILED( AxzJsonBuilder::_build( str, pos, json_value ) ) )
+			    if( AXZ_FAILED( AxzJsonBuilder::_build( str, pos, json_value, lazy_source ) ) )
 			    {
 				    return AXZ_ERROR_INVALID_INPUT;
 			    }
@@ -491,9 +808,19 @@ namespace Internal
 
 	    axz_rc _buildString( const axz_wstring & str, size_t & pos, axz_wstring & json_string )
 	    {
-		    json_string = L"";
-		    do 
+		    json_string.clear();
+		    const size_t length = str.length();
+		    while( pos < length )
 		    {
+			    // copy the plain run up to the next quote, backslash or control character at once
+			    const size_t run = AxzSimd::findJsonSpecial( str.data() + pos, length - pos );
+			    json_string.append( str, pos, run );
+			    pos += run;
+			    if( pos == length )
+			    {
+				    break;
+			    }
+
 			    // we found the end of the string
 			    if( str[ pos ] == L'"' )
 			    {
@@ -537,16 +864,11 @@ namespace Internal
 				    json_string += next;
 				    pos++;
 			    }
-			    else if( str[pos ] < 0x20 ) // un-escaped character! means invalid JSON string
+			    else // un-escaped control character! means invalid JSON string
 			    {
 				    return AXZ_ERROR_INVALID_INPUT;
 			    }
-			    else
-			    {
-				    json_string += str[ pos++ ];
-			    }
-		    } 
-		    while ( pos != axz_wstring::npos );
+		    }
 
 		    // failed to find the end of the string, therefore invalid JSON
 		    return AXZ_ERROR_INVALID_INPUT;
@@ -638,7 +960,7 @@ namespace Internal
 		    return AXZ_OK;
 	    }
 
-	    axz_rc _buildArray( const axz_wstring & str, size_t & pos, AxzDict& json_array )
+	    axz_rc _buildArray( const axz_wstring & str, size_t & pos, AxzDict& json_array, const axz_json_source & lazy_source )
 	    {
 		    // convert to empty array
 		    json_array.become( AxzDictType::ARRAY );		
@@ -655,7 +977,7 @@ namespace Internal
 
 			    // convert JSON value held by array
 			    AxzDict json_value;
-			    if( AXZ_FAILED( AxzJsonBuilder::_build( str, pos, json_value ) ) )
+			    if( AXZ_FAILED( AxzJsonBuilder::_build( str, pos, json_value, lazy_source ) ) )
 			    {
 				    return AXZ_ERROR_INVALID_INPUT;
 			    }
@@ -740,7 +1062,7 @@ namespace Internal
 			    || str[ pos ] == L'e'
 			    || str[ pos ] == L'E' )
 		    {
-			    // complex numbers need to be tracked and will be returned as string values
+			    // fractions and exponents never fit the int32 path
 			    if( str[ pos ] == L'.'
 				    || str[ pos ] == L'e'
 				    || str[ pos ] == L'E'  )
@@ -804,7 +1126,16 @@ namespace Internal
 		    }
 
 		    if( isValidInt )
+		    {
 			    json_number = ( int32_t )std::stoll( tmp );
+			    return AXZ_OK;
+		    }
+
+		    // fractions, exponents and integers past int32 are doubles; anything malformed stays text
+		    wchar_t* end = nullptr;
+		    const double number = std::wcstod( tmp.c_str(), &end );
+		    if( end && *end == L'\0' )
+			    json_number = number;
 		    else
 			    json_number = tmp.c_str();
 
@@ -3,11 +3,34 @@
 
 #include "axz_export.h"
 #include "axz_dict.h"
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+// receives serialized UTF-8 piece by piece; a failed rc stops the serialization and is passed back to the caller
+using axz_json_sink = std::function<axz_rc( const char* data, size_t size )>;
 
 namespace AxzJson
 {
 	AXZDICT_DECLSPEC axz_rc serialize( const AxzDict& in_dict, axz_wstring& out_json, bool in_nice_format = false );
-	AXZDICT_DECLSPEC axz_rc deserialize( const axz_wstring& in_json, AxzDict& out_dict );
+	// UTF-8 straight from the dictionary, no intermediate wide string. in_use_cache (compact format only): reuse
+	// the text of containers unchanged since the last cached call and keep the text of the rest, see AxzDict::jsonCache
+	AXZDICT_DECLSPEC axz_rc serialize( const AxzDict& in_dict, std::string& out_json, bool in_nice_format = false, bool in_use_cache = false );
+	// the sink never gets more than in_chunk_size bytes per call (at least 4 KiB), so memory stays bounded for any document size
+	AXZDICT_DECLSPEC axz_rc serialize( const AxzDict& in_dict, const axz_json_sink& in_sink, bool in_nice_format = false, size_t in_chunk_size = 64 * 1024 );
+	// in_lazy: nested objects and arrays are only bracket-matched here and get parsed on first access,
+	// so syntax errors inside them throw AxzDictDeferredError from that access instead of failing here
+	AXZDICT_DECLSPEC axz_rc deserialize( const axz_wstring& in_json, AxzDict& out_dict, bool in_lazy = false );
+	// takes over the buffer: in lazy mode it becomes the text the deferred containers are parsed from, without a copy
+	AXZDICT_DECLSPEC axz_rc deserialize( axz_wstring&& in_json, AxzDict& out_dict, bool in_lazy = false );
+
+	// sink writing to a stream; fails with AXZ_ERROR_INVALID_OUTPUT once the stream goes bad
+	AXZDICT_DECLSPEC axz_json_sink streamSink( std::ostream& out_stream );
+
+	// conversions append to the output. wchar_t is UTF-32 (UTF-16 on windows); unpaired surrogates, code points
+	// outside unicode and malformed UTF-8 sequences become U+FFFD
+	AXZDICT_DECLSPEC void toUtf8( const wchar_t* in_data, size_t in_size, std::string& out_utf8 );
+	AXZDICT_DECLSPEC void fromUtf8( const char* in_data, size_t in_size, axz_wstring& out_wide );
 };
 
 #endif
@@ -0,0 +1,155 @@
+#include "axz_simd.h"
+#include <atomic>
+#include <cstring>
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#include <immintrin.h>
+#define AXZ_SIMD_DISPATCH 1
+#endif
+
+namespace
+{
+	using find_kernel = size_t (*)( const wchar_t*, size_t ) noexcept;
+
+	size_t _findJsonSpecialScalar( const wchar_t* data, size_t len ) noexcept
+	{
+		for( size_t i = 0; i < len; ++i )
+		{
+			const wchar_t c = data[ i ];
+			if( c < 0x20 || c == L'"' || c == L'\\' )
+			{
+				return i;
+			}
+		}
+		return len;
+	}
+
+#if AXZ_SIMD_DISPATCH
+	// 32-bit lanes: wchar_t is a signed 32-bit code unit here, so the signed compare matches "c < 0x20"
+	__attribute__(( target( "sse2" ) ))
+	size_t _findJsonSpecialSse2( const wchar_t* data, size_t len ) noexcept
+	{
+		const __m128i quote = _mm_set1_epi32( L'"' );
+		const __m128i backslash = _mm_set1_epi32( L'\\' );
+		const __m128i space = _mm_set1_epi32( 0x20 );
+		size_t i = 0;
+		for( ; i + 4 <= len; i += 4 )
+		{
+			const __m128i chunk = _mm_loadu_si128( reinterpret_cast<const __m128i*>( data + i ) );
+			const __m128i hit = _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi32( chunk, quote ), _mm_cmpeq_epi32( chunk, backslash ) ),
+											  _mm_cmplt_epi32( chunk, space ) );
+			if( const int mask = _mm_movemask_epi8( hit ) )
+			{
+				return i + __builtin_ctz( mask ) / 4;
+			}
+		}
+		return i + _findJsonSpecialScalar( data + i, len - i );
+	}
+
+	__attribute__(( target( "avx2" ) ))
+	size_t _findJsonSpecialAvx2( const wchar_t* data, size_t len ) noexcept
+	{
+		const __m256i quote = _mm256_set1_epi32( L'"' );
+		const __m256i backslash = _mm256_set1_epi32( L'\\' );
+		const __m256i space = _mm256_set1_epi32( 0x20 );
+		size_t i = 0;
+		for( ; i + 8 <= len; i += 8 )
+		{
+			const __m256i chunk = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( data + i ) );
+			const __m256i hit = _mm256_or_si256( _mm256_or_si256( _mm256_cmpeq_epi32( chunk, quote ), _mm256_cmpeq_epi32( chunk, backslash ) ),
+												 _mm256_cmpgt_epi32( space, chunk ) );
+			if( const uint32_t mask = _mm256_movemask_epi8( hit ) )
+			{
+				return i + __builtin_ctz( mask ) / 4;
+			}
+		}
+		return i + _findJsonSpecialSse2( data + i, len - i );
+	}
+
+	__attribute__(( target( "avx512f" ) ))
+	size_t _findJsonSpecialAvx512( const wchar_t* data, size_t len ) noexcept
+	{
+		const __m512i quote = _mm512_set1_epi32( L'"' );
+		const __m512i backslash = _mm512_set1_epi32( L'\\' );
+		const __m512i space = _mm512_set1_epi32( 0x20 );
+		size_t i = 0;
+		for( ; i + 16 <= len; i += 16 )
+		{
+			const __m512i chunk = _mm512_loadu_si512( data + i );
+			const __mmask16 mask = _mm512_cmpeq_epi32_mask( chunk, quote ) | _mm512_cmpeq_epi32_mask( chunk, backslash ) |
+								   _mm512_cmplt_epi32_mask( chunk, space );
+			if( mask )
+			{
+				return i + __builtin_ctz( mask );
+			}
+		}
+		return i + _findJsonSpecialAvx2( data + i, len - i );
+	}
+#endif
+
+	struct _AxzIsa
+	{
+		const char* name;
+		find_kernel find_json_special;
+		bool supported;
+	};
+
+	const _AxzIsa* _isaTable( size_t& count )
+	{
+		static const _AxzIsa table[] = {
+#if AXZ_SIMD_DISPATCH
+			{ "avx512", _findJsonSpecialAvx512, sizeof( wchar_t ) == 4 && ( __builtin_cpu_init(), __builtin_cpu_supports( "avx512f" ) ) },
+			{ "avx2",   _findJsonSpecialAvx2,   sizeof( wchar_t ) == 4 && __builtin_cpu_supports( "avx2" ) },
+			{ "sse2",   _findJsonSpecialSse2,   sizeof( wchar_t ) == 4 && __builtin_cpu_supports( "sse2" ) },
+#endif
+			{ "scalar", _findJsonSpecialScalar, true },
+		};
+		count = sizeof( table ) / sizeof( table[ 0 ] );
+		return table;
+	}
+
+	// widest supported entry first; only selectIsa() ever moves it
+	std::atomic<const _AxzIsa*>& _selected()
+	{
+		static std::atomic<const _AxzIsa*> selected{ []()
+		{
+			size_t count = 0;
+			const _AxzIsa* table = _isaTable( count );
+			size_t i = 0;
+			while( !table[ i ].supported )
+			{
+				++i;
+			}
+			return &table[ i ];
+		}() };
+		return selected;
+	}
+}
+
+namespace AxzSimd
+{
+	const char* isa()
+	{
+		return _selected().load( std::memory_order_relaxed )->name;
+	}
+
+	bool selectIsa( const char* name )
+	{
+		size_t count = 0;
+		const _AxzIsa* table = _isaTable( count );
+		for( size_t i = 0; i < count; ++i )
+		{
+			if( std::strcmp( table[ i ].name, name ) == 0 && table[ i ].supported )
+			{
+				_selected().store( &table[ i ], std::memory_order_relaxed );
+				return true;
+			}
+		}
+		return false;
+	}
+
+	size_t findJsonSpecial( const wchar_t* data, size_t len ) noexcept
+	{
+		return _selected().load( std::memory_order_relaxed )->find_json_special( data, len );
+	}
+};
@@ -0,0 +1,22 @@
+#ifndef __axz_simd__
+#define __axz_simd__
+
+#include "axz_types.h"
+#include "axz_export.h"
+
+// Wide-character scanning kernels for JSON text. Every kernel is compiled for SSE2, AVX2 and AVX-512
+// whatever -march the library is built with; the widest variant the running CPU supports is selected
+// on first use, so one binary runs everywhere.
+namespace AxzSimd
+{
+	// instruction set in use: "avx512", "avx2", "sse2" or "scalar"
+	AXZDICT_DECLSPEC const char* isa();
+
+	// forces one instruction set (tests, benchmarks); false when the build or the CPU lacks it
+	AXZDICT_DECLSPEC bool selectIsa( const char* name );
+
+	// index of the first character a JSON string cannot hold verbatim ('"', '\\' or below 0x20), or len
+	AXZDICT_DECLSPEC size_t findJsonSpecial( const wchar_t* data, size_t len ) noexcept;
+};
+
+#endif
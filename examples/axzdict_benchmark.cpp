@@ -0,0 +1,430 @@
+// AXZDICT BENCHMARK
+// Measures the AxzDict data structure itself: value layout, heap footprint and iteration
+
+#include "axz_dict.h"
+#include "axz_json.h"
+#include "axz_error_codes.h"
+#include "axz_simd.h"
+#include "axz_dict_stepper.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Heap bytes in use, read from the allocator rather than by replacing operator new. This is the real
+// footprint, allocator bookkeeping included, and it also covers allocations made inside libaxzdct.
+struct HeapSnapshot {
+    size_t bytes = heap_in_use();
+
+    static size_t heap_in_use() {
+#if defined(__GLIBC__)
+        const struct mallinfo2 info = mallinfo2();
+        return info.uordblks + info.hblkhd;     // small-block arena plus mmapped chunks
+#else
+        return 0;                               // not reported on this C library
+#endif
+    }
+};
+
+template<typename Func>
+long long time_us(Func&& func) {
+    auto t1 = std::chrono::high_resolution_clock::now();
+    func();
+    auto t2 = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+}
+
+void benchmark_numeric_arrays(size_t count) {
+    std::cout << "\n🏃 Numeric array layout (" << count << " elements):\n";
+    std::cout << std::string(50, '-') << "\n";
+    std::cout << "sizeof(AxzDict): " << sizeof(AxzDict) << " bytes\n";
+
+    for (int pass = 0; pass < 2; ++pass) {
+        const bool doubles = (pass == 1);
+        AxzDict array(AxzDictType::ARRAY);
+        array.reserve(count);
+
+        HeapSnapshot before;
+        auto build_us = time_us([&]() {
+            for (size_t i = 0; i < count; ++i) {
+                if (doubles) {
+                    array.add(AxzDict(static_cast<double>(i) * 0.5));
+                } else {
+                    array.add(AxzDict(static_cast<int32_t>(i)));
+                }
+            }
+        });
+        HeapSnapshot after;
+
+        double sum = 0;
+        auto iterate_us = time_us([&]() {
+            for (const auto& value : array) {
+                sum += value.numberVal();
+            }
+        });
+
+        const char* label = doubles ? "double" : "int32";
+        std::cout << "Build " << label << " array: " << build_us << " μs, "
+                  << std::fixed << std::setprecision(1)
+                  << static_cast<double>(after.bytes - before.bytes) / count << " heap bytes/element\n";
+        std::cout << "Iterate " << label << " array: " << iterate_us << " μs (sum " << std::setprecision(0) << sum << ")\n";
+    }
+}
+
+void benchmark_repeated_schema(size_t records) {
+    std::cout << "\n🏃 Repeated-schema objects (" << records << " records x 12 keys):\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    const std::vector<axz_wstring> keys = {
+        L"identifier", L"timestamp", L"temperature", L"humidity", L"pressure", L"latitude",
+        L"longitude", L"altitude", L"battery", L"signal", L"firmware", L"status"
+    };
+
+    AxzDict array(AxzDictType::ARRAY);
+    array.reserve(records);
+
+    HeapSnapshot before;
+    auto build_us = time_us([&]() {
+        for (size_t i = 0; i < records; ++i) {
+            AxzDict record(AxzDictType::OBJECT);
+            record.reserve(keys.size());
+            for (size_t k = 0; k < keys.size(); ++k) {
+                record.add(keys[k], AxzDict(static_cast<int32_t>(i + k)));
+            }
+            array.add(std::move(record));
+        }
+    });
+    HeapSnapshot after;
+
+    long long sum = 0;
+    auto lookup_us = time_us([&]() {
+        for (const auto& record : array) {
+            for (const auto& key : keys) {
+                int32_t value = 0;
+                if (AXZ_SUCCESS(record.val(key, value))) {
+                    sum += value;
+                }
+            }
+        }
+    });
+
+    std::cout << "Build: " << build_us << " μs, "
+              << std::fixed << std::setprecision(1)
+              << static_cast<double>(after.bytes - before.bytes) / records << " heap bytes/record\n";
+    std::cout << "Lookup all keys: " << lookup_us << " μs (sum " << sum << ")\n";
+}
+
+void benchmark_small_objects(size_t rounds) {
+    std::cout << "\n🏃 Small-object lookup and iteration (" << rounds << " rounds):\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    std::vector<axz_wstring> keys;
+    for (int i = 0; i < 16; ++i) {
+        keys.push_back((i < 10 ? L"field_0" : L"field_") + std::to_wstring(i));
+    }
+
+    for (size_t count : {1, 2, 4, 8, 12, 16}) {
+        AxzDict object(AxzDictType::OBJECT);
+        for (size_t k = 0; k < count; ++k) {
+            object.set(keys[k], AxzDict(static_cast<int32_t>(k)));
+        }
+        const AxzDict& view = object;
+
+        long long sum = 0;
+        auto lookup_us = time_us([&]() {
+            for (size_t r = 0; r < rounds; ++r) {
+                for (size_t k = 0; k < count; ++k) {
+                    int32_t value = 0;
+                    if (AXZ_SUCCESS(view.val(keys[k], value))) {
+                        sum += value;
+                    }
+                }
+            }
+        });
+        auto iterate_us = time_us([&]() {
+            for (size_t r = 0; r < rounds; ++r) {
+                for (const auto& value : view) {
+                    sum += value.intVal();
+                }
+            }
+        });
+
+        const double operations = static_cast<double>(rounds * count);
+        std::cout << std::setw(2) << count << " keys: lookup "
+                  << std::fixed << std::setprecision(1) << lookup_us * 1000.0 / operations << " ns/key, iterate "
+                  << iterate_us * 1000.0 / operations << " ns/value (sum " << sum << ")\n";
+    }
+}
+
+// Reference: the FNV-1a loop the key tables used before (one multiply per character)
+static uint64_t fnv1a_reference(const wchar_t* data, size_t len) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<uint64_t>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template<typename Hash>
+void report_hash_quality(const char* name, Hash&& hash, const std::vector<axz_wstring>& keys) {
+    // Bucket spread of the low bits (what a power-of-two table sees): chi-square / buckets ~ 1.0 is uniform
+    constexpr size_t BUCKETS = 1 << 12;
+    std::vector<size_t> counts(BUCKETS, 0);
+    std::unordered_set<uint64_t> distinct;
+    for (const auto& key : keys) {
+        const uint64_t h = hash(key.data(), key.size());
+        ++counts[h & (BUCKETS - 1)];
+        distinct.insert(h);
+    }
+    const double expected = static_cast<double>(keys.size()) / BUCKETS;
+    double chi_square = 0;
+    for (size_t count : counts) {
+        chi_square += (count - expected) * (count - expected) / expected;
+    }
+
+    // Avalanche: flipping one input bit should flip ~32 of the 64 output bits
+    double flipped = 0;
+    size_t trials = 0;
+    for (size_t k = 0; k < keys.size(); k += 97) {
+        axz_wstring key = keys[k];
+        const uint64_t base = hash(key.data(), key.size());
+        for (size_t bit = 0; bit < 8; ++bit) {
+            key[0] ^= static_cast<wchar_t>(1u << bit);
+            flipped += __builtin_popcountll(base ^ hash(key.data(), key.size()));
+            key[0] ^= static_cast<wchar_t>(1u << bit);
+            ++trials;
+        }
+    }
+
+    std::cout << std::setw(10) << name << ": " << (keys.size() - distinct.size()) << " 64-bit collisions, "
+              << std::fixed << std::setprecision(2) << "bucket chi2/n " << chi_square / BUCKETS
+              << ", avalanche " << flipped / trials << "/64 bits\n";
+}
+
+void benchmark_key_hash(size_t rounds) {
+    std::cout << "\n🏃 Key hash quality and throughput:\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    // Sequential keys differ only in their last characters - the weak spot of per-character hashes
+    std::vector<axz_wstring> keys;
+    for (size_t i = 0; i < 200000; ++i) {
+        keys.push_back(L"sensor_" + std::to_wstring(i));
+    }
+    report_hash_quality("seeded", [](const wchar_t* data, size_t len) {
+        return static_cast<uint64_t>(axz_hash_internal::hash_wstring(data, len));
+    }, keys);
+    report_hash_quality("fnv1a", fnv1a_reference, keys);
+
+    for (size_t length : {4, 8, 16, 32, 64, 256}) {
+        const axz_wstring key(length, L'k');
+        uint64_t sink = 0;
+        auto seeded_us = time_us([&]() {
+            for (size_t r = 0; r < rounds; ++r) {
+                sink += axz_hash_internal::hash_wstring(key.data(), key.size(), r);
+            }
+        });
+        auto fnv_us = time_us([&]() {
+            for (size_t r = 0; r < rounds; ++r) {
+                sink += fnv1a_reference(key.data(), key.size()) ^ r;
+            }
+        });
+        std::cout << std::setw(3) << length << " chars: seeded " << std::fixed << std::setprecision(2)
+                  << seeded_us * 1000.0 / rounds << " ns, fnv1a " << fnv_us * 1000.0 / rounds
+                  << " ns (sink " << (sink & 0xff) << ")\n";
+    }
+}
+
+void benchmark_string_scan(size_t rounds) {
+    std::cout << "\n🏃 JSON string scan per instruction set (" << rounds << " documents):\n";
+    std::cout << std::string(50, '-') << "\n";
+    std::cout << "Selected at startup: " << AxzSimd::isa() << "\n";
+
+    // Mostly plain text with the occasional escape - typical log/message payloads
+    AxzDict document(AxzDictType::ARRAY);
+    for (int i = 0; i < 64; ++i) {
+        axz_wstring text(200, L'x');
+        text[i + 50] = L'"';
+        document.add(AxzDict(text.c_str()));
+    }
+    axz_wstring json;
+    AxzJson::serialize(document, json);
+
+    const std::string selected = AxzSimd::isa();
+    for (const char* isa : {"scalar", "sse2", "avx2", "avx512"}) {
+        if (!AxzSimd::selectIsa(isa)) continue;
+        size_t bytes = 0;
+        auto serialize_us = time_us([&]() {
+            for (size_t r = 0; r < rounds; ++r) {
+                axz_wstring out;
+                AxzJson::serialize(document, out);
+                bytes += out.size();
+            }
+        });
+        auto parse_us = time_us([&]() {
+            for (size_t r = 0; r < rounds; ++r) {
+                AxzDict parsed;
+                AxzJson::deserialize(json, parsed);
+            }
+        });
+        std::cout << std::setw(7) << isa << ": serialize " << serialize_us << " μs, parse " << parse_us
+                  << " μs (" << bytes / rounds << " chars/document)\n";
+    }
+    AxzSimd::selectIsa(selected.c_str());
+}
+
+// The stepper-based serializer AxzJson used before the direct writer, kept here as the baseline
+class LegacyJsonStepper : public AxzDictStepper {
+public:
+    axz_wstring json;
+
+    axz_rc step(std::nullptr_t) override { json += L"null"; return AXZ_OK; }
+    axz_rc step(const bool val) override { json += (val ? L"true" : L"false"); return AXZ_OK; }
+    axz_rc step(const int32_t val) override { json += std::to_wstring(static_cast<long>(val)); return AXZ_OK; }
+    axz_rc step(const double val) override { json += std::to_wstring(val); return AXZ_OK; }
+    axz_rc step(const axz_wstring& val) override { json += L"\"" + encode(val) + L"\""; return AXZ_OK; }
+    axz_rc step(const axz_bytes&) override { json += L"\"not supported\""; return AXZ_OK; }
+
+    axz_rc step(const axz_dict_array& vals) override {
+        json += L"[";
+        bool first = true;
+        for (const auto& item : vals) {
+            if (!first) json += L", ";
+            item.step(shared_from_this());
+            first = false;
+        }
+        json += L"]";
+        return AXZ_OK;
+    }
+
+    axz_rc step(const axz_dict_object& vals) override {
+        json += L"{";
+        bool first = true;
+        for (const auto& kv : vals) {
+            if (!first) json += L", ";
+            json += L"\"" + encode(kv.first) + L"\": ";
+            kv.second.step(shared_from_this());
+            first = false;
+        }
+        json += L"}";
+        return AXZ_OK;
+    }
+
+private:
+    static axz_wstring encode(const axz_wstring& text) {
+        axz_wstring out;
+        for (wchar_t c : text) {
+            if (c == L'"' || c == L'\\') out += L'\\';
+            out += c;
+        }
+        return out;
+    }
+};
+
+void benchmark_serializer(size_t records) {
+    std::cout << "\n🏃 JSON serializer (" << records << " records):\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    AxzDict document(AxzDictType::ARRAY);
+    for (size_t i = 0; i < records; ++i) {
+        AxzDict record(AxzDictType::OBJECT);
+        record.set(L"id", AxzDict(static_cast<int32_t>(i)));
+        record.set(L"name", AxzDict((L"device-" + std::to_wstring(i)).c_str()));
+        record.set(L"temperature", AxzDict(20.0 + static_cast<double>(i % 100) / 7.0));
+        record.set(L"active", AxzDict(i % 2 == 0));
+        record.set(L"note", AxzDict(L"status \"ok\" after reboot"));
+        document.add(std::move(record));
+    }
+
+    size_t legacy_chars = 0, writer_chars = 0;
+    auto legacy_us = time_us([&]() {
+        auto stepper = std::make_shared<LegacyJsonStepper>();
+        document.step(stepper);
+        legacy_chars = stepper->json.size();
+    });
+    auto writer_us = time_us([&]() {
+        axz_wstring json;
+        AxzJson::serialize(document, json);
+        writer_chars = json.size();
+    });
+
+    // what json_adapter::dump used to do: wide text first, then narrowed into a std::string
+    size_t utf8_bytes = 0;
+    auto narrowed_us = time_us([&]() {
+        axz_wstring json;
+        AxzJson::serialize(document, json);
+        std::string narrowed;
+        AxzJson::toUtf8(json.data(), json.size(), narrowed);
+        utf8_bytes = narrowed.size();
+    });
+    auto utf8_us = time_us([&]() {
+        std::string json;
+        AxzJson::serialize(document, json);
+        utf8_bytes = json.size();
+    });
+    size_t peak_chunk = 0;
+    auto sink_us = time_us([&]() {
+        AxzJson::serialize(document, [&](const char*, size_t size) -> axz_rc {
+            peak_chunk = std::max(peak_chunk, size);
+            return AXZ_OK;
+        });
+    });
+
+    std::cout << "Legacy stepper: " << legacy_us << " μs (" << legacy_chars << " chars, 6-digit doubles)\n";
+    std::cout << "Direct writer:  " << writer_us << " μs (" << writer_chars << " chars, round-trip doubles)\n";
+    std::cout << "Wide + narrow:  " << narrowed_us << " μs\n";
+    std::cout << "UTF-8 writer:   " << utf8_us << " μs (" << utf8_bytes << " bytes)\n";
+    std::cout << "UTF-8 sink:     " << sink_us << " μs (largest chunk " << peak_chunk << " bytes)\n";
+}
+
+void benchmark_serialization_cache(size_t records) {
+    std::cout << "\n🏃 Cached re-serialization after one change (" << records << " records):\n";
+    std::cout << std::string(50, '-') << "\n";
+
+    AxzDict document(AxzDictType::OBJECT);
+    for (size_t group = 0; group < 100; ++group) {
+        AxzDict items(AxzDictType::ARRAY);
+        for (size_t i = 0; i < records / 100; ++i) {
+            AxzDict record(AxzDictType::OBJECT);
+            record.set(L"id", AxzDict(static_cast<int32_t>(i)));
+            record.set(L"temperature", AxzDict(20.0 + static_cast<double>(i % 100) / 7.0));
+            record.set(L"name", AxzDict((L"device-" + std::to_wstring(i)).c_str()));
+            items.add(std::move(record));
+        }
+        document.set(L"group" + std::to_wstring(group), items);
+    }
+
+    std::string json;
+    auto full_us = time_us([&]() { AxzJson::serialize(document, json); });
+    auto first_us = time_us([&]() { AxzJson::serialize(document, json, false, true); });
+    AxzDict changed = std::as_const(document)[L"group42"][7];     // shares the record; set() drops its path
+    changed.set(L"temperature", AxzDict(99.5));
+    auto again_us = time_us([&]() { AxzJson::serialize(document, json, false, true); });
+
+    std::cout << "Uncached:            " << full_us << " μs (" << json.size() << " bytes)\n";
+    std::cout << "Cached, first call:  " << first_us << " μs\n";
+    std::cout << "Cached, one change:  " << again_us << " μs\n";
+}
+
+int main() {
+    std::cout << "AXZDICT - DATA STRUCTURE BENCHMARK\n";
+    std::cout << "==================================\n";
+
+    benchmark_numeric_arrays(1000000);
+    benchmark_repeated_schema(100000);
+    benchmark_small_objects(200000);
+    benchmark_key_hash(2000000);
+    benchmark_string_scan(2000);
+    benchmark_serializer(100000);
+    benchmark_serialization_cache(100000);
+
+    return 0;
+}
@@ -0,0 +1,4 @@
+// Adds plain AxzDict to multi_backend_demo next to the configured backend. CMake compiles this file
+// with JSON_ADAPTER_BACKEND=5 and links it into simdjson builds, whose tree is AxzDict already.
+
+#include "any_observable_json_backend.h"
@@ -2,6 +2,7 @@
 // Demonstrates Universal Observable JSON with all supported backends
 
 #include "../include/universal_observable_json.h"
+#include "../include/any_observable_json_backend.h"
 #include <iostream>
 #include <chrono>
 
@@ -64,9 +65,19 @@ int main() {
     // Backend comparison
     std::cout << "\nBackend Comparison:\n";
     std::cout << "  Build with different backends:\n";
-    std::cout << "    nlohmann/json: cmake -DUSE_JSON11=OFF -DUSE_RAPIDJSON=OFF ..\n";
-    std::cout << "    json11:       cmake -DUSE_JSON11=ON ..\n";
-    std::cout << "    RapidJSON:    cmake -DUSE_RAPIDJSON=ON ..\n";
+    std::cout << "    nlohmann/json:    cmake ..\n";
+    std::cout << "    JsonCpp:          cmake -DUSE_JSONCPP=ON ..\n";
+    std::cout << "    AxzDict:          cmake -DUSE_AXZDICT=ON ..\n";
+    std::cout << "    simdjson+AxzDict: cmake -DUSE_SIMDJSON=ON ..\n";
+    
+    // Backends side by side: every source file built with another JSON_ADAPTER_BACKEND adds one
+    std::cout << "\nBackends linked into this program:\n";
+    for (const auto& backend : any_observable_backends()) {
+        AnyObservablePtr doc = make_any_observable(backend, R"({"name":"Universal JSON"})");
+        doc->set("backend", backend);
+        doc->set("members", static_cast<int>(doc->size()) + 1);
+        std::cout << "  " << doc->dump() << "\n";
+    }
     
     // Cleanup
     obs.unsubscribe(sub);
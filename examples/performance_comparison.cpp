@@ -2,9 +2,12 @@
 // Compares performance between different JSON backends
 
 #include "../include/universal_observable_json.h"
+#include "../include/mapped_observable_json.h"
+#include "../include/any_observable_json_backend.h"
 #include <chrono>
 #include <iostream>
 #include <iomanip>
+#include <filesystem>
 
 using namespace universal_observable_json;
 
@@ -98,6 +101,268 @@ void benchmark_operations(const std::string& backend_name, int iterations = 1000
         obs.unsubscribe(subscription);
     }
     
+    // Test 6: Restart from a binary snapshot vs re-parsing text
+    {
+        json doc = json_adapter::make_object();
+        for (int i = 0; i < iterations * 10; ++i) {
+            json item = json_adapter::make_object();
+            json_adapter::set_member(item, "id", json_adapter::make_int(i));
+            json_adapter::set_member(item, "name", json_adapter::make_string("item_" + std::to_string(i)));
+            json_adapter::set_member(item, "score", json_adapter::make_double(i * 0.25));
+            json_adapter::set_member(doc, "key" + std::to_string(i), item);
+        }
+        const std::string text = json_adapter::dump(doc);
+        const auto file = (std::filesystem::temp_directory_path() / "performance_comparison.snapshot").string();
+        json_adapter::write_snapshot(doc, file);
+        
+        auto t1 = std::chrono::high_resolution_clock::now();
+        json parsed = json_adapter::parse(text);
+        auto t2 = std::chrono::high_resolution_clock::now();
+        json_adapter::SnapshotReader reader(file);
+        bool found = reader.has("key" + std::to_string(iterations) + "/name");
+        auto t3 = std::chrono::high_resolution_clock::now();
+        json materialized = reader.materialize();
+        auto t4 = std::chrono::high_resolution_clock::now();
+        std::filesystem::remove(file);
+        
+        using std::chrono::duration_cast;
+        using std::chrono::microseconds;
+        std::cout << "Restart by parse: " << duration_cast<microseconds>(t2 - t1).count() << " μs (" << text.size() << " bytes)\n";
+        std::cout << "Restart by snapshot, first lookup: " << duration_cast<microseconds>(t3 - t2).count() << " μs ("
+                  << reader.file_size() << " bytes, found=" << found << ")\n";
+        std::cout << "Snapshot full materialization: " << duration_cast<microseconds>(t4 - t3).count() << " μs\n";
+        (void)parsed;
+        (void)materialized;
+    }
+    
+    // Test 7: Text JSON vs MessagePack vs CBOR (size, encode and decode throughput)
+    {
+        json doc = json_adapter::make_array();
+        for (int i = 0; i < iterations; ++i) {
+            json item = json_adapter::make_object();
+            json_adapter::set_member(item, "id", json_adapter::make_int(i));
+            json_adapter::set_member(item, "name", json_adapter::make_string("item \"" + std::to_string(i) + "\""));
+            json_adapter::set_member(item, "score", json_adapter::make_double(i * 0.1));
+            json_adapter::set_member(item, "active", json_adapter::make_bool(i % 2 == 0));
+            json_adapter::append_array(doc, item);
+        }
+        
+        auto report = [](const char* format, size_t bytes, auto encode, auto decode) {
+            constexpr int rounds = 5;
+            auto t1 = std::chrono::high_resolution_clock::now();
+            for (int r = 0; r < rounds; ++r) encode();
+            auto t2 = std::chrono::high_resolution_clock::now();
+            for (int r = 0; r < rounds; ++r) decode();
+            auto t3 = std::chrono::high_resolution_clock::now();
+            auto mb_per_s = [bytes](auto elapsed) {
+                const double seconds = std::chrono::duration<double>(elapsed).count() / rounds;
+                return seconds > 0 ? bytes / seconds / 1e6 : 0.0;
+            };
+            std::cout << std::left << std::setw(12) << format << std::right << std::setw(9) << bytes << " bytes, encode "
+                      << std::fixed << std::setprecision(1) << mb_per_s(t2 - t1) << " MB/s, decode "
+                      << mb_per_s(t3 - t2) << " MB/s\n";
+        };
+        
+        const std::string text = json_adapter::dump(doc);
+        const auto msgpack = json_adapter::to_msgpack(doc);
+        const auto cbor = json_adapter::to_cbor(doc);
+        // AxzDict's dump() answers repeated calls from its serialization cache; dump_to() serializes every time
+        auto encode_text = [&] {
+            std::string out;
+            json_adapter::dump_to(doc, [&out](const char* data, size_t size) { out.append(data, size); return true; });
+            return out;
+        };
+        report("Text JSON", text.size(), encode_text, [&] { return json_adapter::parse(text); });
+        report("MessagePack", msgpack.size(), [&] { return json_adapter::to_msgpack(doc); }, [&] { return json_adapter::from_msgpack(msgpack); });
+        report("CBOR", cbor.size(), [&] { return json_adapter::to_cbor(doc); }, [&] { return json_adapter::from_cbor(cbor); });
+    }
+    
+    // Test 8: Sustained durable writes (write-ahead log, fdatasync per group commit)
+    {
+        const auto dir = std::filesystem::temp_directory_path() / "observable_wal_benchmark";
+        for (int threads : {1, 4, 16}) {
+            std::filesystem::remove_all(dir);
+            UniversalObservableJson obs;
+            obs.enable_durability(dir.string());
+            constexpr int writes_per_thread = 200;
+            
+            auto t1 = std::chrono::high_resolution_clock::now();
+            std::vector<std::thread> writers;
+            for (int t = 0; t < threads; ++t) {
+                writers.emplace_back([&obs, t] {
+                    for (int i = 0; i < writes_per_thread; ++i) obs.set("writer_" + std::to_string(t), i);
+                });
+            }
+            for (auto& writer : writers) writer.join();
+            auto t2 = std::chrono::high_resolution_clock::now();
+            
+            const auto stats = obs.get_statistics();
+            const double seconds = std::chrono::duration<double>(t2 - t1).count();
+            std::cout << "Durable writes, " << std::setw(2) << threads << " threads: " << std::fixed << std::setprecision(0)
+                      << threads * writes_per_thread / seconds << " writes/s, " << std::setprecision(1)
+                      << static_cast<double>(stats.wal_records) / std::max<uint64_t>(stats.wal_syncs, 1) << " records per sync\n";
+        }
+        std::filesystem::remove_all(dir);
+    }
+    
+    // Test 9: Background persistence of many documents, io_uring vs pwrite thread pool
+    {
+        const auto dir = std::filesystem::temp_directory_path() / "observable_writer_benchmark";
+        std::filesystem::create_directories(dir);
+        UniversalObservableJson source;
+        for (int i = 0; i < iterations; ++i) source.set("key_" + std::to_string(i), "value " + std::to_string(i));
+        const std::string text = source.dump();
+        constexpr int documents = 32;
+        
+        using Backend = json_adapter::AsyncWriterOptions::Backend;
+        for (Backend backend : {Backend::Auto, Backend::Pwrite}) {
+            json_adapter::AsyncWriterOptions options;
+            options.backend = backend;
+            json_adapter::AsyncFileWriter writer(options);
+            
+            auto t1 = std::chrono::high_resolution_clock::now();
+            std::vector<std::future<void>> pending;
+            for (int d = 0; d < documents; ++d) {
+                pending.push_back(writer.write_file((dir / ("doc" + std::to_string(d) + ".json")).string(), text));
+            }
+            auto t2 = std::chrono::high_resolution_clock::now();
+            for (auto& done : pending) done.get();
+            auto t3 = std::chrono::high_resolution_clock::now();
+            
+            const double seconds = std::chrono::duration<double>(t3 - t1).count();
+            std::cout << "Persist " << documents << " documents (" << std::setw(8) << writer.backend_name() << "): "
+                      << std::fixed << std::setprecision(1) << documents * text.size() / seconds / 1e6 << " MB/s, caller blocked "
+                      << std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count() << " μs\n";
+        }
+        std::filesystem::remove_all(dir);
+    }
+    
+    // Test 10: Memory-mapped document: restart cost and lookups against the in-memory one
+    {
+        const auto file = (std::filesystem::temp_directory_path() / "observable_mapped_benchmark.map").string();
+        std::filesystem::remove(file);
+        std::string text;
+        {
+            MappedObservableJson mapped(file);
+            UniversalObservableJson memory;
+            for (int i = 0; i < iterations * 10; ++i) {
+                mapped.set("key_" + std::to_string(i), i);
+                memory.set("key_" + std::to_string(i), i);
+            }
+            text = memory.dump();
+        }
+        
+        auto t1 = std::chrono::high_resolution_clock::now();
+        UniversalObservableJson parsed(text);
+        int found = parsed.get<int>("key_7");
+        auto t2 = std::chrono::high_resolution_clock::now();
+        MappedObservableJson mapped(file);
+        found += mapped.get<int>("key_7");
+        auto t3 = std::chrono::high_resolution_clock::now();
+        
+        long long sum = 0;
+        for (int i = 0; i < iterations; ++i) sum += parsed.get<int>("key_" + std::to_string(i * 7 % (iterations * 10)));
+        auto t4 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) sum += mapped.get<int>("key_" + std::to_string(i * 7 % (iterations * 10)));
+        auto t5 = std::chrono::high_resolution_clock::now();
+        
+        auto us = [](auto elapsed) { return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count(); };
+        std::cout << "Restart, parse " << iterations * 10 << " keys: " << us(t2 - t1) << " μs; map file: " << us(t3 - t2)
+                  << " μs (found " << found << ")\n";
+        std::cout << "Lookups, in memory: " << us(t4 - t3) << " μs; mapped: " << us(t5 - t4) << " μs for " << iterations
+                  << " gets (checksum " << sum << ")\n";
+        std::filesystem::remove(file);
+    }
+
+    // Test 11: Typed reads and unobserved writes next to a large member (no subtree copies)
+    {
+        std::cout << "\n--- Test 11: Reads and Writes Beside a Large Member ---\n";
+        UniversalObservableJson obs;
+        json big = json_adapter::make_array();
+        for (int i = 0; i < 100000; ++i) json_adapter::append_array(big, json_adapter::make_string("item" + std::to_string(i)));
+        obs.set("big", big);
+        obs.set("count", 0);
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+        long long sum = 0;
+        for (int i = 0; i < iterations; ++i) sum += obs.get<int>("count");
+        auto t2 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < 10; ++i) sum += static_cast<long long>(json_adapter::array_size(obs.get("big")));
+        auto t3 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) obs.set("count", i);
+        auto t4 = std::chrono::high_resolution_clock::now();
+        auto id = obs.subscribe([](const json&, const std::string&, const json&) {}, std::string("count"));
+        for (int i = 0; i < iterations; ++i) obs.set("count", i);
+        obs.wait_for_notifications();
+        auto t5 = std::chrono::high_resolution_clock::now();
+        obs.unsubscribe(id);
+
+        auto ns = [](auto elapsed, int n) { return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / n; };
+        std::cout << "get<int>: " << ns(t2 - t1, iterations) << " ns/op; get() of the 100k-element member: "
+                  << ns(t3 - t2, 10) / 1000 << " μs/op (checksum " << sum << ")\n";
+        std::cout << "set, unobserved: " << ns(t4 - t3, iterations) << " ns/op; observed: " << ns(t5 - t4, iterations)
+                  << " ns/op\n";
+    }
+
+    // Test 12: Loading a document from text (simdjson On-Demand vs the backend's own parser: build both and compare)
+    {
+        std::cout << "\n--- Test 12: Document Load Throughput ---\n";
+        std::string text = "[";
+        for (int i = 0; i < 20000; ++i) {
+            if (i) text += ",";
+            text += "{\"id\":" + std::to_string(i) + ",\"name\":\"User number " + std::to_string(i) + "\",\"score\":" +
+                    std::to_string(i * 0.37) + ",\"active\":true,\"tags\":[\"a\",\"bb\",\"ccc\"]}";
+        }
+        text += "]";
+        const int rounds = 10;
+        size_t checksum = 0;
+
+        auto t1 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < rounds; ++i) checksum += json_adapter::array_size(json_adapter::parse(text));
+        auto t2 = std::chrono::high_resolution_clock::now();
+        const std::string wrapped = "{\"rows\":" + text + "}";
+        for (int i = 0; i < rounds; ++i) checksum += UniversalObservableJson(wrapped).size();
+        auto t3 = std::chrono::high_resolution_clock::now();
+
+        auto ms = [](auto elapsed) { return std::chrono::duration<double, std::milli>(elapsed).count(); };
+        const double mb = text.size() / 1e6;
+        std::cout << json_adapter::get_backend_name() << " parse of " << mb << " MB: " << ms(t2 - t1) / rounds << " ms ("
+                  << mb * rounds / (ms(t2 - t1) / 1000) << " MB/s); observable construction: " << ms(t3 - t2) / rounds
+                  << " ms (checksum " << checksum << ")\n";
+    }
+
+    // Test 13: The same set/get pair on the typed document and through the backend-neutral handle
+    {
+        std::cout << "\n--- Test 13: Backend-Neutral Handle Dispatch ---\n";
+        const int ops = 200000;
+        UniversalObservableJson direct;
+        AnyObservablePtr handle = make_any_observable(json_adapter::get_backend_name());
+        long long checksum = 0;
+        double direct_ns = 0, handle_ns = 0;
+
+        // Alternate the two loops so neither gets the warm caches alone
+        for (int round = 0; round < 2; ++round) {
+            auto t1 = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < ops; ++i) {
+                direct.set("counter", i);
+                checksum += direct.get<int>("counter");
+            }
+            auto t2 = std::chrono::high_resolution_clock::now();
+            for (int i = 0; i < ops; ++i) {
+                handle->set("counter", i);
+                checksum += handle->get<int>("counter");
+            }
+            auto t3 = std::chrono::high_resolution_clock::now();
+            direct_ns += std::chrono::duration<double, std::nano>(t2 - t1).count();
+            handle_ns += std::chrono::duration<double, std::nano>(t3 - t2).count();
+        }
+
+        const double pairs = 2.0 * ops;
+        std::cout << "set+get on UniversalObservableJson: " << direct_ns / pairs << " ns; through AnyObservableJson: "
+                  << handle_ns / pairs << " ns (difference " << (handle_ns - direct_ns) / pairs << " ns, checksum "
+                  << checksum << ")\n";
+    }
+
     auto end = std::chrono::high_resolution_clock::now();
     auto total_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     std::cout << "\nTotal benchmark time: " << total_duration.count() << " ms\n";
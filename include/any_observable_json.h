@@ -0,0 +1,156 @@
+/**
+ * @file any_observable_json.h
+ * @brief Backend-neutral handle to an observable document, for programs that mix backends
+ *
+ * JSON_ADAPTER_BACKEND is fixed per translation unit, and everything that depends on it sits in an
+ * inline namespace named after the backend, so translation units built for different backends link into
+ * one program. Each translation unit that includes any_observable_json_backend.h registers its backend
+ * here; any code in the program can then create documents by backend name without seeing their json type:
+ *
+ *     auto catalog = universal_observable_json::make_any_observable("JsonCpp", catalog_text);
+ *     auto session = universal_observable_json::make_any_observable("AxzDict");
+ *     session->set("user", std::string("ada"));
+ *
+ * Every call goes through one virtual function, and values cross it as bool, int, double, std::string or
+ * JSON text. Code that stays on one backend should keep using UniversalObservableJson directly
+ * (performance_comparison measures the difference).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace universal_observable_json {
+
+class AnyObservableJson {
+public:
+    // Receives the path that changed ("" for clear); read the new value back through the handle
+    using ChangeCallback = std::function<void(const std::string& path)>;
+
+    virtual ~AnyObservableJson() = default;
+
+    // json_adapter::get_backend_name() of the translation unit that created the document
+    virtual std::string_view backend_name() const noexcept = 0;
+
+    virtual void set_bool(const std::string& path, bool value) = 0;
+    virtual void set_int(const std::string& path, int value) = 0;
+    virtual void set_double(const std::string& path, double value) = 0;
+    virtual void set_string(const std::string& path, const std::string& value) = 0;
+    // Parses json_text with the document's backend; throws on malformed text
+    virtual void set_json(const std::string& path, const std::string& json_text) = 0;
+
+    // Throw std::runtime_error for a missing member or one of another type
+    virtual bool get_bool(const std::string& path) const = 0;
+    virtual int get_int(const std::string& path) const = 0;
+    virtual double get_double(const std::string& path) const = 0;
+    virtual std::string get_string(const std::string& path) const = 0;
+    virtual std::string get_json(const std::string& path, int indent = -1) const = 0;
+
+    virtual bool has(const std::string& path) const = 0;
+    virtual void remove(const std::string& path) = 0;
+    virtual void clear() = 0;
+    virtual size_t size() const = 0;
+    virtual std::string dump(int indent = -1) const = 0;
+
+    virtual size_t subscribe(ChangeCallback callback, const std::string& path_filter = "") = 0;
+    virtual void unsubscribe(size_t subscription_id) = 0;
+    virtual void wait_for_notifications() const = 0;
+
+    template<typename T>
+    void set(const std::string& path, const T& value) {
+        if constexpr (std::is_same_v<T, bool>) {
+            set_bool(path, value);
+        } else if constexpr (std::is_integral_v<T>) {
+            set_int(path, static_cast<int>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            set_double(path, static_cast<double>(value));
+        } else {
+            static_assert(std::is_convertible_v<const T&, std::string>,
+                          "AnyObservableJson::set takes bool, integers, floating point or strings; use set_json for the rest");
+            set_string(path, value);
+        }
+    }
+
+    template<typename T>
+    T get(const std::string& path) const {
+        if constexpr (std::is_same_v<T, bool>) {
+            return get_bool(path);
+        } else if constexpr (std::is_integral_v<T>) {
+            return static_cast<T>(get_int(path));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return static_cast<T>(get_double(path));
+        } else {
+            static_assert(std::is_same_v<T, std::string>,
+                          "AnyObservableJson::get returns bool, integers, floating point or std::string; use get_json for the rest");
+            return get_string(path);
+        }
+    }
+};
+
+using AnyObservablePtr = std::unique_ptr<AnyObservableJson>;
+// Creates a document from JSON text; "" gives an empty object
+using AnyObservableFactory = AnyObservablePtr (*)(const std::string& json_text);
+
+namespace any_detail {
+    struct BackendRegistry {
+        std::mutex mutex;
+        std::vector<std::pair<std::string, AnyObservableFactory>> factories;  // registration order
+    };
+
+    inline BackendRegistry& backend_registry() {
+        static BackendRegistry registry;
+        return registry;
+    }
+}
+
+// Called by any_observable_json_backend.h during static initialization; a name already present keeps
+// its first factory. Returns true so the call can initialize a variable.
+inline bool register_any_backend(std::string_view name, AnyObservableFactory factory) {
+    auto& registry = any_detail::backend_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& entry : registry.factories) {
+        if (entry.first == name) return true;
+    }
+    registry.factories.emplace_back(std::string(name), factory);
+    return true;
+}
+
+// Names of the backends linked into the program, in registration order
+inline std::vector<std::string> any_observable_backends() {
+    auto& registry = any_detail::backend_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<std::string> names;
+    names.reserve(registry.factories.size());
+    for (const auto& entry : registry.factories) names.push_back(entry.first);
+    return names;
+}
+
+// Throws std::invalid_argument when no linked translation unit registered `backend`
+inline AnyObservablePtr make_any_observable(std::string_view backend, const std::string& json_text = "") {
+    AnyObservableFactory factory = nullptr;
+    {
+        auto& registry = any_detail::backend_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& entry : registry.factories) {
+            if (entry.first == backend) {
+                factory = entry.second;
+                break;
+            }
+        }
+    }
+    if (!factory) {
+        throw std::invalid_argument("make_any_observable: backend '" + std::string(backend) + "' is not linked into this program");
+    }
+    return factory(json_text);
+}
+
+} // namespace universal_observable_json
@@ -0,0 +1,74 @@
+/**
+ * @file any_observable_json_backend.h
+ * @brief Registers this translation unit's backend with any_observable_json.h
+ *
+ * Include it from one source file per backend the program should offer, each compiled with its own
+ * JSON_ADAPTER_BACKEND (or defining it before the include). Including it from several files built for the
+ * same backend is harmless: the registration runs once.
+ */
+
+#pragma once
+
+#include "universal_observable_json.h"
+#include "any_observable_json.h"
+
+OBSERVABLE_JSON_NAMESPACE_BEGIN
+
+// AnyObservableJson over this translation unit's UniversalObservableJson
+class BackendObservableJson final : public AnyObservableJson {
+public:
+    BackendObservableJson() = default;
+    explicit BackendObservableJson(const json& data) : document_(data) {}
+
+    // The typed document, for code compiled against the same backend
+    UniversalObservableJson& document() noexcept { return document_; }
+    const UniversalObservableJson& document() const noexcept { return document_; }
+
+    std::string_view backend_name() const noexcept override { return json_adapter::get_backend_name(); }
+
+    void set_bool(const std::string& path, bool value) override { document_.set(path, value); }
+    void set_int(const std::string& path, int value) override { document_.set(path, value); }
+    void set_double(const std::string& path, double value) override { document_.set(path, value); }
+    void set_string(const std::string& path, const std::string& value) override { document_.set(path, value); }
+    void set_json(const std::string& path, const std::string& json_text) override {
+        document_.set(path, json_adapter::parse(json_text));
+    }
+
+    bool get_bool(const std::string& path) const override { return document_.get<bool>(path); }
+    int get_int(const std::string& path) const override { return document_.get<int>(path); }
+    double get_double(const std::string& path) const override { return document_.get<double>(path); }
+    std::string get_string(const std::string& path) const override { return document_.get<std::string>(path); }
+    std::string get_json(const std::string& path, int indent = -1) const override {
+        return json_adapter::dump(document_.get(path), indent);
+    }
+
+    bool has(const std::string& path) const override { return document_.has(path); }
+    void remove(const std::string& path) override { document_.remove(path); }
+    void clear() override { document_.clear(); }
+    size_t size() const override { return document_.size(); }
+    std::string dump(int indent = -1) const override { return document_.dump(indent); }
+
+    size_t subscribe(ChangeCallback callback, const std::string& path_filter = "") override {
+        return document_.subscribe(
+            [callback = std::move(callback)](const json&, const std::string& path, const json&) { callback(path); },
+            path_filter);
+    }
+    void unsubscribe(size_t subscription_id) override { document_.unsubscribe(subscription_id); }
+    void wait_for_notifications() const override { document_.wait_for_notifications(); }
+
+private:
+    UniversalObservableJson document_;
+};
+
+inline AnyObservablePtr make_backend_observable(const std::string& json_text) {
+    if (json_text.empty()) {
+        return std::make_unique<BackendObservableJson>();
+    }
+    return std::make_unique<BackendObservableJson>(json_adapter::parse(json_text));
+}
+
+// Runs during static initialization of every translation unit that includes this header
+inline const bool backend_observable_registered =
+    register_any_backend(json_adapter::get_backend_name(), &make_backend_observable);
+
+OBSERVABLE_JSON_NAMESPACE_END
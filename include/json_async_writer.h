@@ -0,0 +1,663 @@
+/**
+ * @file json_async_writer.h
+ * @brief Background file writer for persisting documents: io_uring on Linux, a pwrite thread pool elsewhere
+ *
+ * Each request replaces one file with the given bytes: they go to "<file>.tmp", which is synced and then
+ * renamed over "<file>", so a reader never sees a partial document. The caller gets a future and never
+ * blocks in write(2).
+ *
+ * The io_uring engine runs one thread and drives the ring with raw syscalls (no liburing). A fixed set
+ * of aligned buffers is registered with the kernel once. Chunks of every queued file are copied into
+ * free buffers and submitted together as WRITE_FIXED, followed by an FSYNC per file. Files are opened
+ * with O_DIRECT where the filesystem accepts it, so large snapshots bypass the page cache; the last
+ * block is padded and the file truncated back to its real size. If the ring cannot be set up (old
+ * kernel, seccomp, not Linux), a pool of threads does the same with pwrite and fsync.
+ */
+
+#pragma once
+
+#include "universal_json_adapter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSON_ASYNC_WRITER_POSIX 1
+#endif
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define JSON_ASYNC_WRITER_URING 1
+#endif
+#endif
+#endif
+
+JSON_ADAPTER_NAMESPACE_BEGIN
+
+struct AsyncWriterOptions {
+    enum class Backend : uint8_t { Auto, IoUring, Pwrite };
+
+    Backend backend = Backend::Auto;    // Auto: io_uring when the kernel allows it, else the pwrite pool
+    unsigned queue_depth = 64;          // ring entries; bounds writes plus syncs in flight
+    size_t buffer_size = 1 << 20;       // bytes per write, rounded up to the 4 KiB direct I/O block
+    size_t buffer_count = 8;            // registered buffers shared by all files in flight
+    bool direct = true;                 // O_DIRECT where the filesystem supports it
+    size_t pwrite_threads = 2;          // workers of the fallback engine
+};
+
+namespace async_writer_detail {
+
+inline constexpr size_t BLOCK = 4096;
+
+inline size_t round_up(size_t n) { return (n + BLOCK - 1) / BLOCK * BLOCK; }
+
+struct Job {
+    std::string file;
+    std::string contents;
+    std::promise<void> done;
+};
+
+// Block-aligned allocation, as O_DIRECT needs for its buffers
+struct AlignedBuffer {
+    explicit AlignedBuffer(size_t size) : size(size) {
+        data = static_cast<char*>(std::malloc(size + BLOCK));
+        if (!data) throw std::bad_alloc();
+        aligned = reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(data) + BLOCK - 1) & ~uintptr_t(BLOCK - 1));
+    }
+    ~AlignedBuffer() { std::free(data); }
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    char* data = nullptr;
+    char* aligned = nullptr;
+    size_t size = 0;
+};
+
+inline std::string temporary_name(const std::string& file) { return file + ".tmp"; }
+
+#if JSON_ASYNC_WRITER_POSIX
+// Open the temporary file, with O_DIRECT if asked for and the filesystem takes it
+inline int open_temporary(const std::string& file, bool want_direct, bool& direct) {
+    const std::string temporary = temporary_name(file);
+    const int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+#ifdef O_DIRECT
+    if (want_direct) {
+        const int fd = ::open(temporary.c_str(), flags | O_DIRECT, 0644);
+        if (fd >= 0) {
+            direct = true;
+            return fd;
+        }
+    }
+#else
+    (void)want_direct;
+#endif
+    direct = false;
+    const int fd = ::open(temporary.c_str(), flags, 0644);
+    if (fd < 0) throw std::runtime_error("Async writer: cannot create " + temporary);
+    return fd;
+}
+
+inline void sync_parent_directory(const std::string& file) {
+    const size_t slash = file.find_last_of('/');
+    const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : file.substr(0, slash);
+    const int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+}
+
+// Direct writes pad the last block; cut the file back to its real size before it is synced
+inline void trim(int fd, bool direct, const Job& job) {
+    if (direct && job.contents.size() % BLOCK != 0 && ::ftruncate(fd, static_cast<off_t>(job.contents.size())) != 0) {
+        throw std::runtime_error("Async writer: cannot truncate " + temporary_name(job.file));
+    }
+}
+
+// After the data is synced: drop cached pages and move the file into place
+inline void publish(int fd, bool direct, const Job& job) {
+#if defined(POSIX_FADV_DONTNEED)
+    if (!direct) ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+    const bool closed = ::close(fd) == 0;
+    const std::string temporary = temporary_name(job.file);
+    if (!closed || std::rename(temporary.c_str(), job.file.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Async writer: cannot write " + job.file);
+    }
+    sync_parent_directory(job.file);
+}
+
+inline void discard(int fd, const Job& job) {
+    if (fd >= 0) ::close(fd);
+    std::remove(temporary_name(job.file).c_str());
+}
+#endif
+
+class Engine {
+public:
+    virtual ~Engine() = default;
+    virtual void submit(std::unique_ptr<Job> job) = 0;
+    virtual const char* name() const noexcept = 0;
+};
+
+// Thread pool that writes each file with pwrite from an aligned buffer, then fsyncs it
+class PwriteEngine final : public Engine {
+public:
+    explicit PwriteEngine(const AsyncWriterOptions& options)
+        : buffer_size_(round_up(std::max<size_t>(options.buffer_size, 1))), direct_(options.direct) {
+        const size_t threads = std::max<size_t>(options.pwrite_threads, 1);
+        for (size_t i = 0; i < threads; ++i) workers_.emplace_back([this] { run(); });
+    }
+
+    ~PwriteEngine() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for (auto& worker : workers_) worker.join();
+    }
+
+    void submit(std::unique_ptr<Job> job) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            queue_.push_back(std::move(job));
+        }
+        cv_.notify_one();
+    }
+
+    const char* name() const noexcept override { return "pwrite"; }
+
+private:
+    size_t buffer_size_;
+    bool direct_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::unique_ptr<Job>> queue_;
+    bool stop_ = false;
+    std::vector<std::thread> workers_;
+
+    void run() {
+        AlignedBuffer buffer(buffer_size_);
+        while (true) {
+            std::unique_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                cv_.wait(lock, [this] { return stop_ || !queue_.empty(); });
+                if (queue_.empty()) return;
+                job = std::move(queue_.front());
+                queue_.pop_front();
+            }
+            try {
+                write(*job, buffer);
+                job->done.set_value();
+            } catch (...) {
+                job->done.set_exception(std::current_exception());
+            }
+        }
+    }
+
+    void write(const Job& job, AlignedBuffer& buffer) {
+#if JSON_ASYNC_WRITER_POSIX
+        bool direct = false;
+        const int fd = open_temporary(job.file, direct_, direct);
+        try {
+            for (size_t offset = 0; offset < job.contents.size(); offset += buffer.size) {
+                const size_t length = std::min(buffer.size, job.contents.size() - offset);
+                const size_t padded = direct ? round_up(length) : length;
+                std::memcpy(buffer.aligned, job.contents.data() + offset, length);
+                std::memset(buffer.aligned + length, 0, padded - length);
+                for (size_t done = 0; done < padded;) {
+                    const ssize_t n = ::pwrite(fd, buffer.aligned + done, padded - done, static_cast<off_t>(offset + done));
+                    if (n < 0 && errno == EINTR) continue;
+                    if (n <= 0) throw std::runtime_error("Async writer: write failed for " + job.file);
+                    done += static_cast<size_t>(n);
+                }
+            }
+            trim(fd, direct, job);
+            if (::fsync(fd) != 0) throw std::runtime_error("Async writer: sync failed for " + job.file);
+        } catch (...) {
+            discard(fd, job);
+            throw;
+        }
+        publish(fd, direct, job);
+#else
+        (void)buffer;
+        const std::string temporary = temporary_name(job.file);
+        std::FILE* out = std::fopen(temporary.c_str(), "wb");
+        if (!out) throw std::runtime_error("Async writer: cannot create " + temporary);
+        const bool ok = std::fwrite(job.contents.data(), 1, job.contents.size(), out) == job.contents.size();
+        if (std::fclose(out) != 0 || !ok || std::rename(temporary.c_str(), job.file.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Async writer: cannot write " + job.file);
+        }
+#endif
+    }
+};
+
+#if JSON_ASYNC_WRITER_URING
+// Submission and completion rings of one io_uring instance, mapped from the kernel
+class Ring {
+public:
+    explicit Ring(unsigned entries) {
+        io_uring_params params;
+        std::memset(&params, 0, sizeof(params));
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0) throw std::runtime_error("io_uring unavailable");
+
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+
+        sq_ring_ = map(sq_size_, IORING_OFF_SQ_RING);
+        cq_ring_ = single ? sq_ring_ : map(cq_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+
+        auto at = [](void* base, uint32_t offset) { return reinterpret_cast<unsigned*>(static_cast<char*>(base) + offset); };
+        sq_head_ = at(sq_ring_, params.sq_off.head);
+        sq_tail_ = at(sq_ring_, params.sq_off.tail);
+        sq_mask_ = *at(sq_ring_, params.sq_off.ring_mask);
+        sq_array_ = at(sq_ring_, params.sq_off.array);
+        cq_head_ = at(cq_ring_, params.cq_off.head);
+        cq_tail_ = at(cq_ring_, params.cq_off.tail);
+        cq_mask_ = *at(cq_ring_, params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(static_cast<char*>(cq_ring_) + params.cq_off.cqes);
+        entries_ = params.sq_entries;
+    }
+
+    ~Ring() { release(); }
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    void register_buffers(const std::vector<iovec>& buffers) {
+        if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS, buffers.data(),
+                      static_cast<unsigned>(buffers.size())) != 0) {
+            throw std::runtime_error("io_uring: cannot register buffers");
+        }
+    }
+
+    unsigned entries() const noexcept { return entries_; }
+
+    // Next free submission entry, zeroed; the caller checked that fewer than entries() are pending
+    io_uring_sqe* next() {
+        const unsigned index = tail_ & sq_mask_;
+        io_uring_sqe* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sq_array_[index] = index;
+        ++tail_;
+        ++pending_;
+        return sqe;
+    }
+
+    // Hand everything prepared to the kernel in one call and wait for at least one completion.
+    // Returns false when the kernel is out of room for now (EAGAIN, or EBUSY with completions to reap):
+    // nothing was consumed, and the caller reaps and calls again.
+    bool submit_and_wait() {
+        __atomic_store_n(sq_tail_, tail_, __ATOMIC_RELEASE);
+        unsigned to_submit = pending_;
+        while (true) {
+            const long submitted = ::syscall(__NR_io_uring_enter, fd_, to_submit, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (submitted >= 0) {
+                pending_ = to_submit - static_cast<unsigned>(submitted);
+                return true;
+            }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EBUSY) return false;
+            throw std::runtime_error("io_uring: enter failed: " + std::string(std::strerror(errno)));
+        }
+    }
+
+    // Returns the number of completions handed to fn
+    template<typename Fn>
+    unsigned reap(Fn&& fn) {
+        unsigned head = *cq_head_;
+        const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        const unsigned count = tail - head;
+        for (; head != tail; ++head) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            fn(cqe.user_data, cqe.res);
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+private:
+    int fd_ = -1;
+    void* sq_ring_ = nullptr;
+    void* cq_ring_ = nullptr;
+    io_uring_sqe* sqes_ = nullptr;
+    size_t sq_size_ = 0, cq_size_ = 0, sqes_size_ = 0;
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned entries_ = 0;
+    unsigned tail_ = 0;         // local submission tail, published by submit_and_wait()
+    unsigned pending_ = 0;      // prepared but not yet consumed by the kernel
+
+    void* map(size_t size, off_t offset) {
+        void* p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, offset);
+        if (p == MAP_FAILED) {
+            release();
+            throw std::runtime_error("io_uring: cannot map rings");
+        }
+        return p;
+    }
+
+    void release() {
+        if (sqes_) ::munmap(sqes_, sqes_size_);
+        if (cq_ring_ && cq_ring_ != sq_ring_) ::munmap(cq_ring_, cq_size_);
+        if (sq_ring_) ::munmap(sq_ring_, sq_size_);
+        if (fd_ >= 0) ::close(fd_);
+        sqes_ = nullptr;
+        sq_ring_ = cq_ring_ = nullptr;
+        fd_ = -1;
+    }
+};
+
+// One thread owns the ring. Files queued by submit() share the registered buffers, and all writes and
+// syncs ready at a given moment go to the kernel in a single io_uring_enter. If the ring itself fails,
+// the files in progress start over on a PwriteEngine, which also takes every later submit().
+class UringEngine final : public Engine {
+public:
+    explicit UringEngine(const AsyncWriterOptions& options)
+        : options_(options)
+        , ring_(std::max(options.queue_depth, 2u))
+        , direct_(options.direct)
+        , storage_(round_up(std::max<size_t>(options.buffer_size, 1)) *
+                   std::clamp<size_t>(options.buffer_count, 1, ring_.entries() - 1)) {
+        const size_t count = std::clamp<size_t>(options.buffer_count, 1, ring_.entries() - 1);
+        buffer_size_ = storage_.size / count;
+        std::vector<iovec> iovecs(count);
+        slots_.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            iovecs[i].iov_base = storage_.aligned + i * buffer_size_;
+            iovecs[i].iov_len = buffer_size_;
+            free_.push_back(i);
+        }
+        ring_.register_buffers(iovecs);
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~UringEngine() override {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void submit(std::unique_ptr<Job> job) override {
+        PwriteEngine* fallback = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (broken_) {
+                job->done.set_exception(broken_);
+                return;
+            }
+            if (fallback_) fallback = fallback_.get();
+            else queue_.push_back(std::move(job));
+        }
+        if (fallback) fallback->submit(std::move(job));  // set once, never reset
+        else cv_.notify_one();
+    }
+
+    const char* name() const noexcept override { return fell_back_.load(std::memory_order_acquire) ? "pwrite" : "io_uring"; }
+
+private:
+    struct Active {
+        std::unique_ptr<Job> job;
+        int fd = -1;
+        bool direct = false;
+        size_t next = 0;            // first byte not yet handed to a buffer
+        unsigned in_flight = 0;
+        bool syncing = false;
+        std::exception_ptr error;
+    };
+
+    struct Slot {
+        Active* owner = nullptr;
+        unsigned length = 0;
+    };
+
+    AsyncWriterOptions options_;
+    Ring ring_;
+    bool direct_;
+    AlignedBuffer storage_;
+    size_t buffer_size_ = 0;
+    std::vector<Slot> slots_;
+    std::vector<size_t> free_;
+    std::deque<std::unique_ptr<Active>> active_;   // only touched by the ring thread
+    unsigned in_flight_ = 0;
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::unique_ptr<Job>> queue_;
+    bool stop_ = false;
+    std::unique_ptr<PwriteEngine> fallback_;        // guarded by mutex_
+    std::exception_ptr broken_;                     // guarded by mutex_; set when not even the fallback starts
+    std::atomic<bool> fell_back_{false};
+    std::thread thread_;
+
+    void run() {
+        while (true) {
+            std::deque<std::unique_ptr<Job>> incoming;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                if (in_flight_ == 0) {
+                    cv_.wait(lock, [this] { return stop_ || !queue_.empty() || !active_.empty(); });
+                    if (stop_ && queue_.empty() && active_.empty()) return;
+                }
+                incoming.swap(queue_);
+            }
+            for (auto& job : incoming) start(std::move(job));
+            prepare();
+            if (in_flight_ != 0) {
+                try {
+                    const bool entered = ring_.submit_and_wait();
+                    const unsigned reaped = ring_.reap([this](uint64_t user_data, int32_t result) { complete(user_data, result); });
+                    if (!entered && reaped == 0) std::this_thread::sleep_for(std::chrono::microseconds(100));
+                } catch (...) {
+                    fall_back(std::current_exception());
+                    return;
+                }
+            }
+            finish_ready();
+        }
+    }
+
+    void start(std::unique_ptr<Job> job) {
+        auto active = std::make_unique<Active>();
+        try {
+            active->fd = open_temporary(job->file, direct_, active->direct);
+        } catch (...) {
+            job->done.set_exception(std::current_exception());
+            return;
+        }
+        active->job = std::move(job);
+        active_.push_back(std::move(active));
+    }
+
+    // Fill free buffers with the next chunks of each file, oldest file first, and queue a sync for
+    // every file whose writes have all completed
+    void prepare() {
+        for (auto& active : active_) {
+            if (active->error || active->syncing) continue;
+            const std::string& contents = active->job->contents;
+            while (active->next < contents.size() && !free_.empty() && in_flight_ + 1 < ring_.entries()) {
+                const size_t slot = free_.back();
+                free_.pop_back();
+                const size_t length = std::min(buffer_size_, contents.size() - active->next);
+                const size_t padded = active->direct ? round_up(length) : length;
+                char* buffer = storage_.aligned + slot * buffer_size_;
+                std::memcpy(buffer, contents.data() + active->next, length);
+                std::memset(buffer + length, 0, padded - length);
+
+                io_uring_sqe* sqe = ring_.next();
+                sqe->opcode = IORING_OP_WRITE_FIXED;
+                sqe->fd = active->fd;
+                sqe->addr = reinterpret_cast<uint64_t>(buffer);
+                sqe->len = static_cast<uint32_t>(padded);
+                sqe->off = active->next;
+                sqe->buf_index = static_cast<uint16_t>(slot);
+                sqe->user_data = slot << 1;
+                slots_[slot] = Slot{active.get(), static_cast<unsigned>(padded)};
+                active->next += length;
+                ++active->in_flight;
+                ++in_flight_;
+            }
+            if (active->next >= contents.size() && active->in_flight == 0 && in_flight_ + 1 < ring_.entries()) {
+                try {
+                    trim(active->fd, active->direct, *active->job);
+                } catch (...) {
+                    active->error = std::current_exception();
+                    continue;
+                }
+                io_uring_sqe* sqe = ring_.next();
+                sqe->opcode = IORING_OP_FSYNC;
+                sqe->fd = active->fd;
+                sqe->user_data = reinterpret_cast<uint64_t>(active.get()) | 1;
+                active->syncing = true;
+                ++active->in_flight;
+                ++in_flight_;
+            }
+        }
+    }
+
+    void complete(uint64_t user_data, int32_t result) {
+        --in_flight_;
+        Active* active;
+        if (user_data & 1) {
+            active = reinterpret_cast<Active*>(user_data & ~uint64_t(1));
+        } else {
+            const size_t slot = static_cast<size_t>(user_data >> 1);
+            active = slots_[slot].owner;
+            if (result >= 0 && static_cast<unsigned>(result) != slots_[slot].length) result = -EIO;
+            free_.push_back(slot);
+        }
+        --active->in_flight;
+        if (result < 0 && !active->error) {
+            active->error = std::make_exception_ptr(std::runtime_error(
+                "Async writer: " + std::string(user_data & 1 ? "sync" : "write") + " failed for " + active->job->file +
+                ": " + std::strerror(-result)));
+        }
+    }
+
+    // Publish synced files and drop failed ones once nothing of theirs is in flight
+    void finish_ready() {
+        for (auto it = active_.begin(); it != active_.end();) {
+            Active& active = **it;
+            const bool synced = active.syncing && active.in_flight == 0;
+            if (active.in_flight != 0 || (!synced && !active.error)) {
+                ++it;
+                continue;
+            }
+            try {
+                if (active.error) std::rethrow_exception(active.error);
+                publish(active.fd, active.direct, *active.job);
+                active.job->done.set_value();
+            } catch (...) {
+                if (active.error) discard(active.fd, *active.job);
+                active.job->done.set_exception(std::current_exception());
+            }
+            it = active_.erase(it);
+        }
+    }
+
+    // The ring failed for good: restart the files in progress and the queue on a pwrite pool. Only if that
+    // pool cannot start either do they, and every later submit(), fail with `error`.
+    void fall_back(std::exception_ptr error) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        try {
+            fallback_ = std::make_unique<PwriteEngine>(options_);
+        } catch (...) {
+            broken_ = error;
+        }
+        fell_back_.store(fallback_ != nullptr, std::memory_order_release);
+        for (auto& active : active_) {
+            discard(active->fd, *active->job);
+            if (fallback_) fallback_->submit(std::move(active->job));
+            else active->job->done.set_exception(error);
+        }
+        active_.clear();
+        for (auto& job : queue_) {
+            if (fallback_) fallback_->submit(std::move(job));
+            else job->done.set_exception(error);
+        }
+        queue_.clear();
+    }
+};
+#endif
+
+}  // namespace async_writer_detail
+
+// Replaces files in the background. Thread-safe; the destructor finishes every queued write.
+class AsyncFileWriter {
+public:
+    explicit AsyncFileWriter(AsyncWriterOptions options = {}) {
+#if JSON_ASYNC_WRITER_URING
+        if (options.backend != AsyncWriterOptions::Backend::Pwrite) {
+            try {
+                engine_ = std::make_unique<async_writer_detail::UringEngine>(options);
+            } catch (const std::exception&) {
+                if (options.backend == AsyncWriterOptions::Backend::IoUring) throw;
+            }
+        }
+#else
+        if (options.backend == AsyncWriterOptions::Backend::IoUring) {
+            throw std::runtime_error("io_uring is not available on this platform");
+        }
+#endif
+        if (!engine_) engine_ = std::make_unique<async_writer_detail::PwriteEngine>(options);
+    }
+
+    // Replace `file` with `contents`. The future is ready once the new file is synced and renamed into place,
+    // or holds the std::runtime_error that stopped it.
+    std::future<void> write_file(std::string file, std::string contents) {
+        auto job = std::make_unique<async_writer_detail::Job>();
+        job->file = std::move(file);
+        job->contents = std::move(contents);
+        std::future<void> done = job->done.get_future();
+        engine_->submit(std::move(job));
+        return done;
+    }
+
+    // "io_uring" or "pwrite"
+    const char* backend_name() const noexcept { return engine_->name(); }
+
+private:
+    std::unique_ptr<async_writer_detail::Engine> engine_;
+};
+
+JSON_ADAPTER_NAMESPACE_END
@@ -0,0 +1,512 @@
+/**
+ * @file json_binary.h
+ * @brief MessagePack and CBOR encoding for every backend of the universal adapter
+ *
+ * Binary formats skip number formatting, escaping and whitespace, which is most of what text JSON costs
+ * between services. The generic codecs below only use the adapter primitives (is_*, get_*, make_*,
+ * set_member, append_array), so they work unchanged for every backend including AxzDict. nlohmann/json
+ * encodes with its native implementation but decodes here too: its decoders recurse without a depth
+ * limit, and decoders take input from other processes.
+ *
+ * Numbers keep their stored type (json_adapter::is_integer): integers are written as integers, doubles as
+ * the shortest float that keeps the value exact, so 2.0 and -0.0 come back as doubles. Integers past 2^53
+ * are written as doubles.
+ * Containers nest at most binary_detail::MAX_DEPTH deep. The encoders throw rather than write what the
+ * decoders would refuse; binary_detail::within_depth checks a value ahead of time.
+ * Encoding and decoding errors throw std::runtime_error.
+ */
+
+#pragma once
+
+#include "universal_json_adapter.h"
+
+#if JSON_ADAPTER_BACKEND == JSON11 || JSON_ADAPTER_BACKEND == RAPIDJSON
+    #error "json_binary.h needs the nlohmann, JsonCpp or AxzDict backend"
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+JSON_ADAPTER_NAMESPACE_BEGIN
+
+namespace binary_detail {
+
+// Deepest container nesting the decoders accept; the encoders refuse to write anything deeper
+inline constexpr int MAX_DEPTH = 512;
+
+// Both formats are big-endian on the wire
+class Writer {
+public:
+    std::vector<uint8_t> bytes;
+
+    void byte(uint8_t b) { bytes.push_back(b); }
+    void raw(const void* data, size_t size) {
+        const auto* p = static_cast<const uint8_t*>(data);
+        bytes.insert(bytes.end(), p, p + size);
+    }
+    template<typename T>
+    void big_endian(T value) {
+        for (int shift = (sizeof(T) - 1) * 8; shift >= 0; shift -= 8) {
+            bytes.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> shift));
+        }
+    }
+    void float32(float value) { uint32_t bits; std::memcpy(&bits, &value, 4); big_endian(bits); }
+    void float64(double value) { uint64_t bits; std::memcpy(&bits, &value, 8); big_endian(bits); }
+};
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size, const char* format) : data_(data), end_(data + size), format_(format) {}
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error(std::string(format_) + ": " + what);
+    }
+    bool done() const noexcept { return data_ == end_; }
+    uint8_t peek() { need(1); return *data_; }
+    uint8_t byte() { need(1); return *data_++; }
+    template<typename T>
+    T big_endian() {
+        need(sizeof(T));
+        uint64_t value = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) value = (value << 8) | *data_++;
+        return static_cast<T>(value);
+    }
+    float float32() { const uint32_t bits = big_endian<uint32_t>(); float f; std::memcpy(&f, &bits, 4); return f; }
+    double float64() { const uint64_t bits = big_endian<uint64_t>(); double d; std::memcpy(&d, &bits, 8); return d; }
+    std::string string(uint64_t size) {
+        need(size);
+        std::string s(reinterpret_cast<const char*>(data_), static_cast<size_t>(size));
+        data_ += size;
+        return s;
+    }
+
+    // Containers announce their size up front; nested values need at least one byte each
+    void check_count(uint64_t count) {
+        if (count > static_cast<uint64_t>(end_ - data_)) fail("truncated input");
+    }
+    void enter() { if (++depth_ > MAX_DEPTH) fail("nesting too deep"); }
+    void leave() noexcept { --depth_; }
+
+private:
+    const uint8_t* data_;
+    const uint8_t* end_;
+    const char* format_;
+    int depth_ = 0;
+
+    void need(uint64_t size) {
+        if (size > static_cast<uint64_t>(end_ - data_)) fail("truncated input");
+    }
+};
+
+// Integer within the range doubles hold exactly
+inline bool as_integer(double d, int64_t& out) {
+    if (std::floor(d) != d || std::fabs(d) > 9007199254740992.0) return false;
+    out = static_cast<int64_t>(d);
+    return true;
+}
+
+// Integers past make_int's range stay exact on nlohmann and JsonCpp, which store 64-bit integers;
+// AxzDict's integers are 32-bit, so there they become doubles
+inline json make_integer(int64_t value) {
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
+    return json(value);
+#elif JSON_ADAPTER_BACKEND == JSONCPP
+    return json(static_cast<Json::Int64>(value));
+#else
+    return value >= INT32_MIN && value <= INT32_MAX ? make_int(static_cast<int>(value)) : make_double(static_cast<double>(value));
+#endif
+}
+
+inline json make_unsigned(uint64_t value) {
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
+    return json(value);
+#elif JSON_ADAPTER_BACKEND == JSONCPP
+    return json(static_cast<Json::UInt64>(value));
+#else
+    return value <= INT32_MAX ? make_int(static_cast<int>(value)) : make_double(static_cast<double>(value));
+#endif
+}
+
+enum class Kind : uint8_t { Null, Bool, Integer, Double, String, Array, Object, Other };
+
+// One type query per value; every AxzDict accessor takes the node's lock, so it asks type() once
+inline Kind kind_of(const json& j) {
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    switch (j.type()) {
+        case AxzDictType::NUL:      return Kind::Null;
+        case AxzDictType::BOOL:     return Kind::Bool;
+        case AxzDictType::NUMBER:   return Kind::Double;
+        case AxzDictType::INTEGRAL: return Kind::Integer;
+        case AxzDictType::STRING:   return Kind::String;
+        case AxzDictType::ARRAY:    return Kind::Array;
+        case AxzDictType::OBJECT:   return Kind::Object;
+        default:                    return Kind::Other;
+    }
+#else
+    if (is_null(j)) return Kind::Null;
+    if (is_bool(j)) return Kind::Bool;
+    if (is_number(j)) return is_integer(j) ? Kind::Integer : Kind::Double;
+    if (is_string(j)) return Kind::String;
+    if (is_array(j)) return Kind::Array;
+    if (is_object(j)) return Kind::Object;
+    return Kind::Other;
+#endif
+}
+
+// Whether j, placed `depth` containers down, still decodes; stops looking once it is too deep
+inline bool within_depth(const json& j, int depth = 0) {
+    const Kind kind = kind_of(j);
+    if (kind != Kind::Array && kind != Kind::Object) return true;
+    if (depth == MAX_DEPTH) return false;
+    bool fits = true;
+    if (kind == Kind::Array) {
+        for_each_element(j, [&](const json& value) { fits = fits && within_depth(value, depth + 1); });
+    } else {
+        for_each_member(j, [&](const std::string&, const json& value) { fits = fits && within_depth(value, depth + 1); });
+    }
+    return fits;
+}
+
+inline size_t member_count(const json& obj) {
+    size_t count = 0;
+    for_each_member(obj, [&count](const std::string&, const json&) { ++count; });
+    return count;
+}
+
+// ---- MessagePack ----
+
+inline void msgpack_size(Writer& w, uint64_t size, uint8_t fix, uint8_t fix_limit, uint8_t code8, uint8_t code16, uint8_t code32) {
+    if (size < fix_limit) w.byte(static_cast<uint8_t>(fix | size));
+    else if (code8 && size <= UINT8_MAX) { w.byte(code8); w.byte(static_cast<uint8_t>(size)); }
+    else if (size <= UINT16_MAX) { w.byte(code16); w.big_endian(static_cast<uint16_t>(size)); }
+    else { w.byte(code32); w.big_endian(static_cast<uint32_t>(size)); }
+}
+
+inline void msgpack_encode(Writer& w, const json& j, int depth = 0) {
+    const Kind kind = kind_of(j);
+    if ((kind == Kind::Array || kind == Kind::Object) && depth == MAX_DEPTH) {
+        throw std::runtime_error("MessagePack: nesting too deep");
+    }
+    switch (kind) {
+        case Kind::Bool:
+            w.byte(get_bool(j) ? 0xc3 : 0xc2);
+            break;
+        case Kind::Integer:
+        case Kind::Double: {
+            const double d = get_double(j);
+            int64_t i = 0;
+            if (kind == Kind::Double || !as_integer(d, i)) {
+                if (static_cast<double>(static_cast<float>(d)) == d) { w.byte(0xca); w.float32(static_cast<float>(d)); }
+                else { w.byte(0xcb); w.float64(d); }
+            } else if (i >= 0) {
+                if (i < 128) w.byte(static_cast<uint8_t>(i));
+                else if (i <= UINT8_MAX) { w.byte(0xcc); w.byte(static_cast<uint8_t>(i)); }
+                else if (i <= UINT16_MAX) { w.byte(0xcd); w.big_endian(static_cast<uint16_t>(i)); }
+                else if (i <= UINT32_MAX) { w.byte(0xce); w.big_endian(static_cast<uint32_t>(i)); }
+                else { w.byte(0xcf); w.big_endian(static_cast<uint64_t>(i)); }
+            } else {
+                if (i >= -32) w.byte(static_cast<uint8_t>(i));
+                else if (i >= INT8_MIN) { w.byte(0xd0); w.byte(static_cast<uint8_t>(i)); }
+                else if (i >= INT16_MIN) { w.byte(0xd1); w.big_endian(static_cast<int16_t>(i)); }
+                else if (i >= INT32_MIN) { w.byte(0xd2); w.big_endian(static_cast<int32_t>(i)); }
+                else { w.byte(0xd3); w.big_endian(i); }
+            }
+            break;
+        }
+        case Kind::String: {
+            const std::string s = get_string(j);
+            msgpack_size(w, s.size(), 0xa0, 32, 0xd9, 0xda, 0xdb);
+            w.raw(s.data(), s.size());
+            break;
+        }
+        case Kind::Array:
+            msgpack_size(w, array_size(j), 0x90, 16, 0, 0xdc, 0xdd);
+            for_each_element(j, [&w, depth](const json& value) { msgpack_encode(w, value, depth + 1); });
+            break;
+        case Kind::Object:
+            msgpack_size(w, member_count(j), 0x80, 16, 0, 0xde, 0xdf);
+            for_each_member(j, [&w, depth](const std::string& key, const json& value) {
+                msgpack_size(w, key.size(), 0xa0, 32, 0xd9, 0xda, 0xdb);
+                w.raw(key.data(), key.size());
+                msgpack_encode(w, value, depth + 1);
+            });
+            break;
+        default:
+            w.byte(0xc0);  // null, and backend-specific kinds that have no JSON equivalent
+            break;
+    }
+}
+
+inline json msgpack_decode(Reader& r);
+
+inline json msgpack_array(Reader& r, uint64_t count) {
+    r.check_count(count);
+    r.enter();
+    json result = make_array();
+    for (uint64_t i = 0; i < count; ++i) append_array(result, msgpack_decode(r));
+    r.leave();
+    return result;
+}
+
+inline json msgpack_map(Reader& r, uint64_t count) {
+    r.check_count(count);
+    r.enter();
+    json result = make_object();
+    for (uint64_t i = 0; i < count; ++i) {
+        const json key = msgpack_decode(r);
+        if (!is_string(key)) r.fail("map keys must be strings");
+        set_member(result, get_string(key), msgpack_decode(r));
+    }
+    r.leave();
+    return result;
+}
+
+inline json msgpack_decode(Reader& r) {
+    const uint8_t code = r.byte();
+    if (code <= 0x7f) return make_int(code);
+    if (code >= 0xe0) return make_int(static_cast<int8_t>(code));
+    if ((code & 0xe0) == 0xa0) return make_string(r.string(code & 0x1f));
+    if ((code & 0xf0) == 0x90) return msgpack_array(r, code & 0x0f);
+    if ((code & 0xf0) == 0x80) return msgpack_map(r, code & 0x0f);
+
+    switch (code) {
+        case 0xc0: return make_null();
+        case 0xc2: return make_bool(false);
+        case 0xc3: return make_bool(true);
+        case 0xca: return make_double(r.float32());
+        case 0xcb: return make_double(r.float64());
+        case 0xcc: return make_int(r.byte());
+        case 0xcd: return make_int(r.big_endian<uint16_t>());
+        case 0xce: return make_integer(r.big_endian<uint32_t>());
+        case 0xcf: return make_unsigned(r.big_endian<uint64_t>());
+        case 0xd0: return make_int(static_cast<int8_t>(r.byte()));
+        case 0xd1: return make_int(r.big_endian<int16_t>());
+        case 0xd2: return make_int(r.big_endian<int32_t>());
+        case 0xd3: return make_integer(r.big_endian<int64_t>());
+        // bin 8/16/32 have no JSON type; they come back as strings of the same bytes
+        case 0xc4: case 0xd9: return make_string(r.string(r.byte()));
+        case 0xc5: case 0xda: return make_string(r.string(r.big_endian<uint16_t>()));
+        case 0xc6: case 0xdb: return make_string(r.string(r.big_endian<uint32_t>()));
+        case 0xdc: return msgpack_array(r, r.big_endian<uint16_t>());
+        case 0xdd: return msgpack_array(r, r.big_endian<uint32_t>());
+        case 0xde: return msgpack_map(r, r.big_endian<uint16_t>());
+        case 0xdf: return msgpack_map(r, r.big_endian<uint32_t>());
+        default:   r.fail("unsupported type byte " + std::to_string(code));
+    }
+}
+
+// ---- CBOR (RFC 8949) ----
+
+inline void cbor_head(Writer& w, uint8_t major, uint64_t value) {
+    const uint8_t type = static_cast<uint8_t>(major << 5);
+    if (value < 24) w.byte(static_cast<uint8_t>(type | value));
+    else if (value <= UINT8_MAX) { w.byte(type | 24); w.byte(static_cast<uint8_t>(value)); }
+    else if (value <= UINT16_MAX) { w.byte(type | 25); w.big_endian(static_cast<uint16_t>(value)); }
+    else if (value <= UINT32_MAX) { w.byte(type | 26); w.big_endian(static_cast<uint32_t>(value)); }
+    else { w.byte(type | 27); w.big_endian(value); }
+}
+
+inline void cbor_encode(Writer& w, const json& j, int depth = 0) {
+    const Kind kind = kind_of(j);
+    if ((kind == Kind::Array || kind == Kind::Object) && depth == MAX_DEPTH) {
+        throw std::runtime_error("CBOR: nesting too deep");
+    }
+    switch (kind) {
+        case Kind::Bool:
+            w.byte(get_bool(j) ? 0xf5 : 0xf4);
+            break;
+        case Kind::Integer:
+        case Kind::Double: {
+            const double d = get_double(j);
+            int64_t i = 0;
+            if (kind == Kind::Double || !as_integer(d, i)) {
+                if (static_cast<double>(static_cast<float>(d)) == d || std::isnan(d)) { w.byte(0xfa); w.float32(static_cast<float>(d)); }
+                else { w.byte(0xfb); w.float64(d); }
+            } else if (i >= 0) {
+                cbor_head(w, 0, static_cast<uint64_t>(i));
+            } else {
+                cbor_head(w, 1, static_cast<uint64_t>(-1 - i));
+            }
+            break;
+        }
+        case Kind::String: {
+            const std::string s = get_string(j);
+            cbor_head(w, 3, s.size());
+            w.raw(s.data(), s.size());
+            break;
+        }
+        case Kind::Array:
+            cbor_head(w, 4, array_size(j));
+            for_each_element(j, [&w, depth](const json& value) { cbor_encode(w, value, depth + 1); });
+            break;
+        case Kind::Object:
+            cbor_head(w, 5, member_count(j));
+            for_each_member(j, [&w, depth](const std::string& key, const json& value) {
+                cbor_head(w, 3, key.size());
+                w.raw(key.data(), key.size());
+                cbor_encode(w, value, depth + 1);
+            });
+            break;
+        default:
+            w.byte(0xf6);
+            break;
+    }
+}
+
+inline uint64_t cbor_argument(Reader& r, uint8_t info) {
+    if (info < 24) return info;
+    switch (info) {
+        case 24: return r.byte();
+        case 25: return r.big_endian<uint16_t>();
+        case 26: return r.big_endian<uint32_t>();
+        case 27: return r.big_endian<uint64_t>();
+        default: r.fail("bad additional information " + std::to_string(info));
+    }
+}
+
+inline double cbor_half(uint16_t half) {
+    const int exponent = (half >> 10) & 0x1f;
+    const int mantissa = half & 0x3ff;
+    double value = exponent == 0 ? std::ldexp(mantissa, -24)
+                 : exponent != 31 ? std::ldexp(mantissa + 1024, exponent - 25)
+                 : mantissa == 0 ? INFINITY : NAN;
+    return half & 0x8000 ? -value : value;
+}
+
+inline json cbor_decode(Reader& r);
+
+// Byte and text strings, definite or split into definite chunks
+inline std::string cbor_string(Reader& r, uint8_t major, uint8_t info) {
+    if (info != 31) return r.string(cbor_argument(r, info));
+    std::string result;
+    while (r.peek() != 0xff) {
+        const uint8_t chunk = r.byte();
+        if ((chunk >> 5) != major || (chunk & 0x1f) == 31) r.fail("bad string chunk");
+        result += r.string(cbor_argument(r, chunk & 0x1f));
+    }
+    r.byte();
+    return result;
+}
+
+inline json cbor_decode(Reader& r) {
+    uint8_t initial = r.byte();
+    // Tags (dates, bignums, ...) carry no JSON meaning; the tagged item is kept as is. Stacked tags are
+    // skipped in a loop, so a run of them cannot recurse past the depth limit.
+    while ((initial >> 5) == 6) {
+        cbor_argument(r, initial & 0x1f);
+        initial = r.byte();
+    }
+    const uint8_t major = initial >> 5;
+    const uint8_t info = initial & 0x1f;
+
+    switch (major) {
+        case 0:
+            return make_unsigned(cbor_argument(r, info));
+        case 1: {
+            const uint64_t value = cbor_argument(r, info);
+            return value <= static_cast<uint64_t>(INT64_MAX) ? make_integer(-1 - static_cast<int64_t>(value))
+                                                             : make_double(-1.0 - static_cast<double>(value));
+        }
+        case 2:
+        case 3:
+            return make_string(cbor_string(r, major, info));
+        case 4: {
+            r.enter();
+            json result = make_array();
+            if (info == 31) {
+                while (r.peek() != 0xff) append_array(result, cbor_decode(r));
+                r.byte();
+            } else {
+                const uint64_t count = cbor_argument(r, info);
+                r.check_count(count);
+                for (uint64_t i = 0; i < count; ++i) append_array(result, cbor_decode(r));
+            }
+            r.leave();
+            return result;
+        }
+        case 5: {
+            r.enter();
+            json result = make_object();
+            auto member = [&r, &result]() {
+                const json key = cbor_decode(r);
+                if (!is_string(key)) r.fail("map keys must be strings");
+                set_member(result, get_string(key), cbor_decode(r));
+            };
+            if (info == 31) {
+                while (r.peek() != 0xff) member();
+                r.byte();
+            } else {
+                const uint64_t count = cbor_argument(r, info);
+                r.check_count(count);
+                for (uint64_t i = 0; i < count; ++i) member();
+            }
+            r.leave();
+            return result;
+        }
+        default:
+            switch (info) {
+                case 20: return make_bool(false);
+                case 21: return make_bool(true);
+                case 22:
+                case 23: return make_null();
+                case 25: return make_double(cbor_half(r.big_endian<uint16_t>()));
+                case 26: return make_double(r.float32());
+                case 27: return make_double(r.float64());
+                default: r.fail("unsupported simple value " + std::to_string(info));
+            }
+    }
+}
+
+template<typename Decode>
+inline json decode_all(const uint8_t* data, size_t size, const char* format, Decode decode) {
+    Reader reader(data, size, format);
+    json result = decode(reader);
+    if (!reader.done()) reader.fail("trailing bytes after the value");
+    return result;
+}
+
+} // namespace binary_detail
+
+inline std::vector<uint8_t> to_msgpack(const json& j) {
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
+    if (!binary_detail::within_depth(j)) throw std::runtime_error("MessagePack: nesting too deep");
+    return json::to_msgpack(j);
+#else
+    binary_detail::Writer writer;
+    binary_detail::msgpack_encode(writer, j);
+    return std::move(writer.bytes);
+#endif
+}
+
+inline json from_msgpack(const uint8_t* data, size_t size) {
+    return binary_detail::decode_all(data, size, "MessagePack", binary_detail::msgpack_decode);
+}
+
+inline json from_msgpack(const std::vector<uint8_t>& bytes) {
+    return from_msgpack(bytes.data(), bytes.size());
+}
+
+inline std::vector<uint8_t> to_cbor(const json& j) {
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
+    if (!binary_detail::within_depth(j)) throw std::runtime_error("CBOR: nesting too deep");
+    return json::to_cbor(j);
+#else
+    binary_detail::Writer writer;
+    binary_detail::cbor_encode(writer, j);
+    return std::move(writer.bytes);
+#endif
+}
+
+inline json from_cbor(const uint8_t* data, size_t size) {
+    return binary_detail::decode_all(data, size, "CBOR", binary_detail::cbor_decode);
+}
+
+inline json from_cbor(const std::vector<uint8_t>& bytes) {
+    return from_cbor(bytes.data(), bytes.size());
+}
+
+JSON_ADAPTER_NAMESPACE_END
@@ -0,0 +1,617 @@
+/**
+ * @file json_mapped_store.h
+ * @brief Mutable JSON tree stored inside a memory-mapped file
+ *
+ * Every reference inside the file is an offset from the start of the mapping, so the file can be mapped
+ * at any address. The kernel owns the pages, so the resident set follows the working set rather than the
+ * document size. Opening walks the tree and the free lists once and checks every offset and length
+ * against the mapping, so a damaged file throws instead of sending reads out of bounds.
+ *
+ * Layout (native byte order, 8-byte aligned):
+ *   header   "OJMAP001" | u64 capacity | u64 root | u64 bump | u64 free list head[64]
+ *   block    u64 size class | node
+ *   scalar   tag | pad[7] | 8-byte int64 or double (nothing for null/false/true)
+ *   string   tag | pad[3] | u32 length | bytes
+ *   array    tag | pad[3] | u32 count | u32 capacity | pad[4] | u64 item[capacity]
+ *   object   tag | pad[3] | u32 count | u32 used | u32 capacity | {u64 hash, u64 key, u64 value}[capacity]
+ *            | u32 index[2 * capacity]
+ * Object entries stay in insertion order; the index is an open-addressing table of entry numbers + 1.
+ * A removed entry keeps its index slot with key 0, so probe chains stay intact until the next rebuild.
+ *
+ * Blocks are power-of-two sized, from 32 bytes up. Freed blocks go on the free list of their class and
+ * are reused before the file grows. Updates build the new value first and then switch one offset, or
+ * write past the counted end and then raise the count; a block is freed only once nothing refers to it.
+ * A process that dies mid-update therefore leaves a tree behind that opening accepts: at worst blocks
+ * leak, and an object's member count or index is left one step behind, which opening repairs. The file
+ * may also be longer than the recorded capacity if the process died while growing it. Surviving a
+ * machine crash as well needs sync() after the update.
+ *
+ * MappedStore is not thread-safe; MappedObservableJson puts a shared_mutex in front of it.
+ */
+
+#pragma once
+
+#include "universal_json_adapter.h"
+#include "json_binary.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSON_MAPPED_STORE_POSIX 1
+#endif
+
+JSON_ADAPTER_NAMESPACE_BEGIN
+
+namespace mapped_detail {
+
+inline constexpr char MAGIC[8] = {'O', 'J', 'M', 'A', 'P', '0', '0', '1'};
+
+enum Tag : uint8_t { TAG_NULL = 1, TAG_FALSE, TAG_TRUE, TAG_INT, TAG_DOUBLE, TAG_STRING, TAG_ARRAY, TAG_OBJECT };
+
+// Header fields
+inline constexpr uint64_t CAPACITY = 8;
+inline constexpr uint64_t ROOT = 16;
+inline constexpr uint64_t BUMP = 24;
+inline constexpr uint64_t FREE_LISTS = 32;
+inline constexpr size_t CLASSES = 64;
+inline constexpr uint64_t DATA_START = 1024;
+
+inline constexpr size_t MIN_CLASS = 5;          // 32-byte blocks
+inline constexpr uint64_t BLOCK_HEADER = 8;
+inline constexpr uint64_t ARRAY_ITEMS = 16;
+inline constexpr uint64_t OBJECT_ENTRIES = 16;
+inline constexpr uint64_t ENTRY_SIZE = 24;
+inline constexpr uint32_t MIN_CAPACITY = 4;
+
+// FNV-1a: stable across runs and platforms, which the stored index relies on
+inline uint64_t hash_key(std::string_view key) noexcept {
+    uint64_t h = 1469598103934665603ull;
+    for (unsigned char c : key) h = (h ^ c) * 1099511628211ull;
+    return h | 1;   // never 0
+}
+
+inline uint32_t grow_capacity(size_t needed) {
+    if (needed > (1u << 30)) throw std::length_error("Mapped store: container too large");
+    uint32_t capacity = MIN_CAPACITY;
+    while (capacity < needed) capacity <<= 1;
+    return capacity;
+}
+
+}  // namespace mapped_detail
+
+class MappedStore {
+public:
+    // Slot holding the root node's offset; pass it wherever a parent slot is expected
+    static constexpr uint64_t ROOT_SLOT = mapped_detail::ROOT;
+
+    // Open `file`, creating it with an empty object as root if it does not exist
+    explicit MappedStore(const std::string& file, uint64_t initial_capacity = 1 << 20) {
+#if JSON_MAPPED_STORE_POSIX
+        using namespace mapped_detail;
+        fd_ = ::open(file.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) throw std::runtime_error("Mapped store: cannot open " + file);
+        struct stat info {};
+        if (::fstat(fd_, &info) != 0) {
+            ::close(fd_);
+            throw std::runtime_error("Mapped store: cannot stat " + file);
+        }
+
+        if (info.st_size == 0) {
+            size_ = std::max<uint64_t>(initial_capacity, DATA_START + 4096);
+            if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+                ::close(fd_);
+                throw std::runtime_error("Mapped store: cannot size " + file);
+            }
+            map();
+            std::memcpy(base_, MAGIC, sizeof(MAGIC));
+            put<uint64_t>(CAPACITY, size_);
+            put<uint64_t>(BUMP, DATA_START);
+            put<uint64_t>(ROOT, new_object(0));
+        } else {
+            size_ = static_cast<uint64_t>(info.st_size);
+            if (size_ < DATA_START) {
+                ::close(fd_);
+                throw std::runtime_error("Mapped store: not a store: " + file);
+            }
+            map();
+            if (std::memcmp(base_, MAGIC, sizeof(MAGIC)) != 0 || get<uint64_t>(CAPACITY) > size_ ||
+                get<uint64_t>(BUMP) < DATA_START || get<uint64_t>(BUMP) > size_ || !check_and_repair()) {
+                unmap();
+                throw std::runtime_error("Mapped store: not a store or damaged: " + file);
+            }
+            put<uint64_t>(CAPACITY, size_);     // grow() extends the file before it records the new size
+        }
+#else
+        (void)file;
+        (void)initial_capacity;
+        throw std::runtime_error("Mapped store: memory-mapped files need a POSIX system");
+#endif
+    }
+
+    ~MappedStore() { unmap(); }
+
+    MappedStore(const MappedStore&) = delete;
+    MappedStore& operator=(const MappedStore&) = delete;
+
+    uint64_t root() const noexcept { return get<uint64_t>(ROOT_SLOT); }
+    uint64_t slot_value(uint64_t slot) const noexcept { return get<uint64_t>(slot); }
+    uint64_t file_size() const noexcept { return size_; }
+
+    // Bytes handed out so far, including blocks now on free lists
+    uint64_t used_bytes() const noexcept { return get<uint64_t>(mapped_detail::BUMP); }
+
+    // Write dirty pages back to the file (msync); needed only to survive a machine crash
+    void sync() {
+#if JSON_MAPPED_STORE_POSIX
+        if (::msync(base_, size_, MS_SYNC) != 0) throw std::runtime_error("Mapped store: sync failed");
+#endif
+    }
+
+    // ---- nodes ----
+
+    mapped_detail::Tag tag(uint64_t node) const noexcept { return static_cast<mapped_detail::Tag>(get<uint8_t>(node)); }
+    uint32_t count(uint64_t node) const noexcept { return get<uint32_t>(node + 4); }
+    int64_t as_int(uint64_t node) const noexcept { return get<int64_t>(node + 8); }
+    double as_double(uint64_t node) const noexcept { return get<double>(node + 8); }
+    std::string as_string(uint64_t node) const { return std::string(base_ + node + 8, count(node)); }
+
+    uint64_t store_null() { return scalar(mapped_detail::TAG_NULL); }
+    uint64_t store_bool(bool value) { return scalar(value ? mapped_detail::TAG_TRUE : mapped_detail::TAG_FALSE); }
+    uint64_t store_int(int64_t value) {
+        const uint64_t node = scalar(mapped_detail::TAG_INT);
+        put<int64_t>(node + 8, value);
+        return node;
+    }
+    uint64_t store_double(double value) {
+        const uint64_t node = scalar(mapped_detail::TAG_DOUBLE);
+        put<double>(node + 8, value);
+        return node;
+    }
+    uint64_t store_string(std::string_view text) {
+        if (text.size() > UINT32_MAX) throw std::length_error("Mapped store: string too long");
+        const uint64_t node = allocate(8 + text.size());
+        put<uint8_t>(node, mapped_detail::TAG_STRING);
+        put<uint32_t>(node + 4, static_cast<uint32_t>(text.size()));
+        std::memcpy(base_ + node + 8, text.data(), text.size());
+        return node;
+    }
+
+    // Copy a json value of any backend into the file
+    uint64_t store(const json& value) {
+        using Kind = binary_detail::Kind;
+        switch (binary_detail::kind_of(value)) {
+            case Kind::Bool: return store_bool(get_bool(value));
+            case Kind::Integer: {
+                const double d = get_double(value);
+                int64_t i = 0;
+                return binary_detail::as_integer(d, i) ? store_int(i) : store_double(d);
+            }
+            case Kind::Double: return store_double(get_double(value));
+            case Kind::String: return store_string(get_string(value));
+            case Kind::Array: {
+                const uint64_t node = new_array(array_size(value));
+                uint32_t n = 0;
+                for_each_element(value, [&](const json& item) {
+                    const uint64_t child = store(item);
+                    put<uint64_t>(node + mapped_detail::ARRAY_ITEMS + 8 * n++, child);
+                });
+                put<uint32_t>(node + 4, n);
+                return node;
+            }
+            case Kind::Object: {
+                uint64_t node = new_object(binary_detail::member_count(value));
+                for_each_member(value, [&](const std::string& key, const json& item) {
+                    const uint64_t child = store(item);
+                    insert_entry(node, key, child);
+                });
+                return node;
+            }
+            default: return store_null();
+        }
+    }
+
+    // Build the json value of a node (a deep copy out of the file)
+    json load(uint64_t node) const {
+        using namespace mapped_detail;
+        switch (tag(node)) {
+            case TAG_FALSE: return make_bool(false);
+            case TAG_TRUE: return make_bool(true);
+            case TAG_INT: return binary_detail::make_integer(as_int(node));
+            case TAG_DOUBLE: return make_double(as_double(node));
+            case TAG_STRING: return make_string(as_string(node));
+            case TAG_ARRAY: {
+                json result = make_array();
+                for (uint32_t i = 0, n = count(node); i < n; ++i) append_array(result, load(item(node, i)));
+                return result;
+            }
+            case TAG_OBJECT: {
+                json result = make_object();
+                for_each_entry(node, [&](uint64_t key, uint64_t value) { set_member(result, as_string(key), load(value)); });
+                return result;
+            }
+            default: return make_null();
+        }
+    }
+
+    // Free a node and everything below it
+    void destroy(uint64_t node) {
+        using namespace mapped_detail;
+        if (tag(node) == TAG_ARRAY) {
+            for (uint32_t i = 0, n = count(node); i < n; ++i) destroy(item(node, i));
+        } else if (tag(node) == TAG_OBJECT) {
+            for_each_entry(node, [&](uint64_t key, uint64_t value) {
+                release(key);
+                destroy(value);
+            });
+        }
+        release(node);
+    }
+
+    // ---- containers: slots are offsets of the u64 that references a node ----
+
+    uint64_t item(uint64_t array, uint32_t index) const noexcept {
+        return get<uint64_t>(item_slot(array, index));
+    }
+
+    uint64_t item_slot(uint64_t array, uint32_t index) const noexcept {
+        return array + mapped_detail::ARRAY_ITEMS + 8ull * index;
+    }
+
+    // Append to the array referenced by `array_slot`; the array may move, and the slot is updated
+    void append(uint64_t array_slot, uint64_t value) {
+        uint64_t array = get<uint64_t>(array_slot);
+        const uint32_t n = count(array);
+        if (n == get<uint32_t>(array + 8)) {
+            const uint64_t grown = new_array(static_cast<size_t>(n) * 2);
+            array = get<uint64_t>(array_slot);      // allocation may have remapped, offsets stay valid
+            std::memcpy(base_ + grown + mapped_detail::ARRAY_ITEMS, base_ + array + mapped_detail::ARRAY_ITEMS, 8ull * n);
+            put<uint32_t>(grown + 4, n);
+            put<uint64_t>(array_slot, grown);
+            release(array);
+            array = grown;
+        }
+        put<uint64_t>(item_slot(array, n), value);
+        put<uint32_t>(array + 4, n + 1);
+    }
+
+    // Remove item `index` of the array referenced by `array_slot`; returns the removed node for the caller
+    // to destroy. The rest is copied into a new array, because shifting in place would leave an item
+    // referenced twice if the process died halfway.
+    uint64_t erase_item(uint64_t array_slot, uint32_t index) {
+        const uint32_t n = count(get<uint64_t>(array_slot));
+        const uint64_t rebuilt = new_array(n - 1);
+        const uint64_t array = get<uint64_t>(array_slot);     // allocation may have remapped, offsets stay valid
+        const uint64_t removed = item(array, index);
+        std::memcpy(base_ + item_slot(rebuilt, 0), base_ + item_slot(array, 0), 8ull * index);
+        std::memcpy(base_ + item_slot(rebuilt, index), base_ + item_slot(array, index + 1), 8ull * (n - index - 1));
+        put<uint32_t>(rebuilt + 4, n - 1);
+        put<uint64_t>(array_slot, rebuilt);
+        release(array);
+        return removed;
+    }
+
+    // Slot of member `key`'s value, if present
+    std::optional<uint64_t> member_slot(uint64_t object, std::string_view key) const {
+        const uint64_t h = mapped_detail::hash_key(key);
+        const uint32_t capacity = get<uint32_t>(object + 12);
+        const uint32_t mask = capacity * 2 - 1;
+        const uint64_t index = object + mapped_detail::OBJECT_ENTRIES + mapped_detail::ENTRY_SIZE * capacity;
+        for (uint32_t i = static_cast<uint32_t>(h) & mask;; i = (i + 1) & mask) {
+            const uint32_t slot = get<uint32_t>(index + 4ull * i);
+            if (slot == 0) return std::nullopt;
+            const uint64_t entry = entry_at(object, slot - 1);
+            const uint64_t entry_key = get<uint64_t>(entry + 8);
+            if (entry_key != 0 && get<uint64_t>(entry) == h && count(entry_key) == key.size() &&
+                std::memcmp(base_ + entry_key + 8, key.data(), key.size()) == 0) {
+                return entry + 16;
+            }
+        }
+    }
+
+    // Add member `key` (which must be absent) to the object referenced by `object_slot`; the object may move
+    void insert(uint64_t object_slot, std::string_view key, uint64_t value) {
+        uint64_t object = get<uint64_t>(object_slot);
+        if (get<uint32_t>(object + 8) == get<uint32_t>(object + 12)) {
+            const uint64_t rebuilt = new_object(static_cast<size_t>(count(object)) * 2);
+            object = get<uint64_t>(object_slot);
+            for (uint32_t i = 0, used = get<uint32_t>(object + 8); i < used; ++i) {
+                const uint64_t entry = entry_at(object, i);
+                const uint64_t entry_key = get<uint64_t>(entry + 8);
+                if (entry_key != 0) place_entry(rebuilt, get<uint64_t>(entry), entry_key, get<uint64_t>(entry + 16));
+            }
+            put<uint64_t>(object_slot, rebuilt);
+            release(object);
+            object = rebuilt;
+        }
+        const uint64_t key_node = store_string(key);
+        object = get<uint64_t>(object_slot);
+        place_entry(object, mapped_detail::hash_key(key), key_node, value);
+    }
+
+    // Remove member `key`; returns its value node for the caller to destroy
+    std::optional<uint64_t> erase(uint64_t object, std::string_view key) {
+        const auto slot = member_slot(object, key);
+        if (!slot) return std::nullopt;
+        const uint64_t entry = *slot - 16;
+        const uint64_t value = get<uint64_t>(*slot);
+        const uint64_t key_node = get<uint64_t>(entry + 8);
+        put<uint64_t>(entry + 8, 0);
+        put<uint32_t>(object + 4, count(object) - 1);
+        release(key_node);
+        return value;
+    }
+
+    // fn(key node, value node) for each member in insertion order
+    template<typename Fn>
+    void for_each_entry(uint64_t object, Fn&& fn) const {
+        for (uint32_t i = 0, used = get<uint32_t>(object + 8); i < used; ++i) {
+            const uint64_t entry = entry_at(object, i);
+            const uint64_t key = get<uint64_t>(entry + 8);
+            if (key != 0) fn(key, get<uint64_t>(entry + 16));
+        }
+    }
+
+    uint64_t new_object(size_t expected_members) {
+        using namespace mapped_detail;
+        const uint32_t capacity = grow_capacity(expected_members);
+        const uint64_t node = allocate(OBJECT_ENTRIES + ENTRY_SIZE * capacity + 8ull * capacity);
+        put<uint8_t>(node, TAG_OBJECT);
+        put<uint32_t>(node + 4, 0);
+        put<uint32_t>(node + 8, 0);
+        put<uint32_t>(node + 12, capacity);
+        std::memset(base_ + node + OBJECT_ENTRIES + ENTRY_SIZE * capacity, 0, 8ull * capacity);
+        return node;
+    }
+
+    // A new object whose only member is `key`: `value`
+    uint64_t new_object(std::string_view key, uint64_t value) {
+        const uint64_t object = new_object(1);
+        try {
+            insert_entry(object, key, value);
+        } catch (...) {
+            release(object);
+            throw;
+        }
+        return object;
+    }
+
+    uint64_t new_array(size_t expected_items) {
+        using namespace mapped_detail;
+        const uint32_t capacity = grow_capacity(expected_items);
+        const uint64_t node = allocate(ARRAY_ITEMS + 8ull * capacity);
+        put<uint8_t>(node, TAG_ARRAY);
+        put<uint32_t>(node + 4, 0);
+        put<uint32_t>(node + 8, capacity);
+        return node;
+    }
+
+    void set_slot(uint64_t slot, uint64_t node) noexcept { put<uint64_t>(slot, node); }
+
+private:
+    char* base_ = nullptr;
+    uint64_t size_ = 0;
+    int fd_ = -1;
+
+    template<typename T>
+    T get(uint64_t offset) const noexcept {
+        T value;
+        std::memcpy(&value, base_ + offset, sizeof(T));
+        return value;
+    }
+
+    template<typename T>
+    void put(uint64_t offset, T value) noexcept {
+        std::memcpy(base_ + offset, &value, sizeof(T));
+    }
+
+    uint64_t entry_at(uint64_t object, uint32_t i) const noexcept {
+        return object + mapped_detail::OBJECT_ENTRIES + mapped_detail::ENTRY_SIZE * i;
+    }
+
+    // Append an entry and index it; the object has room. The entry is written past `used` first; a crash
+    // before the counts are raised leaves an index slot or a count behind, which check_and_repair() fixes.
+    void place_entry(uint64_t object, uint64_t h, uint64_t key, uint64_t value) {
+        const uint32_t used = get<uint32_t>(object + 8);
+        const uint32_t capacity = get<uint32_t>(object + 12);
+        const uint64_t entry = entry_at(object, used);
+        put<uint64_t>(entry, h);
+        put<uint64_t>(entry + 8, key);
+        put<uint64_t>(entry + 16, value);
+        const uint32_t mask = capacity * 2 - 1;
+        const uint64_t index = object + mapped_detail::OBJECT_ENTRIES + mapped_detail::ENTRY_SIZE * capacity;
+        uint32_t i = static_cast<uint32_t>(h) & mask;
+        while (get<uint32_t>(index + 4ull * i) != 0) i = (i + 1) & mask;
+        put<uint32_t>(index + 4ull * i, used + 1);
+        put<uint32_t>(object + 8, used + 1);
+        put<uint32_t>(object + 4, count(object) + 1);
+    }
+
+    // Used while filling a fresh object from json: it was sized for all members
+    void insert_entry(uint64_t object, std::string_view key, uint64_t value) {
+        const uint64_t key_node = store_string(key);
+        place_entry(object, mapped_detail::hash_key(key), key_node, value);
+    }
+
+    uint64_t scalar(mapped_detail::Tag t) {
+        const uint64_t node = allocate(16);
+        put<uint8_t>(node, t);
+        return node;
+    }
+
+    // Opening: every node reachable from the root must lie inside one allocated block, be referenced once
+    // and not be on a free list; free lists must stay inside the file. Member counts and object indexes an
+    // interrupted place_entry() or erase() left behind are brought back in line with the entries.
+    bool check_and_repair() {
+        using namespace mapped_detail;
+        const uint64_t bump = get<uint64_t>(BUMP);
+        // Node of at least `bytes` bytes, inside a block below the bump pointer
+        auto fits = [&](uint64_t node, uint64_t bytes) {
+            if (node < DATA_START + BLOCK_HEADER || node % 8 != 0 || node >= bump) return false;
+            const uint64_t cls = get<uint64_t>(node - BLOCK_HEADER);
+            if (cls < MIN_CLASS || cls >= CLASSES || (uint64_t(1) << cls) > bump) return false;
+            return node - BLOCK_HEADER + (uint64_t(1) << cls) <= bump && bytes <= (uint64_t(1) << cls) - BLOCK_HEADER;
+        };
+
+        std::unordered_set<uint64_t> seen;
+        std::vector<uint64_t> pending{get<uint64_t>(ROOT)};
+        while (!pending.empty()) {
+            const uint64_t node = pending.back();
+            pending.pop_back();
+            if (!fits(node, 16) || !seen.insert(node).second) return false;
+            switch (tag(node)) {
+                case TAG_NULL: case TAG_FALSE: case TAG_TRUE: case TAG_INT: case TAG_DOUBLE:
+                    break;
+                case TAG_STRING:
+                    if (!fits(node, 8ull + count(node))) return false;
+                    break;
+                case TAG_ARRAY: {
+                    const uint32_t capacity = get<uint32_t>(node + 8);
+                    if (count(node) > capacity || !fits(node, ARRAY_ITEMS + 8ull * capacity)) return false;
+                    for (uint32_t i = 0, n = count(node); i < n; ++i) pending.push_back(item(node, i));
+                    break;
+                }
+                case TAG_OBJECT: {
+                    const uint32_t used = get<uint32_t>(node + 8);
+                    const uint32_t capacity = get<uint32_t>(node + 12);
+                    if (capacity == 0 || (capacity & (capacity - 1)) != 0 || capacity > (1u << 30) || used > capacity ||
+                        !fits(node, OBJECT_ENTRIES + ENTRY_SIZE * capacity + 8ull * capacity)) {
+                        return false;
+                    }
+                    uint32_t live = 0;
+                    for (uint32_t i = 0; i < used; ++i) {
+                        const uint64_t entry = entry_at(node, i);
+                        const uint64_t key = get<uint64_t>(entry + 8);
+                        if (key == 0) continue;
+                        if (!fits(key, 16) || tag(key) != TAG_STRING || !fits(key, 8ull + count(key)) ||
+                            !seen.insert(key).second) {
+                            return false;
+                        }
+                        pending.push_back(get<uint64_t>(entry + 16));
+                        ++live;
+                    }
+                    if (count(node) != live) put<uint32_t>(node + 4, live);
+
+                    // Each entry below `used` owns exactly one index slot; anything else is rebuilt
+                    const uint64_t index = node + OBJECT_ENTRIES + ENTRY_SIZE * capacity;
+                    uint32_t slots = 0;
+                    bool stray = false;
+                    for (uint32_t i = 0; i < capacity * 2; ++i) {
+                        const uint32_t slot = get<uint32_t>(index + 4ull * i);
+                        if (slot != 0) ++slots;
+                        if (slot > used) stray = true;
+                    }
+                    if (stray || slots != used) {
+                        std::memset(base_ + index, 0, 8ull * capacity);
+                        put<uint32_t>(node + 8, 0);
+                        put<uint32_t>(node + 4, 0);
+                        for (uint32_t i = 0; i < used; ++i) {
+                            const uint64_t entry = entry_at(node, i);
+                            place_entry(node, get<uint64_t>(entry), get<uint64_t>(entry + 8), get<uint64_t>(entry + 16));
+                        }
+                        put<uint32_t>(node + 4, live);
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+
+        // Free blocks: inside the file, of their list's class, and not also in the tree
+        for (size_t cls = 0; cls < CLASSES; ++cls) {
+            for (uint64_t block = get<uint64_t>(FREE_LISTS + 8 * cls); block != 0;
+                 block = get<uint64_t>(block + BLOCK_HEADER)) {
+                if (cls < MIN_CLASS || !fits(block + BLOCK_HEADER, 8) || get<uint64_t>(block) != cls ||
+                    !seen.insert(block + BLOCK_HEADER).second) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // ---- allocator ----
+
+    uint64_t allocate(uint64_t bytes) {
+        using namespace mapped_detail;
+        size_t cls = MIN_CLASS;
+        while ((uint64_t(1) << cls) < bytes + BLOCK_HEADER) ++cls;
+        const uint64_t head_slot = FREE_LISTS + 8 * cls;
+        uint64_t block = get<uint64_t>(head_slot);
+        if (block != 0) {
+            put<uint64_t>(head_slot, get<uint64_t>(block + BLOCK_HEADER));
+        } else {
+            const uint64_t block_size = uint64_t(1) << cls;
+            block = get<uint64_t>(BUMP);
+            if (block + block_size > size_) grow(block + block_size);
+            put<uint64_t>(BUMP, block + block_size);
+        }
+        put<uint64_t>(block, cls);
+        return block + BLOCK_HEADER;
+    }
+
+    void release(uint64_t node) noexcept {
+        using namespace mapped_detail;
+        const uint64_t block = node - BLOCK_HEADER;
+        const uint64_t head_slot = FREE_LISTS + 8 * get<uint64_t>(block);
+        put<uint64_t>(node, get<uint64_t>(head_slot));
+        put<uint64_t>(head_slot, block);
+    }
+
+    void grow(uint64_t needed) {
+#if JSON_MAPPED_STORE_POSIX
+        uint64_t capacity = std::max(size_ * 2, needed);
+        capacity = (capacity + 4095) / 4096 * 4096;
+        if (::ftruncate(fd_, static_cast<off_t>(capacity)) != 0) throw std::runtime_error("Mapped store: cannot grow file");
+#if defined(__linux__)
+        void* moved = ::mremap(base_, size_, capacity, MREMAP_MAYMOVE);
+        if (moved == MAP_FAILED) throw std::runtime_error("Mapped store: cannot remap");
+        base_ = static_cast<char*>(moved);
+        size_ = capacity;
+#else
+        ::munmap(base_, size_);
+        size_ = capacity;
+        map();
+#endif
+        put<uint64_t>(mapped_detail::CAPACITY, size_);
+#else
+        (void)needed;
+#endif
+    }
+
+    void map() {
+#if JSON_MAPPED_STORE_POSIX
+        void* mapped = ::mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapped == MAP_FAILED) {
+            base_ = nullptr;
+            ::close(fd_);
+            fd_ = -1;
+            throw std::runtime_error("Mapped store: cannot map file");
+        }
+        base_ = static_cast<char*>(mapped);
+#endif
+    }
+
+    void unmap() noexcept {
+#if JSON_MAPPED_STORE_POSIX
+        if (base_) ::munmap(base_, size_);
+        if (fd_ >= 0) ::close(fd_);
+#endif
+        base_ = nullptr;
+        fd_ = -1;
+    }
+};
+
+JSON_ADAPTER_NAMESPACE_END
@@ -0,0 +1,516 @@
+/**
+ * @file json_patch.h
+ * @brief JSON Patch (RFC 6902) generation and application on top of the universal adapter
+ *
+ * diff() walks two documents side by side and emits add/remove/replace operations for the parts that
+ * differ. Subtrees the backends can prove identical without looking inside (AxzDict copies share their
+ * nodes) are skipped in O(1); everything else is compared in a single pass with no serialization.
+ * apply_patch() applies all six RFC 6902 operations in place and is atomic: a failing operation leaves
+ * the document as it was.
+ */
+
+#pragma once
+
+#include "universal_json_adapter.h"
+
+#if JSON_ADAPTER_BACKEND == JSON11 || JSON_ADAPTER_BACKEND == RAPIDJSON
+    #error "json_patch.h needs the nlohmann, JsonCpp or AxzDict backend"
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+JSON_ADAPTER_NAMESPACE_BEGIN
+
+struct PatchOperation {
+    enum class Op : uint8_t { Add, Remove, Replace, Move, Copy, Test };
+
+    Op op = Op::Add;
+    std::string path;   // JSON Pointer (RFC 6901) of the target
+    json value;         // add, replace and test
+    std::string from;   // move and copy
+};
+
+using JsonPatch = std::vector<PatchOperation>;
+
+inline const char* patch_op_name(PatchOperation::Op op) noexcept {
+    switch (op) {
+        case PatchOperation::Op::Add:     return "add";
+        case PatchOperation::Op::Remove:  return "remove";
+        case PatchOperation::Op::Replace: return "replace";
+        case PatchOperation::Op::Move:    return "move";
+        case PatchOperation::Op::Copy:    return "copy";
+        default:                          return "test";
+    }
+}
+
+namespace patch_detail {
+
+inline size_t member_count(const json& obj) {
+    size_t count = 0;
+    for_each_member(obj, [&count](const std::string&, const json&) { ++count; });
+    return count;
+}
+
+// Identity check: true only when equality is known without comparing contents
+inline bool same_value(const json& a, const json& b) noexcept {
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    return &a == &b || a.sharesValue(b);
+#else
+    return &a == &b;
+#endif
+}
+
+inline void append_escaped(std::string& pointer, std::string_view token) {
+    pointer += '/';
+    for (char c : token) {
+        if (c == '~') pointer += "~0";
+        else if (c == '/') pointer += "~1";
+        else pointer += c;
+    }
+}
+
+inline std::vector<std::string> split_pointer(const std::string& pointer) {
+    std::vector<std::string> tokens;
+    if (pointer.empty()) return tokens;
+    if (pointer[0] != '/') {
+        throw std::invalid_argument("JSON patch: pointer must start with '/': " + pointer);
+    }
+
+    std::string token;
+    for (size_t i = 1; i <= pointer.size(); ++i) {
+        if (i == pointer.size() || pointer[i] == '/') {
+            tokens.push_back(std::move(token));
+            token.clear();
+        } else if (pointer[i] == '~') {
+            const char next = i + 1 < pointer.size() ? pointer[i + 1] : '\0';
+            if (next != '0' && next != '1') {
+                throw std::invalid_argument("JSON patch: bad escape in pointer: " + pointer);
+            }
+            token += next == '0' ? '~' : '/';
+            ++i;
+        } else {
+            token += pointer[i];
+        }
+    }
+    return tokens;
+}
+
+// "-" (append) is accepted only where the operation adds an element
+inline size_t parse_index(const std::string& token, size_t size, bool allow_end) {
+    if (allow_end && token == "-") return size;
+
+    const bool digits = !token.empty() && token.size() <= 18 &&
+                        std::all_of(token.begin(), token.end(), [](char c) { return c >= '0' && c <= '9'; });
+    if (!digits || (token.size() > 1 && token[0] == '0')) {
+        throw std::invalid_argument("JSON patch: bad array index: " + token);
+    }
+
+    const size_t index = static_cast<size_t>(std::stoull(token));
+    if (index > size || (index == size && !allow_end)) {
+        throw std::out_of_range("JSON patch: array index out of bounds: " + token);
+    }
+    return index;
+}
+
+inline bool scalar_equal(const json& a, const json& b) {
+    if (is_null(a) || is_null(b)) return is_null(a) && is_null(b);
+    if (is_bool(a) || is_bool(b)) return is_bool(a) && is_bool(b) && get_bool(a) == get_bool(b);
+    if (is_number(a) || is_number(b)) return is_number(a) && is_number(b) && get_double(a) == get_double(b);
+    if (is_string(a) || is_string(b)) return is_string(a) && is_string(b) && get_string(a) == get_string(b);
+    return dump(a) == dump(b);  // backend-specific kinds such as AxzDict bytes
+}
+
+} // namespace patch_detail
+
+// Structural equality. Numbers compare by value, so 1 and 1.0 are equal.
+inline bool values_equal(const json& a, const json& b) {
+    if (patch_detail::same_value(a, b)) return true;
+
+    if (is_object(a) || is_object(b)) {
+        if (!is_object(a) || !is_object(b)) return false;
+
+        bool equal = true;
+        size_t count = 0;
+        for_each_member(a, [&](const std::string& key, const json& value) {
+            if (!equal) return;
+            ++count;
+            auto other = find_member(b, key);
+            equal = other && values_equal(value, *other);
+        });
+        return equal && count == patch_detail::member_count(b);
+    }
+
+    if (is_array(a) || is_array(b)) {
+        if (!is_array(a) || !is_array(b) || array_size(a) != array_size(b)) return false;
+        for (size_t i = 0, n = array_size(a); i < n; ++i) {
+            if (!values_equal(element(a, i), element(b, i))) return false;
+        }
+        return true;
+    }
+
+    return patch_detail::scalar_equal(a, b);
+}
+
+namespace patch_detail {
+
+inline void diff_into(const json& from, const json& to, std::string& pointer, JsonPatch& out) {
+    if (same_value(from, to)) return;
+
+    const size_t base = pointer.size();
+
+    if (is_object(from) && is_object(to)) {
+        // Removals first so every later operation sees the keys it expects
+        for_each_member(from, [&](const std::string& key, const json&) {
+            if (!find_member(to, key)) {
+                append_escaped(pointer, key);
+                out.push_back({PatchOperation::Op::Remove, pointer, make_null(), {}});
+                pointer.resize(base);
+            }
+        });
+        for_each_member(to, [&](const std::string& key, const json& value) {
+            append_escaped(pointer, key);
+            if (auto previous = find_member(from, key)) {
+                diff_into(*previous, value, pointer, out);
+            } else {
+                out.push_back({PatchOperation::Op::Add, pointer, value, {}});
+            }
+            pointer.resize(base);
+        });
+        return;
+    }
+
+    if (is_array(from) && is_array(to)) {
+        // Element-wise over the common prefix, then trim or extend the tail.
+        // The tail is removed from the back so the indices of the earlier operations stay valid.
+        const size_t from_size = array_size(from);
+        const size_t to_size = array_size(to);
+        const size_t common = std::min(from_size, to_size);
+        for (size_t i = 0; i < common; ++i) {
+            append_escaped(pointer, std::to_string(i));
+            diff_into(element(from, i), element(to, i), pointer, out);
+            pointer.resize(base);
+        }
+        for (size_t i = from_size; i-- > to_size;) {
+            append_escaped(pointer, std::to_string(i));
+            out.push_back({PatchOperation::Op::Remove, pointer, make_null(), {}});
+            pointer.resize(base);
+        }
+        for (size_t i = from_size; i < to_size; ++i) {
+            append_escaped(pointer, std::to_string(i));
+            out.push_back({PatchOperation::Op::Add, pointer, element(to, i), {}});
+            pointer.resize(base);
+        }
+        return;
+    }
+
+    if (!values_equal(from, to)) {
+        out.push_back({PatchOperation::Op::Replace, pointer, to, {}});
+    }
+}
+
+// Calls fn(value) for the value at tokens[depth..] without copying it
+template<typename Fn>
+inline void visit_at(const json& node, const std::vector<std::string>& tokens, size_t depth, Fn&& fn) {
+    if (depth == tokens.size()) {
+        fn(node);
+        return;
+    }
+
+    const std::string& token = tokens[depth];
+    if (is_object(node)) {
+        auto child = find_member(node, token);
+        if (!child) throw std::out_of_range("JSON patch: path not found: " + token);
+        visit_at(*child, tokens, depth + 1, fn);
+        return;
+    }
+    if (is_array(node)) {
+        visit_at(element(node, parse_index(token, array_size(node), false)), tokens, depth + 1, fn);
+        return;
+    }
+    throw std::out_of_range("JSON patch: path not found: " + token);
+}
+
+inline json value_at(const json& node, const std::vector<std::string>& tokens) {
+    json result;
+    visit_at(node, tokens, 0, [&result](const json& value) { result = value; });
+    return result;
+}
+
+inline bool contains_at(const json& node, const std::vector<std::string>& tokens) {
+    try {
+        visit_at(node, tokens, 0, [](const json&) {});
+        return true;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+// Calls fn(parent, last token) on the container holding tokens.back(), reached in place
+template<typename Fn>
+inline void with_parent(json& node, const std::vector<std::string>& tokens, size_t depth, Fn&& fn) {
+    const std::string& token = tokens[depth];
+    if (depth + 1 == tokens.size()) {
+        fn(node, token);
+        return;
+    }
+
+    if (is_object(node)) {
+        if (!has_key(node, token)) throw std::out_of_range("JSON patch: path not found: " + token);
+        with_member(node, token, [&](json& child) { with_parent(child, tokens, depth + 1, fn); });
+        return;
+    }
+    if (is_array(node)) {
+        const size_t index = parse_index(token, array_size(node), false);
+        with_element(node, index, [&](json& child) { with_parent(child, tokens, depth + 1, fn); });
+        return;
+    }
+    throw std::out_of_range("JSON patch: path not found: " + token);
+}
+
+// The inverse of an edit already made: Add puts `value` back, Replace restores it, Remove drops what
+// the edit added. `carried` steps take their value from the step undone just before them (a move).
+struct UndoStep {
+    PatchOperation::Op op = PatchOperation::Op::Remove;
+    std::vector<std::string> tokens;
+    json value;
+    bool carried = false;
+};
+
+// Add, remove or replace at `tokens` in place. Throws before changing anything when the target is
+// missing; otherwise returns the step that undoes the edit, holding the value it displaced.
+inline UndoStep edit(json& root, const std::vector<std::string>& tokens, PatchOperation::Op op, json value) {
+    using Op = PatchOperation::Op;
+    UndoStep undo;
+    undo.tokens = tokens;
+
+    if (tokens.empty()) {
+        if (op == Op::Remove) {
+            throw std::invalid_argument("JSON patch: cannot remove the whole document");
+        }
+        std::swap(root, value);
+        undo.op = Op::Replace;
+        undo.value = std::move(value);
+        return undo;
+    }
+
+    with_parent(root, tokens, 0, [&](json& parent, const std::string& token) {
+        if (is_object(parent)) {
+            if (!has_key(parent, token)) {
+                if (op != Op::Add) throw std::out_of_range("JSON patch: path not found: " + token);
+                set_member(parent, token, value);
+                undo.op = Op::Remove;
+                return;
+            }
+            with_member(parent, token, [&](json& child) {
+                undo.value = std::move(child);
+                if (op != Op::Remove) child = std::move(value);
+            });
+            if (op == Op::Remove) remove_member(parent, token);
+            undo.op = op == Op::Remove ? Op::Add : Op::Replace;
+            return;
+        }
+
+        if (is_array(parent)) {
+            const size_t index = parse_index(token, array_size(parent), op == Op::Add);
+            undo.tokens.back() = std::to_string(index);  // resolves "-"
+            if (op == Op::Add) {
+                insert_element(parent, index, std::move(value));
+                undo.op = Op::Remove;
+                return;
+            }
+            with_element(parent, index, [&](json& child) {
+                undo.value = std::move(child);
+                if (op == Op::Replace) child = std::move(value);
+            });
+            if (op == Op::Remove) erase_element(parent, index);
+            undo.op = op == Op::Remove ? Op::Add : Op::Replace;
+            return;
+        }
+
+        throw std::out_of_range("JSON patch: path not found: " + token);
+    });
+    return undo;
+}
+
+// Undone in reverse order, every step finds the path its edit left behind, so only running out of memory
+// can stop one; that step is skipped and the rest are still undone
+inline void undo_all(json& root, std::vector<UndoStep>& undo) noexcept {
+    json carried = make_null();
+    for (auto step = undo.rbegin(); step != undo.rend(); ++step) {
+        try {
+            json value = step->carried ? std::move(carried) : std::move(step->value);
+            carried = edit(root, step->tokens, step->op, std::move(value)).value;
+        } catch (const std::bad_alloc&) {
+            carried = make_null();
+        }
+    }
+}
+
+} // namespace patch_detail
+
+// Operations that turn `from` into `to`, in application order
+inline JsonPatch diff(const json& from, const json& to) {
+    JsonPatch patch;
+    std::string pointer;
+    patch_detail::diff_into(from, to, pointer, patch);
+    return patch;
+}
+
+// Apply `patch` to `document` in place; throws std::invalid_argument for malformed operations,
+// std::out_of_range for missing targets and std::runtime_error for a failed "test".
+// Pointers and the leading "test" operations are checked before anything changes; after that each edit
+// logs its inverse, and a failure replays the log so the document holds the same values as before (a restored
+// member of an AxzDict object moves to the end). Only the touched containers are modified; AxzDict copies
+// that share them see the change, as with set().
+inline void apply_patch(json& document, const JsonPatch& patch) {
+    using Op = PatchOperation::Op;
+
+    std::vector<std::vector<std::string>> paths;
+    std::vector<std::vector<std::string>> sources;
+    paths.reserve(patch.size());
+    sources.reserve(patch.size());
+    for (const auto& operation : patch) {
+        paths.push_back(patch_detail::split_pointer(operation.path));
+        sources.push_back(operation.op == Op::Move || operation.op == Op::Copy
+                              ? patch_detail::split_pointer(operation.from)
+                              : std::vector<std::string>{});
+        const auto& tokens = paths.back();
+        const auto& source = sources.back();
+        if (operation.op == Op::Move && tokens.size() > source.size() &&
+            std::equal(source.begin(), source.end(), tokens.begin())) {
+            throw std::invalid_argument("JSON patch: cannot move a value into itself: " + operation.path);
+        }
+    }
+
+    auto test = [&document](const PatchOperation& operation, const std::vector<std::string>& tokens) {
+        bool equal = false;
+        patch_detail::visit_at(document, tokens, 0,
+                               [&](const json& value) { equal = values_equal(value, operation.value); });
+        if (!equal) throw std::runtime_error("JSON patch: test failed at " + operation.path);
+    };
+
+    size_t first_edit = 0;
+    for (; first_edit < patch.size() && patch[first_edit].op == Op::Test; ++first_edit) {
+        test(patch[first_edit], paths[first_edit]);
+    }
+
+    std::vector<patch_detail::UndoStep> undo;
+    try {
+        for (size_t i = first_edit; i < patch.size(); ++i) {
+            const auto& operation = patch[i];
+            const auto& tokens = paths[i];
+            switch (operation.op) {
+                case Op::Add:
+                case Op::Replace:
+                case Op::Remove:
+                    undo.push_back(patch_detail::edit(document, tokens, operation.op,
+                                                      operation.op == Op::Remove ? make_null()
+                                                                                 : snapshot(operation.value)));
+                    break;
+                case Op::Move: {
+                    if (sources[i] == tokens) {
+                        patch_detail::visit_at(document, tokens, 0, [](const json&) {});  // must exist
+                        break;
+                    }
+                    auto taken = patch_detail::edit(document, sources[i], Op::Remove, make_null());
+                    json value = std::move(taken.value);
+                    taken.carried = true;
+                    undo.push_back(std::move(taken));
+                    undo.push_back(patch_detail::edit(document, tokens, Op::Add, std::move(value)));
+                    break;
+                }
+                case Op::Copy: {
+                    json value;
+                    patch_detail::visit_at(document, sources[i], 0, [&value](const json& found) { value = snapshot(found); });
+                    undo.push_back(patch_detail::edit(document, tokens, Op::Add, std::move(value)));
+                    break;
+                }
+                case Op::Test:
+                    test(operation, tokens);
+                    break;
+            }
+        }
+    } catch (...) {
+        patch_detail::undo_all(document, undo);
+        throw;
+    }
+}
+
+// Result of applying `patch` to a copy of `document`, which is left untouched
+inline json patched(const json& document, const JsonPatch& patch) {
+    json result = snapshot(document);
+    apply_patch(result, patch);
+    return result;
+}
+
+// RFC 6902 wire form: an array of {"op", "path", "value" | "from"} objects
+inline json patch_to_json(const JsonPatch& patch) {
+    using Op = PatchOperation::Op;
+    json result = make_array();
+    for (const auto& operation : patch) {
+        json entry = make_object();
+        set_member(entry, "op", make_string(patch_op_name(operation.op)));
+        set_member(entry, "path", make_string(operation.path));
+        if (operation.op == Op::Move || operation.op == Op::Copy) {
+            set_member(entry, "from", make_string(operation.from));
+        } else if (operation.op != Op::Remove) {
+            set_member(entry, "value", operation.value);
+        }
+        append_array(result, entry);
+    }
+    return result;
+}
+
+inline JsonPatch patch_from_json(const json& document) {
+    using Op = PatchOperation::Op;
+    if (!is_array(document)) {
+        throw std::invalid_argument("JSON patch: document must be an array");
+    }
+
+    auto required_string = [](const json& entry, const char* name) {
+        if (!has_key(entry, name) || !is_string(object_at(entry, name))) {
+            throw std::invalid_argument(std::string("JSON patch: operation needs a string \"") + name + "\"");
+        }
+        return get_string(object_at(entry, name));
+    };
+
+    JsonPatch patch;
+    patch.reserve(array_size(document));
+    for (size_t i = 0, n = array_size(document); i < n; ++i) {
+        const json entry = array_at(document, i);
+        if (!is_object(entry)) {
+            throw std::invalid_argument("JSON patch: operation must be an object");
+        }
+
+        const std::string name = required_string(entry, "op");
+        PatchOperation operation;
+        if (name == "add") operation.op = Op::Add;
+        else if (name == "remove") operation.op = Op::Remove;
+        else if (name == "replace") operation.op = Op::Replace;
+        else if (name == "move") operation.op = Op::Move;
+        else if (name == "copy") operation.op = Op::Copy;
+        else if (name == "test") operation.op = Op::Test;
+        else throw std::invalid_argument("JSON patch: unknown operation: " + name);
+
+        operation.path = required_string(entry, "path");
+        if (operation.op == Op::Move || operation.op == Op::Copy) {
+            operation.from = required_string(entry, "from");
+        } else if (operation.op != Op::Remove) {
+            if (!has_key(entry, "value")) {
+                throw std::invalid_argument("JSON patch: \"" + name + "\" needs a value");
+            }
+            operation.value = object_at(entry, "value");
+        }
+        patch.push_back(std::move(operation));
+    }
+    return patch;
+}
+
+JSON_ADAPTER_NAMESPACE_END
@@ -0,0 +1,270 @@
+/**
+ * @file json_simd.h
+ * @brief Runtime-dispatched byte scanning kernels for the adapter and the observable layer
+ *
+ * Every kernel is compiled for SSE2, AVX2 and AVX-512 (plus a portable scalar version) regardless of
+ * the -march the binary is built with. The widest variant the running CPU supports is picked once,
+ * on first use, and reached through a function-pointer table - one binary runs on the whole fleet.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(JSON_HAS_SIMD) && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define JSON_SIMD_DISPATCH 1
+#define JSON_SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+namespace json_adapter {
+namespace simd {
+
+enum class Isa : uint8_t { Scalar, SSE2, AVX2, AVX512 };
+
+inline const char* isa_name(Isa isa) noexcept {
+    switch (isa) {
+        case Isa::SSE2:   return "sse2";
+        case Isa::AVX2:   return "avx2";
+        case Isa::AVX512: return "avx512";
+        default:          return "scalar";
+    }
+}
+
+// All scans return the index of the first match, or len when there is none
+struct Kernels {
+    Isa isa;
+    bool (*equal)(const char* a, const char* b, size_t len) noexcept;
+    size_t (*find_byte)(const char* data, size_t len, char c) noexcept;
+    // set: up to 8 distinct bytes
+    size_t (*find_any)(const char* data, size_t len, const char* set, size_t set_len) noexcept;
+    // first byte a JSON string cannot hold verbatim: '"', '\\' or a control character (< 0x20)
+    size_t (*find_escape)(const char* data, size_t len) noexcept;
+};
+
+namespace scalar {
+    inline bool equal(const char* a, const char* b, size_t len) noexcept {
+        return std::memcmp(a, b, len) == 0;
+    }
+
+    inline size_t find_byte(const char* data, size_t len, char c) noexcept {
+        const void* hit = std::memchr(data, c, len);
+        return hit ? static_cast<size_t>(static_cast<const char*>(hit) - data) : len;
+    }
+
+    inline size_t find_any(const char* data, size_t len, const char* set, size_t set_len) noexcept {
+        for (size_t i = 0; i < len; ++i) {
+            if (std::memchr(set, data[i], set_len)) return i;
+        }
+        return len;
+    }
+
+    inline size_t find_escape(const char* data, size_t len) noexcept {
+        for (size_t i = 0; i < len; ++i) {
+            const unsigned char c = static_cast<unsigned char>(data[i]);
+            if (c < 0x20 || c == '"' || c == '\\') return i;
+        }
+        return len;
+    }
+}
+
+#ifdef JSON_SIMD_DISPATCH
+// Each ISA gets the same four kernels; only the vector width and the mask extraction differ
+namespace sse2 {
+    JSON_SIMD_TARGET("sse2") inline bool equal(const char* a, const char* b, size_t len) noexcept {
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) != 0xFFFF) return false;
+        }
+        return std::memcmp(a + i, b + i, len - i) == 0;
+    }
+
+    JSON_SIMD_TARGET("sse2") inline size_t find_byte(const char* data, size_t len, char c) noexcept {
+        const __m128i needle = _mm_set1_epi8(c);
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            if (const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))) return i + __builtin_ctz(mask);
+        }
+        return i + scalar::find_byte(data + i, len - i, c);
+    }
+
+    JSON_SIMD_TARGET("sse2") inline size_t find_any(const char* data, size_t len, const char* set, size_t set_len) noexcept {
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i hit = _mm_setzero_si128();
+            for (size_t s = 0; s < set_len; ++s) {
+                hit = _mm_or_si128(hit, _mm_cmpeq_epi8(chunk, _mm_set1_epi8(set[s])));
+            }
+            if (const int mask = _mm_movemask_epi8(hit)) return i + __builtin_ctz(mask);
+        }
+        return i + scalar::find_any(data + i, len - i, set, set_len);
+    }
+
+    JSON_SIMD_TARGET("sse2") inline size_t find_escape(const char* data, size_t len) noexcept {
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i control = _mm_set1_epi8(0x1F);
+        size_t i = 0;
+        for (; i + 16 <= len; i += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            // unsigned c <= 0x1F  <=>  min(c, 0x1F) == c
+            const __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                                             _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+            if (const int mask = _mm_movemask_epi8(hit)) return i + __builtin_ctz(mask);
+        }
+        return i + scalar::find_escape(data + i, len - i);
+    }
+}
+
+namespace avx2 {
+    JSON_SIMD_TARGET("avx2") inline bool equal(const char* a, const char* b, size_t len) noexcept {
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32) {
+            const __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            const __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            if (static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb))) != 0xFFFFFFFFu) return false;
+        }
+        return sse2::equal(a + i, b + i, len - i);
+    }
+
+    JSON_SIMD_TARGET("avx2") inline size_t find_byte(const char* data, size_t len, char c) noexcept {
+        const __m256i needle = _mm256_set1_epi8(c);
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            if (const uint32_t mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle))) return i + __builtin_ctz(mask);
+        }
+        return i + sse2::find_byte(data + i, len - i, c);
+    }
+
+    JSON_SIMD_TARGET("avx2") inline size_t find_any(const char* data, size_t len, const char* set, size_t set_len) noexcept {
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            __m256i hit = _mm256_setzero_si256();
+            for (size_t s = 0; s < set_len; ++s) {
+                hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(set[s])));
+            }
+            if (const uint32_t mask = _mm256_movemask_epi8(hit)) return i + __builtin_ctz(mask);
+        }
+        return i + sse2::find_any(data + i, len - i, set, set_len);
+    }
+
+    JSON_SIMD_TARGET("avx2") inline size_t find_escape(const char* data, size_t len) noexcept {
+        const __m256i quote = _mm256_set1_epi8('"');
+        const __m256i backslash = _mm256_set1_epi8('\\');
+        const __m256i control = _mm256_set1_epi8(0x1F);
+        size_t i = 0;
+        for (; i + 32 <= len; i += 32) {
+            const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+            const __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+                                                _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, control), chunk));
+            if (const uint32_t mask = _mm256_movemask_epi8(hit)) return i + __builtin_ctz(mask);
+        }
+        return i + sse2::find_escape(data + i, len - i);
+    }
+}
+
+namespace avx512 {
+    JSON_SIMD_TARGET("avx512f,avx512bw") inline bool equal(const char* a, const char* b, size_t len) noexcept {
+        size_t i = 0;
+        for (; i + 64 <= len; i += 64) {
+            const __m512i va = _mm512_loadu_si512(a + i);
+            const __m512i vb = _mm512_loadu_si512(b + i);
+            if (_mm512_cmpneq_epi8_mask(va, vb)) return false;
+        }
+        return avx2::equal(a + i, b + i, len - i);
+    }
+
+    JSON_SIMD_TARGET("avx512f,avx512bw") inline size_t find_byte(const char* data, size_t len, char c) noexcept {
+        const __m512i needle = _mm512_set1_epi8(c);
+        size_t i = 0;
+        for (; i + 64 <= len; i += 64) {
+            const __m512i chunk = _mm512_loadu_si512(data + i);
+            if (const uint64_t mask = _mm512_cmpeq_epi8_mask(chunk, needle)) return i + __builtin_ctzll(mask);
+        }
+        return i + avx2::find_byte(data + i, len - i, c);
+    }
+
+    JSON_SIMD_TARGET("avx512f,avx512bw") inline size_t find_any(const char* data, size_t len, const char* set, size_t set_len) noexcept {
+        size_t i = 0;
+        for (; i + 64 <= len; i += 64) {
+            const __m512i chunk = _mm512_loadu_si512(data + i);
+            uint64_t mask = 0;
+            for (size_t s = 0; s < set_len; ++s) {
+                mask |= _mm512_cmpeq_epi8_mask(chunk, _mm512_set1_epi8(set[s]));
+            }
+            if (mask) return i + __builtin_ctzll(mask);
+        }
+        return i + avx2::find_any(data + i, len - i, set, set_len);
+    }
+
+    JSON_SIMD_TARGET("avx512f,avx512bw") inline size_t find_escape(const char* data, size_t len) noexcept {
+        const __m512i quote = _mm512_set1_epi8('"');
+        const __m512i backslash = _mm512_set1_epi8('\\');
+        const __m512i control = _mm512_set1_epi8(0x1F);
+        size_t i = 0;
+        for (; i + 64 <= len; i += 64) {
+            const __m512i chunk = _mm512_loadu_si512(data + i);
+            const uint64_t mask = _mm512_cmpeq_epi8_mask(chunk, quote) | _mm512_cmpeq_epi8_mask(chunk, backslash) |
+                                  _mm512_cmple_epu8_mask(chunk, control);
+            if (mask) return i + __builtin_ctzll(mask);
+        }
+        return i + avx2::find_escape(data + i, len - i);
+    }
+}
+#endif
+
+inline bool cpu_supports(Isa isa) noexcept {
+#ifdef JSON_SIMD_DISPATCH
+    __builtin_cpu_init();
+    switch (isa) {
+        case Isa::Scalar: return true;
+        case Isa::SSE2:   return __builtin_cpu_supports("sse2");
+        case Isa::AVX2:   return __builtin_cpu_supports("avx2");
+        case Isa::AVX512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+    }
+    return false;
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+// Kernel table for one ISA (nullptr when this build or this CPU cannot run it)
+inline const Kernels* kernels_for(Isa isa) noexcept {
+    static constexpr Kernels SCALAR{Isa::Scalar, scalar::equal, scalar::find_byte, scalar::find_any, scalar::find_escape};
+#ifdef JSON_SIMD_DISPATCH
+    static constexpr Kernels SSE2{Isa::SSE2, sse2::equal, sse2::find_byte, sse2::find_any, sse2::find_escape};
+    static constexpr Kernels AVX2{Isa::AVX2, avx2::equal, avx2::find_byte, avx2::find_any, avx2::find_escape};
+    static constexpr Kernels AVX512{Isa::AVX512, avx512::equal, avx512::find_byte, avx512::find_any, avx512::find_escape};
+#endif
+    if (!cpu_supports(isa)) return nullptr;
+    switch (isa) {
+#ifdef JSON_SIMD_DISPATCH
+        case Isa::SSE2:   return &SSE2;
+        case Isa::AVX2:   return &AVX2;
+        case Isa::AVX512: return &AVX512;
+#endif
+        default:          return &SCALAR;
+    }
+}
+
+// The table every caller goes through: widest supported ISA, selected once per process
+inline const Kernels& kernels() noexcept {
+    static const Kernels& selected = [] () -> const Kernels& {
+        for (Isa isa : {Isa::AVX512, Isa::AVX2, Isa::SSE2}) {
+            if (const Kernels* table = kernels_for(isa)) return *table;
+        }
+        return *kernels_for(Isa::Scalar);
+    }();
+    return selected;
+}
+
+} // namespace simd
+} // namespace json_adapter
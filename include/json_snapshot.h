@@ -0,0 +1,574 @@
+/**
+ * @file json_snapshot.h
+ * @brief Binary snapshot format: written from any backend, read in place through mmap
+ *
+ * Restarting from a large JSON state file means parsing all of it before the first lookup. A snapshot
+ * stores the same document as tagged values with offset tables, so a reader maps the file and answers
+ * get/has by following offsets; only the values actually asked for are turned back into json.
+ *
+ * Layout (little-endian, values written children first):
+ *   header  "OJSNAP02" | u64 root offset | u64 file size
+ *   null/false/true     tag
+ *   int                 tag | signed integer
+ *   double              tag | float (width 4) or double (width 8)
+ *   string              tag | length | bytes
+ *   array               tag | count | distance[count]
+ *   object              tag | count | {key distance, value distance}[count] | sorted index[count]
+ * The tag byte holds the type in its low bits and width codes 0-3 (1, 2, 4 or 8 bytes) for the fields
+ * after it: bits 4-5 for everything but object keys, bits 6-7 for those. Each value picks the narrowest
+ * width its numbers fit. A distance is how many bytes before its container a child starts, so children
+ * written just before it take one or two bytes; keys get their own width because short ones are written
+ * once and shared, which can put them far away.
+ * Object members keep document order; the index lists them by key bytes for binary search.
+ */
+
+#pragma once
+
+#include "universal_json_adapter.h"
+
+#if JSON_ADAPTER_BACKEND == JSON11 || JSON_ADAPTER_BACKEND == RAPIDJSON
+    #error "json_snapshot.h needs the nlohmann, JsonCpp or AxzDict backend"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define JSON_SNAPSHOT_MMAP 1
+#endif
+
+JSON_ADAPTER_NAMESPACE_BEGIN
+
+namespace snapshot_detail {
+
+inline constexpr char MAGIC[8] = {'O', 'J', 'S', 'N', 'A', 'P', '0', '2'};
+inline constexpr size_t HEADER_SIZE = sizeof(MAGIC) + 2 * sizeof(uint64_t);
+
+enum Tag : uint8_t { TAG_NULL, TAG_FALSE, TAG_TRUE, TAG_INT, TAG_DOUBLE, TAG_STRING, TAG_ARRAY, TAG_OBJECT };
+
+inline constexpr uint8_t TYPE_MASK = 0x0f;
+inline constexpr int WIDTH_SHIFT = 4;
+inline constexpr int KEY_WIDTH_SHIFT = 6;
+
+// Width code of the narrowest field that holds `max`
+inline uint8_t width_code(uint64_t max) {
+    return max <= UINT8_MAX ? 0 : max <= UINT16_MAX ? 1 : max <= UINT32_MAX ? 2 : 3;
+}
+
+// Containers nested deeper than this are refused when writing and reading, as in json_binary.h
+inline constexpr int MAX_DEPTH = 512;
+
+// Appends values to a file (or a string) in post-order and returns where each one starts
+class Encoder {
+public:
+    explicit Encoder(std::FILE* file) : file_(file) { buffer_.reserve(FLUSH_AT); }
+    explicit Encoder(std::string& out) : out_(&out) {}
+
+    uint64_t value(const json& j) {
+        if (is_null(j)) return tag(TAG_NULL);
+        if (is_bool(j)) return tag(get_bool(j) ? TAG_TRUE : TAG_FALSE);
+        if (is_number(j)) return number(j);
+        if (is_string(j)) return string(get_string(j));
+        if (is_array(j) || is_object(j)) {
+            if (depth_ == MAX_DEPTH) throw std::runtime_error("Snapshot: nesting too deep");
+            ++depth_;
+            const uint64_t at = is_array(j) ? array(j) : object(j);
+            --depth_;
+            return at;
+        }
+        return tag(TAG_NULL);  // backend-specific kinds have no JSON equivalent
+    }
+
+    uint64_t string(std::string_view text) {
+        const uint8_t code = width_code(text.size());
+        const uint64_t at = tag(TAG_STRING | code << WIDTH_SHIFT);
+        put_uint(text.size(), code);
+        put(text.data(), text.size());
+        return at;
+    }
+
+    void header(uint64_t root) {
+        char bytes[HEADER_SIZE];
+        const uint64_t size = offset_;
+        std::memcpy(bytes, MAGIC, sizeof(MAGIC));
+        std::memcpy(bytes + sizeof(MAGIC), &root, sizeof(root));
+        std::memcpy(bytes + sizeof(MAGIC) + sizeof(root), &size, sizeof(size));
+        if (out_) {
+            std::memcpy(out_->data(), bytes, HEADER_SIZE);
+            return;
+        }
+        flush();
+        if (std::fseek(file_, 0, SEEK_SET) != 0 || std::fwrite(bytes, 1, HEADER_SIZE, file_) != HEADER_SIZE) {
+            throw std::runtime_error("Snapshot: write failed");
+        }
+    }
+
+    void begin() { put(std::string(HEADER_SIZE, '\0').data(), HEADER_SIZE); }
+
+    void flush() {
+        if (file_ && !buffer_.empty()) {
+            if (std::fwrite(buffer_.data(), 1, buffer_.size(), file_) != buffer_.size()) {
+                throw std::runtime_error("Snapshot: write failed");
+            }
+            buffer_.clear();
+        }
+    }
+
+private:
+    static constexpr size_t FLUSH_AT = 1 << 20;
+
+    std::FILE* file_ = nullptr;
+    std::string* out_ = nullptr;
+    std::string buffer_;
+    uint64_t offset_ = 0;
+    int depth_ = 0;
+
+    void put(const void* data, size_t size) {
+        std::string& target = out_ ? *out_ : buffer_;
+        target.append(static_cast<const char*>(data), size);
+        offset_ += size;
+        if (file_ && buffer_.size() >= FLUSH_AT) flush();
+    }
+    void put_uint(uint64_t v, uint8_t code) { put(&v, size_t(1) << code); }
+
+    static void append_uint(std::string& out, uint64_t v, uint8_t code) {
+        out.append(reinterpret_cast<const char*>(&v), size_t(1) << code);
+    }
+
+    // Keys repeat across objects of the same shape; short ones are written once and shared
+    static constexpr size_t SHARED_KEY_MAX = 64;
+    static constexpr size_t SHARED_KEYS_LIMIT = 1 << 16;
+    std::unordered_map<std::string, uint64_t> keys_;
+
+    uint64_t key_string(const std::string& key) {
+        if (key.size() > SHARED_KEY_MAX) return string(key);
+        auto it = keys_.find(key);
+        if (it != keys_.end()) return it->second;
+        const uint64_t at = string(key);
+        if (keys_.size() < SHARED_KEYS_LIMIT) keys_.emplace(key, at);
+        return at;
+    }
+
+    uint64_t tag(uint8_t t) {
+        const uint64_t at = offset_;
+        put(&t, 1);
+        return at;
+    }
+
+    uint64_t number(const json& j) {
+        const double d = get_double(j);
+        // Integers inside the exactly representable range come back as integers, doubles as doubles
+        if (is_integer(j) && std::floor(d) == d && std::fabs(d) <= 9007199254740992.0) {
+            const int64_t i = static_cast<int64_t>(d);
+            const uint8_t code = i >= INT8_MIN && i <= INT8_MAX ? 0 : i >= INT16_MIN && i <= INT16_MAX ? 1
+                               : i >= INT32_MIN && i <= INT32_MAX ? 2 : 3;
+            const uint64_t at = tag(TAG_INT | code << WIDTH_SHIFT);
+            put(&i, size_t(1) << code);
+            return at;
+        }
+        // A float when that is exact, as json_binary.h does
+        if (std::fabs(d) <= std::numeric_limits<float>::max() && static_cast<double>(static_cast<float>(d)) == d) {
+            const float f = static_cast<float>(d);
+            const uint64_t at = tag(TAG_DOUBLE | 2 << WIDTH_SHIFT);
+            put(&f, sizeof(f));
+            return at;
+        }
+        const uint64_t at = tag(TAG_DOUBLE | 3 << WIDTH_SHIFT);
+        put(&d, sizeof(d));
+        return at;
+    }
+
+    uint64_t array(const json& j) {
+        const size_t count = array_size(j);
+        if (count > UINT32_MAX) throw std::length_error("Snapshot: array too large");
+        std::vector<uint64_t> offsets;
+        offsets.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            offsets.push_back(value(element(j, i)));
+        }
+
+        const uint64_t at = offset_;
+        uint64_t widest = count;
+        for (uint64_t child : offsets) widest = std::max(widest, at - child);
+        const uint8_t code = width_code(widest);
+        std::string fields;
+        fields.reserve((offsets.size() + 1) << code);
+        append_uint(fields, count, code);
+        for (uint64_t child : offsets) append_uint(fields, at - child, code);
+        tag(TAG_ARRAY | code << WIDTH_SHIFT);
+        put(fields.data(), fields.size());
+        return at;
+    }
+
+    uint64_t object(const json& j) {
+        std::vector<std::string> keys;
+        std::vector<uint64_t> entries;
+        for_each_member(j, [&](const std::string& key, const json& member) {
+            entries.push_back(key_string(key));
+            entries.push_back(value(member));
+            keys.push_back(key);
+        });
+        if (keys.size() > UINT32_MAX) throw std::length_error("Snapshot: object too large");
+
+        std::vector<uint32_t> sorted(keys.size());
+        for (uint32_t i = 0; i < sorted.size(); ++i) sorted[i] = i;
+        std::sort(sorted.begin(), sorted.end(), [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+
+        const uint64_t at = offset_;
+        uint64_t widest_key = 0, widest = keys.size();
+        for (size_t i = 0; i < entries.size(); i += 2) {
+            widest_key = std::max(widest_key, at - entries[i]);
+            widest = std::max(widest, at - entries[i + 1]);
+        }
+        const uint8_t key_code = width_code(widest_key);
+        const uint8_t code = width_code(widest);
+        std::string fields;
+        append_uint(fields, keys.size(), code);
+        for (size_t i = 0; i < entries.size(); i += 2) {
+            append_uint(fields, at - entries[i], key_code);
+            append_uint(fields, at - entries[i + 1], code);
+        }
+        for (uint32_t member : sorted) append_uint(fields, member, code);
+        tag(TAG_OBJECT | code << WIDTH_SHIFT | key_code << KEY_WIDTH_SHIFT);
+        put(fields.data(), fields.size());
+        return at;
+    }
+};
+
+} // namespace snapshot_detail
+
+// Serialized form of `doc`, e.g. for sending a snapshot over the wire
+inline std::string encode_snapshot(const json& doc) {
+    std::string out;
+    snapshot_detail::Encoder encoder(out);
+    encoder.begin();
+    encoder.header(encoder.value(doc));
+    return out;
+}
+
+// Write `doc` to `file` through a temporary file and a rename, so readers never see a partial snapshot.
+// Throws std::runtime_error on I/O errors.
+inline void write_snapshot(const json& doc, const std::string& file) {
+    const std::string temporary = file + ".tmp";
+    std::FILE* out = std::fopen(temporary.c_str(), "wb");
+    if (!out) throw std::runtime_error("Snapshot: cannot create " + temporary);
+    try {
+        snapshot_detail::Encoder encoder(out);
+        encoder.begin();
+        encoder.header(encoder.value(doc));
+#if JSON_SNAPSHOT_MMAP
+        if (std::fflush(out) != 0 || ::fsync(fileno(out)) != 0) throw std::runtime_error("Snapshot: sync failed");
+#endif
+    } catch (...) {
+        std::fclose(out);
+        std::remove(temporary.c_str());
+        throw;
+    }
+    if (std::fclose(out) != 0 || std::rename(temporary.c_str(), file.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("Snapshot: cannot write " + file);
+    }
+}
+
+// A value inside a snapshot. Cheap to copy; valid while its SnapshotReader lives.
+// Offsets are checked against the mapping, so a corrupt file throws std::runtime_error instead of crashing.
+class SnapshotValue {
+public:
+    enum class Type : uint8_t { Null, Bool, Int, Double, String, Array, Object };
+
+    SnapshotValue(const char* base, size_t size, uint64_t offset) : base_(base), size_(size), offset_(offset) {
+        need(1);
+        if (tag() > snapshot_detail::TAG_OBJECT) corrupt();
+        if (tag() == snapshot_detail::TAG_DOUBLE && width() != 4 && width() != 8) corrupt();
+    }
+
+    Type type() const noexcept {
+        switch (tag()) {
+            case snapshot_detail::TAG_NULL:   return Type::Null;
+            case snapshot_detail::TAG_FALSE:
+            case snapshot_detail::TAG_TRUE:   return Type::Bool;
+            case snapshot_detail::TAG_INT:    return Type::Int;
+            case snapshot_detail::TAG_DOUBLE: return Type::Double;
+            case snapshot_detail::TAG_STRING: return Type::String;
+            case snapshot_detail::TAG_ARRAY:  return Type::Array;
+            default:                          return Type::Object;
+        }
+    }
+    bool is_null() const noexcept { return type() == Type::Null; }
+    bool is_object() const noexcept { return type() == Type::Object; }
+    bool is_array() const noexcept { return type() == Type::Array; }
+
+    bool as_bool() const { return tag() == snapshot_detail::TAG_TRUE; }
+    // A double is truncated toward zero; one outside int64_t's range (or NaN) throws std::out_of_range
+    int64_t as_int() const {
+        if (tag() == snapshot_detail::TAG_DOUBLE) {
+            const double d = as_double();
+            if (!(d >= -9223372036854775808.0 && d < 9223372036854775808.0)) {
+                throw std::out_of_range("Snapshot: number does not fit in int64_t");
+            }
+            return static_cast<int64_t>(d);
+        }
+        return tag() == snapshot_detail::TAG_INT ? read_int(1) : 0;
+    }
+    double as_double() const {
+        if (tag() == snapshot_detail::TAG_INT) return static_cast<double>(read_int(1));
+        if (tag() != snapshot_detail::TAG_DOUBLE) return 0.0;
+        return width() == 4 ? static_cast<double>(read<float>(1)) : read<double>(1);
+    }
+    std::string_view as_string() const {
+        if (tag() != snapshot_detail::TAG_STRING) throw std::runtime_error("Snapshot: value is not a string");
+        const uint64_t length = read_uint(1, width());
+        if (length > size_) corrupt();
+        need(1 + width() + length);
+        return {base_ + offset_ + 1 + width(), static_cast<size_t>(length)};
+    }
+
+    // Elements of an array or members of an object; 0 for scalars
+    size_t size() const {
+        if (!is_array() && !is_object()) return 0;
+        const uint64_t count = read_uint(1, width());
+        if (count > size_) corrupt();   // every element takes at least a byte
+        return static_cast<size_t>(count);
+    }
+
+    SnapshotValue at(size_t index) const {
+        if (!is_array() || index >= size()) throw std::out_of_range("Snapshot: array index out of bounds");
+        return child(read_uint(1 + width() + index * width(), width()));
+    }
+
+    // Binary search over the object's sorted key index
+    std::optional<SnapshotValue> find(std::string_view key) const {
+        if (!is_object()) return std::nullopt;
+        const size_t count = size();
+        const uint64_t index_at = entry_at(count);
+        size_t low = 0, high = count;
+        while (low < high) {
+            const size_t mid = low + (high - low) / 2;
+            const uint64_t member = read_uint(index_at + mid * width(), width());
+            if (member >= count) corrupt();
+            const std::string_view name = key_at(member);
+            if (name == key) return value_at(member);
+            if (name < key) low = mid + 1; else high = mid;
+        }
+        return std::nullopt;
+    }
+
+    // Members in document order
+    template<typename Fn>
+    void for_each_member(Fn&& fn) const {
+        if (!is_object()) return;
+        for (size_t i = 0, n = size(); i < n; ++i) {
+            fn(key_at(i), value_at(i));
+        }
+    }
+
+    // Build the live backend value for this subtree. A valid file stores every value once, so no more
+    // values than bytes are built: offsets a corrupt file shares between containers cannot multiply the work.
+    json materialize() const {
+        size_t budget = size_;
+        return materialize(0, budget);
+    }
+
+private:
+    const char* base_;
+    size_t size_;
+    uint64_t offset_;
+
+    json materialize(int depth, size_t& budget) const {
+        if (budget == 0) corrupt();
+        --budget;
+        switch (type()) {
+            case Type::Null:   return make_null();
+            case Type::Bool:   return make_bool(as_bool());
+            case Type::Int: {
+                const int64_t i = as_int();
+                return i >= INT32_MIN && i <= INT32_MAX ? make_int(static_cast<int>(i)) : make_double(static_cast<double>(i));
+            }
+            case Type::Double: return make_double(as_double());
+            case Type::String: return make_string(std::string(as_string()));
+            case Type::Array: {
+                if (depth == snapshot_detail::MAX_DEPTH) throw std::runtime_error("Snapshot: nesting too deep");
+                json result = make_array();
+                for (size_t i = 0, n = size(); i < n; ++i) append_array(result, at(i).materialize(depth + 1, budget));
+                return result;
+            }
+            default: {
+                if (depth == snapshot_detail::MAX_DEPTH) throw std::runtime_error("Snapshot: nesting too deep");
+                json result = make_object();
+                for_each_member([&](std::string_view key, const SnapshotValue& member) {
+                    set_member(result, std::string(key), member.materialize(depth + 1, budget));
+                });
+                return result;
+            }
+        }
+    }
+
+    [[noreturn]] static void corrupt() { throw std::runtime_error("Snapshot: corrupt file"); }
+
+    void need(uint64_t bytes) const {
+        if (offset_ > size_ || bytes > size_ - offset_) corrupt();
+    }
+    uint8_t tag() const noexcept { return static_cast<uint8_t>(base_[offset_]) & snapshot_detail::TYPE_MASK; }
+
+    // Field widths in bytes, from the tag's width codes
+    uint64_t width() const noexcept {
+        return uint64_t(1) << ((static_cast<uint8_t>(base_[offset_]) >> snapshot_detail::WIDTH_SHIFT) & 3);
+    }
+    uint64_t key_width() const noexcept {
+        return uint64_t(1) << ((static_cast<uint8_t>(base_[offset_]) >> snapshot_detail::KEY_WIDTH_SHIFT) & 3);
+    }
+
+    template<typename T>
+    T read(uint64_t at) const {
+        need(at + sizeof(T));
+        T value;
+        std::memcpy(&value, base_ + offset_ + at, sizeof(T));
+        return value;
+    }
+
+    uint64_t read_uint(uint64_t at, uint64_t bytes) const {
+        need(at + bytes);
+        uint64_t value = 0;
+        std::memcpy(&value, base_ + offset_ + at, bytes);
+        return value;
+    }
+    int64_t read_int(uint64_t at) const {
+        const int shift = static_cast<int>(64 - 8 * width());
+        return static_cast<int64_t>(read_uint(at, width()) << shift) >> shift;
+    }
+
+    // Children are written first, so a valid distance always points before its parent
+    SnapshotValue child(uint64_t distance) const {
+        if (distance == 0 || distance > offset_) corrupt();
+        return SnapshotValue(base_, size_, offset_ - distance);
+    }
+
+    uint64_t entry_at(size_t member) const { return 1 + width() + member * (key_width() + width()); }
+    SnapshotValue value_at(size_t member) const { return child(read_uint(entry_at(member) + key_width(), width())); }
+    std::string_view key_at(size_t member) const { return child(read_uint(entry_at(member), key_width())).as_string(); }
+};
+
+// Read-only view of a snapshot file. Maps it where mmap exists and reads it into memory elsewhere.
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::string& file) {
+#if JSON_SNAPSHOT_MMAP
+        const int fd = ::open(file.c_str(), O_RDONLY);
+        if (fd < 0) throw std::runtime_error("Snapshot: cannot open " + file);
+        struct stat info {};
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(snapshot_detail::HEADER_SIZE)) {
+            ::close(fd);
+            throw std::runtime_error("Snapshot: not a snapshot: " + file);
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) throw std::runtime_error("Snapshot: cannot map " + file);
+        data_ = static_cast<const char*>(mapped);
+        mapped_ = true;
+#else
+        std::FILE* in = std::fopen(file.c_str(), "rb");
+        if (!in) throw std::runtime_error("Snapshot: cannot open " + file);
+        char chunk[1 << 16];
+        for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), in)) > 0;) buffer_.append(chunk, n);
+        std::fclose(in);
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+        validate(file);
+    }
+
+    // Reads from memory, e.g. a snapshot received over the wire
+    struct FromBuffer {};
+    SnapshotReader(FromBuffer, std::string bytes) : buffer_(std::move(bytes)) {
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+        validate("buffer");
+    }
+
+    ~SnapshotReader() {
+#if JSON_SNAPSHOT_MMAP
+        if (mapped_) ::munmap(const_cast<char*>(data_), size_);
+#endif
+    }
+
+    SnapshotReader(const SnapshotReader&) = delete;
+    SnapshotReader& operator=(const SnapshotReader&) = delete;
+
+    SnapshotValue root() const { return SnapshotValue(data_, size_, root_); }
+
+    // Slash-separated member names and array indices, as in UniversalObservableJson paths
+    std::optional<SnapshotValue> find(std::string_view path) const {
+        SnapshotValue node = root();
+        while (!path.empty()) {
+            const size_t slash = path.find('/');
+            const std::string_view part = path.substr(0, slash);
+            path = slash == std::string_view::npos ? std::string_view() : path.substr(slash + 1);
+            if (part.empty()) continue;
+
+            if (node.is_array()) {
+                size_t index = 0;
+                for (char c : part) {
+                    if (c < '0' || c > '9') return std::nullopt;
+                    index = index * 10 + static_cast<size_t>(c - '0');
+                }
+                if (index >= node.size()) return std::nullopt;
+                node = node.at(index);
+            } else if (auto member = node.find(part)) {
+                node = *member;
+            } else {
+                return std::nullopt;
+            }
+        }
+        return node;
+    }
+
+    bool has(std::string_view path) const { return find(path).has_value(); }
+
+    // Materialized value at `path`; throws std::out_of_range when there is none
+    json get(std::string_view path = {}) const {
+        auto node = find(path);
+        if (!node) throw std::out_of_range("Snapshot: path not found: " + std::string(path));
+        return node->materialize();
+    }
+
+    json materialize() const { return root().materialize(); }
+
+    size_t file_size() const noexcept { return size_; }
+
+private:
+    std::string buffer_;
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+    uint64_t root_ = 0;
+    bool mapped_ = false;
+
+    void validate(const std::string& name) {
+        uint64_t recorded = 0;
+        if (size_ < snapshot_detail::HEADER_SIZE ||
+            std::memcmp(data_, snapshot_detail::MAGIC, sizeof(snapshot_detail::MAGIC)) != 0) {
+            throw std::runtime_error("Snapshot: not a snapshot: " + name);
+        }
+        std::memcpy(&root_, data_ + sizeof(snapshot_detail::MAGIC), sizeof(root_));
+        std::memcpy(&recorded, data_ + sizeof(snapshot_detail::MAGIC) + sizeof(root_), sizeof(recorded));
+        if (recorded != size_ || root_ < snapshot_detail::HEADER_SIZE || root_ >= size_) {
+            throw std::runtime_error("Snapshot: truncated or corrupt: " + name);
+        }
+    }
+};
+
+JSON_ADAPTER_NAMESPACE_END
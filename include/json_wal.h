@@ -0,0 +1,472 @@
+/**
+ * @file json_wal.h
+ * @brief Write-ahead log with group commit, and the checkpoint it is replayed on top of
+ *
+ * A durable document lives in a directory holding one checkpoint and a few log segments:
+ *   checkpoint.snap             binary snapshot (json_snapshot.h) of {"sequence": n, "document": ...}
+ *   wal-<generation>.log        "OJWAL001", then records
+ * Every record is  u32 payload length | u32 CRC-32 of payload | payload,  and the payload is
+ *   u64 sequence | u8 op | u32 key length | key | MessagePack value (json_binary.h; absent for Remove/Clear)
+ * Integers are little-endian. Recovery loads the checkpoint and replays records with a higher sequence.
+ * A segment is read up to its first short or damaged record, which is what a crash mid-write leaves behind.
+ * A record whose checksum matches but whose payload does not decode was written that way, so recovery
+ * throws instead of cutting it off with everything after it. check_value() keeps such values out of the log.
+ *
+ * Writers append under the document lock and wait for durability after releasing it. Whoever finds no
+ * write in flight becomes the leader and writes everything queued so far with one write + fdatasync;
+ * the others sleep until that covers their records. Under load, one sync serves many writers.
+ */
+
+#pragma once
+
+#include "universal_json_adapter.h"
+#include "json_binary.h"
+#include "json_snapshot.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define JSON_WAL_POSIX 1
+#endif
+
+JSON_ADAPTER_NAMESPACE_BEGIN
+
+struct WalOptions {
+    bool sync = true;                           // fdatasync every group; false leaves write-back to the OS
+    uint64_t checkpoint_bytes = 64ull << 20;    // checkpoint once the live segment outgrows this; 0 = never
+};
+
+namespace wal_detail {
+
+inline constexpr char MAGIC[8] = {'O', 'J', 'W', 'A', 'L', '0', '0', '1'};
+inline constexpr size_t RECORD_HEADER = 2 * sizeof(uint32_t);
+inline constexpr size_t MAX_RECORD = UINT32_MAX - RECORD_HEADER;
+inline constexpr const char* CHECKPOINT = "checkpoint.snap";
+
+inline uint32_t crc32(const char* data, size_t size) {
+    static const std::array<uint32_t, 256> table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) crc = table[(crc ^ static_cast<uint8_t>(data[i])) & 0xFF] ^ (crc >> 8);
+    return crc ^ 0xFFFFFFFFu;
+}
+
+template<typename T>
+inline void put(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+template<typename T>
+inline T take(const char* data) {
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+inline std::string segment_name(uint64_t generation) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "wal-%016llx.log", static_cast<unsigned long long>(generation));
+    return name;
+}
+
+// Segments in the directory, oldest first
+inline std::vector<std::pair<uint64_t, std::filesystem::path>> segments(const std::filesystem::path& directory) {
+    std::vector<std::pair<uint64_t, std::filesystem::path>> found;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, ec)) {
+        const std::string name = entry.path().filename().string();
+        if (name.size() != 24 || name.compare(0, 4, "wal-") != 0 || name.compare(20, 4, ".log") != 0) continue;
+        uint64_t generation = 0;
+        bool hex = true;
+        for (size_t i = 4; i < 20 && hex; ++i) {
+            const char c = name[i];
+            const int digit = c >= '0' && c <= '9' ? c - '0' : c >= 'a' && c <= 'f' ? c - 'a' + 10 : -1;
+            hex = digit >= 0;
+            generation = generation << 4 | static_cast<uint64_t>(digit);
+        }
+        if (hex) found.emplace_back(generation, entry.path());
+    }
+    std::sort(found.begin(), found.end());
+    return found;
+}
+
+// Make a rename or a newly created file in `directory` survive a crash
+inline void sync_directory(const std::filesystem::path& directory) {
+#if JSON_WAL_POSIX
+    const int fd = ::open(directory.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    ::fsync(fd);
+    ::close(fd);
+#else
+    (void)directory;
+#endif
+}
+
+// Append-only segment file. POSIX gets a raw descriptor and fdatasync; elsewhere stdio and fflush.
+class SegmentFile {
+public:
+    explicit SegmentFile(const std::filesystem::path& file) {
+#if JSON_WAL_POSIX
+        fd_ = ::open(file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) throw std::runtime_error("WAL: cannot create " + file.string());
+#else
+        file_ = std::fopen(file.string().c_str(), "wb");
+        if (!file_) throw std::runtime_error("WAL: cannot create " + file.string());
+#endif
+    }
+
+    ~SegmentFile() {
+#if JSON_WAL_POSIX
+        if (fd_ >= 0) ::close(fd_);
+#else
+        if (file_) std::fclose(file_);
+#endif
+    }
+
+    SegmentFile(const SegmentFile&) = delete;
+    SegmentFile& operator=(const SegmentFile&) = delete;
+
+    void write(const char* data, size_t size) {
+#if JSON_WAL_POSIX
+        while (size > 0) {
+            const ssize_t n = ::write(fd_, data, size);
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("WAL: write failed");
+            }
+            data += n;
+            size -= static_cast<size_t>(n);
+        }
+#else
+        if (std::fwrite(data, 1, size, file_) != size) throw std::runtime_error("WAL: write failed");
+#endif
+    }
+
+    void sync() {
+#if JSON_WAL_POSIX
+#if defined(__APPLE__)
+        const int result = ::fsync(fd_);
+#else
+        const int result = ::fdatasync(fd_);
+#endif
+        if (result != 0) throw std::runtime_error("WAL: sync failed");
+#else
+        if (std::fflush(file_) != 0) throw std::runtime_error("WAL: sync failed");
+#endif
+    }
+
+private:
+#if JSON_WAL_POSIX
+    int fd_ = -1;
+#else
+    std::FILE* file_ = nullptr;
+#endif
+};
+
+}  // namespace wal_detail
+
+// The log of one durable document. append() is called with the document lock held, so records are
+// queued in sequence order; wait() is called without it and is where writers share a sync.
+// A failed write or sync is sticky: every later wait() and throw_if_failed() rethrows it.
+class WriteAheadLog {
+public:
+    enum class Op : uint8_t { Set = 1, Remove, Clear, Replace, Patch };
+
+    struct Record {
+        uint64_t sequence = 0;
+        Op op = Op::Set;
+        std::string key;    // top-level member for Set and Remove
+        json value;         // new value, whole document for Replace, RFC 6902 patch for Patch
+    };
+
+    WriteAheadLog(std::filesystem::path directory, WalOptions options)
+        : directory_(std::move(directory)), options_(options) {
+        const auto existing = wal_detail::segments(directory_);
+        generation_ = existing.empty() ? 1 : existing.back().first + 1;
+        open_segment();
+    }
+
+    ~WriteAheadLog() {
+        try {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return !flushing_; });
+            if (!error_) flush_locked();
+        } catch (...) {
+            // Nothing left to report to: writers that needed these records already waited for them
+        }
+    }
+
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Throws std::invalid_argument for a value the log could not replay: containers nested deeper than
+    // binary_detail::MAX_DEPTH. Writers call it before changing anything, since append() comes after.
+    static void check_value(const json& value) {
+        if (!binary_detail::within_depth(value)) {
+            throw std::invalid_argument("WAL: value nested deeper than " + std::to_string(binary_detail::MAX_DEPTH) + " levels");
+        }
+    }
+
+    // Queue a record and return the position wait() must reach for it to be durable
+    uint64_t append(uint64_t sequence, Op op, const std::string& key, const json* value) {
+        std::string record(wal_detail::RECORD_HEADER, '\0');
+        wal_detail::put<uint64_t>(record, sequence);
+        record.push_back(static_cast<char>(op));
+        wal_detail::put<uint32_t>(record, static_cast<uint32_t>(key.size()));
+        record += key;
+        if (value) {
+            const std::vector<uint8_t> packed = to_msgpack(*value);
+            record.append(reinterpret_cast<const char*>(packed.data()), packed.size());
+        }
+        const size_t payload = record.size() - wal_detail::RECORD_HEADER;
+        if (payload > wal_detail::MAX_RECORD) throw std::length_error("WAL: record too large");
+        const uint32_t length = static_cast<uint32_t>(payload);
+        const uint32_t crc = wal_detail::crc32(record.data() + wal_detail::RECORD_HEADER, payload);
+        std::memcpy(&record[0], &length, sizeof(length));
+        std::memcpy(&record[sizeof(length)], &crc, sizeof(crc));
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ += record;
+        appended_ += record.size();
+        segment_bytes_ += record.size();
+        ++records_;
+        return appended_;
+    }
+
+    // Block until everything up to `position` is written and synced, leading the group write if no one is
+    void wait(uint64_t position) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (durable_ < position) {
+            if (error_) std::rethrow_exception(error_);
+            if (flushing_) {
+                cv_.wait(lock);
+                continue;
+            }
+            flushing_ = true;
+            std::string batch;
+            batch.swap(pending_);
+            const uint64_t end = appended_;
+            lock.unlock();
+            std::exception_ptr failure;
+            try {
+                file_->write(batch.data(), batch.size());
+                if (options_.sync) file_->sync();
+            } catch (...) {
+                failure = std::current_exception();
+            }
+            lock.lock();
+            flushing_ = false;
+            if (failure) error_ = failure;
+            else { durable_ = end; ++syncs_; }
+            cv_.notify_all();
+        }
+    }
+
+    // Rethrow the sticky error, if any, so a writer can refuse a change before making it
+    void throw_if_failed() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_) std::rethrow_exception(error_);
+    }
+
+    // Close the live segment (flushing it) and start the next one; returns the new generation.
+    // Called under the document lock, so no record can land between the checkpoint and the cut.
+    uint64_t rotate() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !flushing_; });
+        if (error_) std::rethrow_exception(error_);
+        flush_locked();
+        ++generation_;
+        open_segment();
+        segment_bytes_ = 0;
+        return generation_;
+    }
+
+    // Once the checkpoint covering them is on disk, older segments are only dead weight
+    void remove_segments_before(uint64_t generation) {
+        for (const auto& [number, path] : wal_detail::segments(directory_)) {
+            if (number >= generation) break;
+            std::error_code ec;
+            std::filesystem::remove(path, ec);
+        }
+        wal_detail::sync_directory(directory_);
+    }
+
+    bool wants_checkpoint() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return options_.checkpoint_bytes != 0 && segment_bytes_ >= options_.checkpoint_bytes;
+    }
+
+    const std::filesystem::path& directory() const noexcept { return directory_; }
+
+    // Generation of the live segment
+    uint64_t generation() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return generation_;
+    }
+
+    uint64_t records() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return records_;
+    }
+
+    // Group writes so far; records() / syncs() is the average group size
+    uint64_t syncs() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return syncs_;
+    }
+
+    // Replay every record after `after_sequence` in order; returns the last sequence seen.
+    // A damaged tail is cut off the segment so the next recovery does not trip over it again. A record that
+    // passes its checksum but does not decode is not damage: it throws std::runtime_error and nothing is cut.
+    template<typename Apply>
+    static uint64_t replay(const std::filesystem::path& directory, uint64_t after_sequence, Apply&& apply) {
+        uint64_t last = after_sequence;
+        for (const auto& [generation, path] : wal_detail::segments(directory)) {
+            (void)generation;
+            std::string bytes = read_file(path);
+            size_t offset = sizeof(wal_detail::MAGIC);
+            if (bytes.size() < offset || std::memcmp(bytes.data(), wal_detail::MAGIC, offset) != 0) continue;
+
+            while (bytes.size() - offset >= wal_detail::RECORD_HEADER) {
+                const auto length = wal_detail::take<uint32_t>(bytes.data() + offset);
+                const auto crc = wal_detail::take<uint32_t>(bytes.data() + offset + sizeof(uint32_t));
+                const char* payload = bytes.data() + offset + wal_detail::RECORD_HEADER;
+                if (length > bytes.size() - offset - wal_detail::RECORD_HEADER || wal_detail::crc32(payload, length) != crc) break;
+                auto record = decode(payload, length);
+                if (!record) {
+                    throw std::runtime_error("WAL: undecodable record at offset " + std::to_string(offset) + " of " + path.string());
+                }
+                offset += wal_detail::RECORD_HEADER + length;
+                if (record->sequence > last) {
+                    last = record->sequence;
+                    apply(std::move(*record));
+                }
+            }
+            if (offset < bytes.size()) {
+                std::error_code ec;
+                std::filesystem::resize_file(path, offset, ec);
+            }
+        }
+        return last;
+    }
+
+private:
+    std::filesystem::path directory_;
+    WalOptions options_;
+    std::unique_ptr<wal_detail::SegmentFile> file_;
+    uint64_t generation_ = 1;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::string pending_;           // appended, not yet handed to a leader
+    uint64_t appended_ = 0;         // bytes ever appended; positions handed out by append()
+    uint64_t durable_ = 0;          // bytes known to be on disk
+    uint64_t segment_bytes_ = 0;
+    uint64_t records_ = 0;
+    uint64_t syncs_ = 0;
+    bool flushing_ = false;
+    std::exception_ptr error_;
+
+    void open_segment() {
+        const auto path = directory_ / wal_detail::segment_name(generation_);
+        file_ = std::make_unique<wal_detail::SegmentFile>(path);
+        file_->write(wal_detail::MAGIC, sizeof(wal_detail::MAGIC));
+        file_->sync();
+        wal_detail::sync_directory(directory_);
+    }
+
+    // Caller holds mutex_ and no leader is writing
+    void flush_locked() {
+        if (!pending_.empty()) {
+            file_->write(pending_.data(), pending_.size());
+            pending_.clear();
+        }
+        if (durable_ < appended_) {
+            if (options_.sync) file_->sync();
+            durable_ = appended_;
+            ++syncs_;
+            cv_.notify_all();
+        }
+    }
+
+    static std::string read_file(const std::filesystem::path& path) {
+        std::string bytes;
+        std::FILE* in = std::fopen(path.string().c_str(), "rb");
+        if (!in) return bytes;
+        char chunk[1 << 16];
+        for (size_t n; (n = std::fread(chunk, 1, sizeof(chunk), in)) > 0;) bytes.append(chunk, n);
+        std::fclose(in);
+        return bytes;
+    }
+
+    static std::optional<Record> decode(const char* payload, size_t length) {
+        constexpr size_t fixed = sizeof(uint64_t) + 1 + sizeof(uint32_t);
+        if (length < fixed) return std::nullopt;
+        Record record;
+        record.sequence = wal_detail::take<uint64_t>(payload);
+        const auto op = static_cast<uint8_t>(payload[sizeof(uint64_t)]);
+        if (op < static_cast<uint8_t>(Op::Set) || op > static_cast<uint8_t>(Op::Patch)) return std::nullopt;
+        record.op = static_cast<Op>(op);
+        const auto key_size = wal_detail::take<uint32_t>(payload + sizeof(uint64_t) + 1);
+        if (key_size > length - fixed) return std::nullopt;
+        record.key.assign(payload + fixed, key_size);
+        const size_t value_at = fixed + key_size;
+        try {
+            record.value = value_at < length
+                ? from_msgpack(reinterpret_cast<const uint8_t*>(payload + value_at), length - value_at)
+                : make_null();
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+        return record;
+    }
+};
+
+// Write the checkpoint for a document at `sequence`, replacing the previous one atomically
+inline void write_checkpoint(const std::filesystem::path& directory, const json& doc, uint64_t sequence) {
+    json wrapper = make_object();
+    set_member(wrapper, "sequence", binary_detail::make_integer(static_cast<int64_t>(sequence)));
+    set_member(wrapper, "document", doc);
+    write_snapshot(wrapper, (directory / wal_detail::CHECKPOINT).string());
+    wal_detail::sync_directory(directory);
+}
+
+// The checkpointed document and its sequence, if the directory has a checkpoint
+inline std::optional<std::pair<json, uint64_t>> read_checkpoint(const std::filesystem::path& directory) {
+    const auto file = directory / wal_detail::CHECKPOINT;
+    std::error_code ec;
+    if (!std::filesystem::exists(file, ec)) return std::nullopt;
+    SnapshotReader reader(file.string());
+    const auto sequence = reader.root().find("sequence");
+    const auto document = reader.root().find("document");
+    if (!sequence || !document) throw std::runtime_error("WAL: malformed checkpoint " + file.string());
+    return std::make_pair(document->materialize(), static_cast<uint64_t>(sequence->as_int()));
+}
+
+JSON_ADAPTER_NAMESPACE_END
@@ -0,0 +1,393 @@
+/**
+ * @file mapped_observable_json.h
+ * @brief Observable JSON document that lives in a memory-mapped file (json_mapped_store.h)
+ *
+ * For state larger than RAM: reads walk the mapping at page-cache speed, opening an existing file is
+ * instant, and memory use follows the working set. The get/set/remove/subscribe API and the asynchronous
+ * notifications follow UniversalObservableJson; unlike it, paths resolve at every level
+ * ("users/42/name"), creating intermediate objects on set.
+ */
+
+#pragma once
+
+#include "universal_observable_json.h"
+#include "json_mapped_store.h"
+
+OBSERVABLE_JSON_NAMESPACE_BEGIN
+
+class MappedObservableJson final {
+public:
+    // Open the document in `file`, creating an empty object there if the file does not exist
+    explicit MappedObservableJson(const std::string& file, uint64_t initial_capacity = 1 << 20)
+        : store_(file, initial_capacity)
+        , notification_system_(std::make_unique<NotificationSystem>(2)) {}
+
+    MappedObservableJson(const MappedObservableJson&) = delete;
+    MappedObservableJson& operator=(const MappedObservableJson&) = delete;
+
+    size_t subscribe(CallbackFunction callback, const std::string& path_filter = "") {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        size_t id = next_id_++;
+        auto& subscriber = subscribers_[id];
+        subscriber.filter = path_filter;
+        subscriber.info.callback = std::move(callback);
+        subscriber.info.path_filter = subscriber.filter;
+        return id;
+    }
+
+    size_t subscribe_debounced(CallbackFunction callback, std::chrono::milliseconds debounce_delay,
+                               const std::string& path_filter = "") {
+        size_t id = subscribe(std::move(callback), path_filter);
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers_[id].info.debounce_delay = std::chrono::duration_cast<std::chrono::nanoseconds>(debounce_delay);
+        return id;
+    }
+
+    void unsubscribe(size_t id) {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers_.erase(id);
+    }
+
+    // Store `value` at `path`; missing objects along the way are created. An array index equal to the
+    // array's size appends. Throws std::invalid_argument for a path through a scalar, std::out_of_range
+    // for an index past the end.
+    template<typename T>
+    void set(const std::string& path, const T& value) {
+        if (!PathUtils::is_valid_path(path)) {
+            throw std::invalid_argument("Invalid path: " + path);
+        }
+        auto parts = PathUtils::split_path(path);
+        if (parts.empty()) {
+            throw std::invalid_argument("Cannot set empty path");
+        }
+
+        json new_value;
+        json old_value = json_adapter::make_null();
+        const bool notify = has_subscriber_for(path);
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            const uint64_t node = store_value(value);
+            const uint64_t old = assign(parts, node, path);
+            if (notify) {
+                new_value = store_.load(node);
+                if (old) old_value = store_.load(old);
+            }
+            if (old) store_.destroy(old);
+        }
+
+        if (notify) notify_subscribers(new_value, path, old_value);
+    }
+
+    // Set top-level members under one lock, like UniversalObservableJson::set_batch
+    template<typename Container>
+    void set_batch(const Container& key_value_pairs) {
+        std::vector<std::tuple<std::string, json, json>> changes;
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            for (const auto& [key, value] : key_value_pairs) {
+                const uint64_t node = store_value(value);
+                const uint64_t old = assign({key}, node, key);
+                if (has_subscriber_for(key)) {
+                    changes.emplace_back(key, store_.load(node), old ? store_.load(old) : json_adapter::make_null());
+                }
+                if (old) store_.destroy(old);
+            }
+        }
+
+        for (const auto& [key, new_val, old_val] : changes) {
+            notify_subscribers(new_val, key, old_val);
+        }
+    }
+
+    // Typed reads of scalars come straight from the mapping; json (or the root) is copied out of it
+    template<typename T = json>
+    T get(const std::string& path = "") const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        if (path.empty()) {
+            return extract<T>(store_.root(), path);
+        }
+        if (!PathUtils::is_valid_path(path)) {
+            throw std::invalid_argument("Invalid path: " + path);
+        }
+
+        auto parts = PathUtils::split_path(path);
+        auto slot = find_slot(parts);
+        if (!slot) {
+            throw std::runtime_error(parts.size() == 1 ? "Key not found: " + parts[0] : "Path not found: " + path);
+        }
+        return extract<T>(store_.slot_value(*slot), path);
+    }
+
+    bool has(const std::string& path) const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        if (path.empty()) return true;
+        if (!PathUtils::is_valid_path(path)) return false;
+        return find_slot(PathUtils::split_path(path)).has_value();
+    }
+
+    // Remove the member or array element at `path`; later array elements shift down.
+    // Subscribers are notified either way, as with UniversalObservableJson::remove.
+    void remove(const std::string& path) {
+        if (!PathUtils::is_valid_path(path)) {
+            throw std::invalid_argument("Invalid path: " + path);
+        }
+        auto parts = PathUtils::split_path(path);
+        if (parts.empty()) {
+            return;
+        }
+
+        json old_value = json_adapter::make_null();
+        const bool notify = has_subscriber_for(path);
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            const std::string last = parts.back();
+            parts.pop_back();
+            auto parent_slot = find_slot(parts);
+            if (parent_slot) {
+                const uint64_t parent = store_.slot_value(*parent_slot);
+                std::optional<uint64_t> removed;
+                if (store_.tag(parent) == json_adapter::mapped_detail::TAG_OBJECT) {
+                    removed = store_.erase(parent, last);
+                } else if (store_.tag(parent) == json_adapter::mapped_detail::TAG_ARRAY) {
+                    auto index = parse_index(last);
+                    if (index && *index < store_.count(parent)) removed = store_.erase_item(*parent_slot, *index);
+                }
+                if (removed) {
+                    if (notify) old_value = store_.load(*removed);
+                    store_.destroy(*removed);
+                }
+            }
+        }
+
+        if (notify) notify_subscribers(json_adapter::make_null(), path, old_value);
+    }
+
+    void clear() {
+        json old_data;
+        const bool notify = has_subscriber_for("");
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            const uint64_t old = store_.root();
+            store_.set_slot(json_adapter::MappedStore::ROOT_SLOT, store_.new_object(0));
+            if (notify) old_data = store_.load(old);
+            store_.destroy(old);
+        }
+
+        if (notify) notify_subscribers(json_adapter::make_object(), "", old_data);
+    }
+
+    // Top-level member count
+    size_t size() const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        const uint64_t root = store_.root();
+        return store_.tag(root) == json_adapter::mapped_detail::TAG_OBJECT ? store_.count(root) : 0;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    std::string dump(int indent = -1) const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return json_adapter::dump(store_.load(store_.root()), indent);
+    }
+
+    // Write dirty pages to disk. Without it, changes survive a crash of the process but not of the machine.
+    void flush() {
+        std::unique_lock<std::shared_mutex> lock(data_mutex_);
+        store_.sync();
+    }
+
+    uint64_t file_size() const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return store_.file_size();
+    }
+
+    size_t get_subscriber_count() const {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        return subscribers_.size();
+    }
+
+    void wait_for_notifications() const {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+private:
+    struct Subscriber {
+        std::string filter;     // owns the text CallbackInfo::path_filter points at
+        CallbackInfo info;
+    };
+
+    json_adapter::MappedStore store_;
+    mutable std::shared_mutex data_mutex_;
+    std::unordered_map<size_t, Subscriber> subscribers_;
+    mutable std::mutex subscribers_mutex_;
+    size_t next_id_ = 1;
+    std::unique_ptr<NotificationSystem> notification_system_;  // last: its queue may still reference the members above
+
+    static std::optional<uint32_t> parse_index(const std::string& token) {
+        if (token.empty() || token.size() > 9) return std::nullopt;
+        uint32_t index = 0;
+        for (char c : token) {
+            if (c < '0' || c > '9') return std::nullopt;
+            index = index * 10 + static_cast<uint32_t>(c - '0');
+        }
+        return index;
+    }
+
+    // Caller holds data_mutex_
+    std::optional<uint64_t> find_slot(const std::vector<std::string>& parts) const {
+        uint64_t slot = json_adapter::MappedStore::ROOT_SLOT;
+        for (const auto& part : parts) {
+            const uint64_t node = store_.slot_value(slot);
+            if (store_.tag(node) == json_adapter::mapped_detail::TAG_OBJECT) {
+                auto member = store_.member_slot(node, part);
+                if (!member) return std::nullopt;
+                slot = *member;
+            } else if (store_.tag(node) == json_adapter::mapped_detail::TAG_ARRAY) {
+                auto index = parse_index(part);
+                if (!index || *index >= store_.count(node)) return std::nullopt;
+                slot = store_.item_slot(node, *index);
+            } else {
+                return std::nullopt;
+            }
+        }
+        return slot;
+    }
+
+    // Caller holds data_mutex_ exclusively. Link `node` in at `parts` and return the node it replaced (0 if none),
+    // which the caller destroys. On error `node` is destroyed here.
+    uint64_t assign(const std::vector<std::string>& parts, uint64_t node, const std::string& path) {
+        using namespace json_adapter::mapped_detail;
+        uint64_t owned = node;      // destroyed if the write fails
+        try {
+            uint64_t slot = json_adapter::MappedStore::ROOT_SLOT;
+            for (size_t i = 0; i < parts.size(); ++i) {
+                const bool last = i + 1 == parts.size();
+                const uint64_t parent = store_.slot_value(slot);
+                bool append = false;
+                if (store_.tag(parent) == TAG_OBJECT) {
+                    if (auto member = store_.member_slot(parent, parts[i])) {
+                        if (last) {
+                            const uint64_t old = store_.slot_value(*member);
+                            store_.set_slot(*member, node);
+                            return old;
+                        }
+                        slot = *member;
+                        continue;
+                    }
+                } else if (store_.tag(parent) == TAG_ARRAY) {
+                    auto index = parse_index(parts[i]);
+                    if (!index || *index > store_.count(parent)) {
+                        throw std::out_of_range("Array index out of range in path: " + path);
+                    }
+                    if (*index < store_.count(parent)) {
+                        const uint64_t item_slot = store_.item_slot(parent, *index);
+                        if (last) {
+                            const uint64_t old = store_.slot_value(item_slot);
+                            store_.set_slot(item_slot, node);
+                            return old;
+                        }
+                        slot = item_slot;
+                        continue;
+                    }
+                    append = true;
+                } else {
+                    throw std::invalid_argument("Path goes through a scalar: " + path);
+                }
+
+                // The rest of the path is missing: build its objects around the node off to the side and
+                // link them in with one insert or append, so a failure leaves the tree as it was
+                for (size_t j = parts.size() - 1; j > i; --j) owned = store_.new_object(parts[j], owned);
+                if (append) {
+                    store_.append(slot, owned);
+                } else {
+                    store_.insert(slot, parts[i], owned);
+                }
+                return 0;
+            }
+            return 0;
+        } catch (...) {
+            store_.destroy(owned);
+            throw;
+        }
+    }
+
+    // Caller holds data_mutex_ exclusively
+    template<typename T>
+    uint64_t store_value(const T& value) {
+        if constexpr (std::is_same_v<T, json>) {
+            return store_.store(value);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            return store_.store_bool(value);
+        } else if constexpr (std::is_integral_v<T>) {
+            return store_.store_int(static_cast<int64_t>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+            return store_.store_double(static_cast<double>(value));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return store_.store_string(std::string_view(value));
+        } else {
+            static_assert(std::is_same_v<T, json>, "MappedObservableJson stores json, bool, numbers and strings");
+            return 0;
+        }
+    }
+
+    // Caller holds data_mutex_
+    template<typename T>
+    T extract(uint64_t node, const std::string& path) const {
+        using namespace json_adapter::mapped_detail;
+        const Tag tag = store_.tag(node);
+        if constexpr (std::is_same_v<T, json>) {
+            return store_.load(node);
+        } else if constexpr (std::is_same_v<T, bool>) {
+            if (tag == TAG_TRUE || tag == TAG_FALSE) return tag == TAG_TRUE;
+        } else if constexpr (std::is_arithmetic_v<T>) {
+            if (tag == TAG_INT) return static_cast<T>(store_.as_int(node));
+            if (tag == TAG_DOUBLE) return static_cast<T>(store_.as_double(node));
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            if (tag == TAG_STRING) return store_.as_string(node);
+        } else {
+            static_assert(std::is_same_v<T, json>, "Unsupported type extraction");
+        }
+        throw std::runtime_error("Failed to extract value: wrong type at '" + path + "'");
+    }
+
+    // Values are only copied out of the mapping for notifications someone will receive
+    bool has_subscriber_for(const std::string& path) const {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        for (const auto& [id, subscriber] : subscribers_) {
+            if (subscriber.info.should_call(path)) return true;
+        }
+        return false;
+    }
+
+    // Jobs are queued after the lock is released: a full queue runs them inline, and they take it themselves
+    void notify_subscribers(const json& new_value, const std::string& path, const json& old_value) {
+        std::vector<std::function<void()>> jobs;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            for (auto& [id, subscriber] : subscribers_) {
+                if (!subscriber.info.should_call(path)) continue;
+                auto callback_copy = subscriber.info.callback;
+                auto callback_id = id;
+                jobs.emplace_back([this, callback_copy, new_value, path, old_value, callback_id]() mutable {
+                    try {
+                        callback_copy(new_value, path, old_value);
+                        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+                        auto it = subscribers_.find(callback_id);
+                        if (it != subscribers_.end()) {
+                            it->second.info.mark_called();
+                        }
+                    } catch (const std::exception& e) {
+                        std::cerr << "Async callback error: " << e.what() << std::endl;
+                    }
+                });
+            }
+        }
+        for (auto& job : jobs) {
+            notification_system_->enqueue_notification(std::move(job));
+        }
+    }
+};
+
+OBSERVABLE_JSON_NAMESPACE_END
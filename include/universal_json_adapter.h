@@ -3,9 +3,9 @@
  * @brief Ultra-High Performance Universal JSON Adapter with Multi-Backend Support
  * 
  * PERFORMANCE FEATURES:
- * • SIMD-optimized string operations (SSE4.2, AVX2, NEON)
+ * • SIMD string operations (SSE2, AVX2, AVX-512) selected at runtime by CPU feature
  * • Lock-free data structures with cache-line alignment
- * • Compile-time string hashing and interning
+ * • Seeded multiply-mix string hashing and interning
  * • Zero-copy string views and perfect forwarding
  * • Branch prediction hints and prefetch optimization
  * • Template metaprogramming for compile-time dispatch
@@ -31,7 +31,7 @@
  * COMPILER REQUIREMENTS:
  * • C++17 or later
  * • Supports GCC 7+, Clang 6+, MSVC 2017+
- * • Automatic CPU feature detection and optimization
+ * • Runtime CPU feature detection - no -march needed for the SIMD paths
  * 
  * @author Enhanced Universal JSON Adapter
  * @version 2.0 - Extreme Performance Edition
@@ -55,9 +55,20 @@
 #include <type_traits>
 #include <utility>
 #include <cstring>
+#include <cmath>
 #include <atomic>
 #include <chrono>
 #include <array>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <streambuf>
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <unistd.h>
+#endif
 
 // Performance optimization includes
 #ifdef __has_include
@@ -66,6 +77,11 @@
 #define JSON_HAS_SIMD 1
 #endif
 #endif
+#ifdef _MSC_VER
+#include <intrin.h>     // _umul128
+#endif
+#include "json_simd.h"  // runtime-dispatched scanning kernels
+#include "axz_hash.h"  // seeded key hash shared with AxzDict (header-only)
 
 // Compiler-specific performance optimizations
 #ifdef __GNUC__
@@ -120,6 +136,29 @@ constexpr size_t JSON_SIMD_ALIGNMENT = 32;
 #define SIMDJSON         8
 #define CPPREST          9
 
+// simdjson's DOM is read-only, so SIMDJSON runs its On-Demand parser into a mutable AxzDict tree.
+#if JSON_ADAPTER_BACKEND == SIMDJSON
+    #undef JSON_ADAPTER_BACKEND
+    #define JSON_ADAPTER_BACKEND AXZDICT
+    #undef JSON_ADAPTER_SIMDJSON_PARSE
+    #define JSON_ADAPTER_SIMDJSON_PARSE 1
+#endif
+#ifndef JSON_ADAPTER_SIMDJSON_PARSE
+#define JSON_ADAPTER_SIMDJSON_PARSE 0
+#endif
+#if JSON_ADAPTER_SIMDJSON_PARSE && JSON_ADAPTER_BACKEND != AXZDICT
+    #error "JSON_ADAPTER_SIMDJSON_PARSE needs a mutable AxzDict tree"
+#endif
+
+// Code that depends on the backend sits in an inline namespace named after it (backend_5_0 for AxzDict,
+// backend_5_1 with the simdjson parser), so objects built against different backends link into one
+// program without clashing; see any_observable_json.h
+#define JSON_ADAPTER_ABI_TAG_CONCAT(backend, simdjson) backend_##backend##_##simdjson
+#define JSON_ADAPTER_ABI_TAG_EXPAND(backend, simdjson) JSON_ADAPTER_ABI_TAG_CONCAT(backend, simdjson)
+#define JSON_ADAPTER_ABI_TAG JSON_ADAPTER_ABI_TAG_EXPAND(JSON_ADAPTER_BACKEND, JSON_ADAPTER_SIMDJSON_PARSE)
+#define JSON_ADAPTER_NAMESPACE_BEGIN namespace json_adapter { inline namespace JSON_ADAPTER_ABI_TAG {
+#define JSON_ADAPTER_NAMESPACE_END } }
+
 // Include the selected JSON library
 #if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
     #include <nlohmann/json.hpp>
@@ -142,6 +181,7 @@ constexpr size_t JSON_SIMD_ALIGNMENT = 32;
     #define AXZ_DICT_NULL     AxzDictType::NUL
     #define AXZ_DICT_BOOL     AxzDictType::BOOL
     #define AXZ_DICT_NUMBER   AxzDictType::NUMBER
+    #define AXZ_DICT_INTEGRAL AxzDictType::INTEGRAL
     #define AXZ_DICT_STRING   AxzDictType::STRING
     #define AXZ_DICT_ARRAY    AxzDictType::ARRAY
     #define AXZ_DICT_OBJECT   AxzDictType::OBJECT
@@ -149,69 +189,52 @@ constexpr size_t JSON_SIMD_ALIGNMENT = 32;
     #include <boost/json.hpp>
 #elif JSON_ADAPTER_BACKEND == SAJSON
     #include <sajson.h>
-#elif JSON_ADAPTER_BACKEND == SIMDJSON
-    #include <simdjson.h>
 #elif JSON_ADAPTER_BACKEND == CPPREST
     #include <cpprest/json.h>
 #endif
+#if JSON_ADAPTER_SIMDJSON_PARSE
+    #include <simdjson.h>
+#endif
 
 namespace json_adapter {
 
-// Compile-time string hashing for ultra-fast key lookups
-constexpr uint64_t fnv1a_hash(std::string_view str) noexcept {
-    uint64_t hash = 14695981039346656037ULL;
-    for (char c : str) {
-        hash ^= static_cast<uint64_t>(c);
-        hash *= 1099511628211ULL;
-    }
-    return hash;
+// Seeded string hash for key tables: the same wyhash-style hash AxzDict uses for its keys
+using axz_hash_internal::hash_bytes;
+
+// Per-process seed so paths and keys cannot be precomputed to collide (hash flooding)
+inline uint64_t hash_seed() noexcept { return axz_hash_internal::process_seed(); }
+
+JSON_FORCE_INLINE uint64_t hash_string(std::string_view str) noexcept {
+    return hash_bytes(str.data(), str.size(), hash_seed());
 }
 
-// Fast string comparison using SIMD when available
+// Hasher for unordered containers keyed by std::string / std::string_view
+struct StringHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view str) const noexcept { return static_cast<size_t>(hash_string(str)); }
+};
+
+// Fast string comparison through the runtime-selected SIMD kernels
 JSON_FORCE_INLINE JSON_HOT bool fast_string_equal(std::string_view a, std::string_view b) noexcept {
     if (JSON_UNLIKELY(a.size() != b.size())) return false;
     if (JSON_LIKELY(a.data() == b.data())) return true;
     
-    const size_t size = a.size();
-    const char* JSON_RESTRICT ptr_a = a.data();
-    const char* JSON_RESTRICT ptr_b = b.data();
-    
-#ifdef JSON_HAS_SIMD
-    // SIMD-optimized comparison for larger strings
-    if (size >= 32) {
-        const size_t simd_chunks = size / 32;
-        for (size_t i = 0; i < simd_chunks; ++i) {
-            #ifdef __AVX2__
-            __m256i chunk_a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr_a + i * 32));
-            __m256i chunk_b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr_b + i * 32));
-            __m256i cmp = _mm256_cmpeq_epi8(chunk_a, chunk_b);
-            if (_mm256_movemask_epi8(cmp) != 0xFFFFFFFF) return false;
-            #else
-            if (std::memcmp(ptr_a + i * 32, ptr_b + i * 32, 32) != 0) return false;
-            #endif
-        }
-        // Handle remaining bytes
-        const size_t remaining = size % 32;
-        if (remaining > 0) {
-            return std::memcmp(ptr_a + simd_chunks * 32, ptr_b + simd_chunks * 32, remaining) == 0;
-        }
-        return true;
+    // Short strings: an inline memcmp beats the indirect call
+    if (a.size() < 32) {
+        return std::memcmp(a.data(), b.data(), a.size()) == 0;
     }
-#endif
-    
-    // Fast path for small strings
-    return std::memcmp(ptr_a, ptr_b, size) == 0;
+    return simd::kernels().equal(a.data(), b.data(), a.size());
 }
 
 // Cache-friendly string pool for frequently used keys
 class alignas(JSON_CACHE_LINE_SIZE) StringPool {
     static constexpr size_t POOL_SIZE = 1024;
-    static thread_local std::array<std::string, POOL_SIZE> pool_;
-    static thread_local size_t next_index_;
+    static inline thread_local std::array<std::string, POOL_SIZE> pool_{};
+    static inline thread_local size_t next_index_ = 0;
     
 public:
     JSON_FORCE_INLINE static std::string_view intern(std::string_view str) noexcept {
-        const uint64_t hash = fnv1a_hash(str) % POOL_SIZE;
+        const uint64_t hash = hash_string(str) % POOL_SIZE;
         auto& pooled = pool_[hash];
         
         if (JSON_LIKELY(fast_string_equal(pooled, str))) {
@@ -223,9 +246,6 @@ public:
     }
 };
 
-thread_local std::array<std::string, StringPool::POOL_SIZE> StringPool::pool_{};
-thread_local size_t StringPool::next_index_ = 0;
-
 // Performance monitoring structure
 struct alignas(JSON_CACHE_LINE_SIZE) PerformanceStats {
     std::atomic<uint64_t> parse_calls{0};
@@ -253,6 +273,92 @@ inline PerformanceStats& get_perf_stats() noexcept {
     return stats;
 }
 
+// Receives serialized JSON piece by piece; returning false stops the dump
+using dump_sink = std::function<bool(const char* data, size_t size)>;
+constexpr size_t DEFAULT_DUMP_CHUNK = 64 * 1024;
+
+#if defined(__unix__) || defined(__APPLE__)
+// Sink writing to a file descriptor; the descriptor stays owned by the caller
+inline dump_sink fd_sink(int fd) {
+    return [fd](const char* data, size_t size) {
+        while (size > 0) {
+            const ssize_t written = ::write(fd, data, size);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            data += written;
+            size -= static_cast<size_t>(written);
+        }
+        return true;
+    };
+}
+#endif
+
+namespace detail {
+// Stream buffer handing at most chunk_size bytes at a time to a dump_sink, for backends that serialize to
+// std::ostream. Once the sink refuses, every write fails and the stream goes bad.
+class ChunkedSinkBuffer final : public std::streambuf {
+public:
+    ChunkedSinkBuffer(const dump_sink& sink, size_t chunk_size)
+        : sink_(sink), buffer_(chunk_size > 0 ? chunk_size : DEFAULT_DUMP_CHUNK) {
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+    }
+    
+    bool finish() { return flush_buffer() && ok_; }
+    
+protected:
+    int_type overflow(int_type c) override {
+        if (!flush_buffer()) return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+    
+    std::streamsize xsputn(const char* data, std::streamsize size) override {
+        std::streamsize done = 0;
+        while (done < size) {
+            if (pptr() == epptr() && !flush_buffer()) break;
+            const std::streamsize room = std::min<std::streamsize>(epptr() - pptr(), size - done);
+            std::memcpy(pptr(), data + done, static_cast<size_t>(room));
+            pbump(static_cast<int>(room));
+            done += room;
+        }
+        return done;
+    }
+    
+    int sync() override { return flush_buffer() ? 0 : -1; }
+    
+private:
+    bool flush_buffer() {
+        const size_t pending = static_cast<size_t>(pptr() - pbase());
+        if (ok_ && pending > 0) {
+            ok_ = sink_(pbase(), pending);
+        }
+        setp(buffer_.data(), buffer_.data() + buffer_.size());
+        return ok_;
+    }
+    
+    const dump_sink& sink_;
+    std::vector<char> buffer_;
+    bool ok_ = true;
+};
+
+// For backends that can only serialize to a string: the sink still gets bounded chunks
+inline bool feed_in_chunks(std::string_view text, const dump_sink& sink, size_t chunk_size) {
+    if (chunk_size == 0) chunk_size = DEFAULT_DUMP_CHUNK;
+    for (size_t pos = 0; pos < text.size(); pos += chunk_size) {
+        if (!sink(text.data() + pos, std::min(chunk_size, text.size() - pos))) return false;
+    }
+    return true;
+}
+} // namespace detail
+
+// Everything below depends on the backend
+inline namespace JSON_ADAPTER_ABI_TAG {
+
 // Universal JSON type based on selected backend
 #if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
     using json = nlohmann::json;
@@ -327,6 +433,45 @@ inline PerformanceStats& get_perf_stats() noexcept {
         return result;
     }
     
+    namespace dump_detail {
+        // Writes j as dump(j, indent) does: containers here, scalars and keys through json::dump() with the
+        // same error handler, so only one scalar's text is built at a time
+        inline void write_json(std::ostream& out, const json& j, int indent, int level) {
+            if (!j.is_structured()) {
+                out << j.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+                return;
+            }
+            if (j.empty()) {
+                out << (j.is_object() ? "{}" : "[]");
+                return;
+            }
+            const bool pretty = indent >= 0;
+            out.put(j.is_object() ? '{' : '[');
+            for (auto it = j.begin(); it != j.end(); ++it) {
+                if (it != j.begin()) out.put(',');
+                if (pretty) out << '\n' << std::string(static_cast<size_t>(indent) * (level + 1), ' ');
+                if (j.is_object()) {
+                    out << json(it.key()).dump(-1, ' ', false, nlohmann::json::error_handler_t::replace) << (pretty ? ": " : ":");
+                }
+                write_json(out, *it, indent, level + 1);
+            }
+            if (pretty) out << '\n' << std::string(static_cast<size_t>(indent) * level, ' ');
+            out.put(j.is_object() ? '}' : ']');
+        }
+    }
+    
+    // Streaming dump: written through a chunked stream buffer, never the whole text at once
+    inline bool dump_to(const json& j, const dump_sink& sink, int indent = -1, size_t chunk_size = DEFAULT_DUMP_CHUNK) {
+        detail::ChunkedSinkBuffer buffer(sink, chunk_size);
+        std::ostream out(&buffer);
+        try {
+            dump_detail::write_json(out, j, indent, 0);
+        } catch (...) {
+            return false;
+        }
+        return buffer.finish();
+    }
+    
     // Branchless type checking with perfect inlining
     [[nodiscard]] JSON_FORCE_INLINE JSON_CONST JSON_HOT bool is_null(const json& j) noexcept { 
         return j.is_null(); 
@@ -453,6 +598,15 @@ inline PerformanceStats& get_perf_stats() noexcept {
         arr.clear();
     }
     
+    // Visit object members in storage order; fn(key, value) must not modify obj
+    template<typename Fn>
+    inline void for_each_member(const json& obj, Fn&& fn) {
+        if (!obj.is_object()) return;
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            fn(it.key(), it.value());
+        }
+    }
+    
 #elif JSON_ADAPTER_BACKEND == JSON11
     using json = json11::Json;
     
@@ -716,6 +870,18 @@ inline PerformanceStats& get_perf_stats() noexcept {
         }
     }
     
+    // Streaming dump through a StreamWriter over a chunked stream buffer
+    inline bool dump_to(const json& j, const dump_sink& sink, int indent = -1, size_t chunk_size = DEFAULT_DUMP_CHUNK) {
+        detail::ChunkedSinkBuffer buffer(sink, chunk_size);
+        std::ostream out(&buffer);
+        Json::StreamWriterBuilder builder;
+        builder["indentation"] = indent >= 0 ? std::string(indent, ' ') : std::string();
+        std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+        writer->write(j, &out);
+        if (indent < 0) out.put('\n');  // FastWriter in dump() ends compact output with a newline
+        return buffer.finish();
+    }
+    
     // Type checking functions
     inline bool is_null(const json& j) { return j.isNull(); }
     inline bool is_bool(const json& j) { return j.isBool(); }
@@ -771,82 +937,46 @@ inline PerformanceStats& get_perf_stats() noexcept {
         arr.clear();
     }
     
+    // Visit object members in storage order; fn(key, value) must not modify obj
+    template<typename Fn>
+    inline void for_each_member(const json& obj, Fn&& fn) {
+        if (!obj.isObject()) return;
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            fn(it.name(), *it);
+        }
+    }
+    
 #elif JSON_ADAPTER_BACKEND == AXZDICT
     using json = AxzDict;
     
-    // Helper functions for string conversion with proper memory safety and alignment
+    // AxzDict keeps wide strings; the rest of the adapter speaks UTF-8
     inline axz_wstring to_axz_wstring(const std::string& str) {
-        if (str.empty()) {
-            return axz_wstring();
-        }
-        
-        // Pre-allocate with proper alignment to avoid AVX2 memory issues
         axz_wstring result;
-        result.reserve(str.size() + 16); // Extra padding for AVX2 alignment
-        
-        // Convert with bounds checking and proper alignment
-        try {
-            for (size_t i = 0; i < str.size(); ++i) {
-                unsigned char c = static_cast<unsigned char>(str[i]);
-                // Ensure valid UTF-8 to wchar_t conversion
-                if (c <= 127) { // ASCII range
-                    result.push_back(static_cast<wchar_t>(c));
-                } else {
-                    // Handle extended ASCII safely
-                    result.push_back(static_cast<wchar_t>(c));
-                }
-            }
-            
-            // Ensure null-termination for safety with C-style operations
-            result.shrink_to_fit();
-            return result;
-        } catch (const std::exception&) {
-            // Return empty string on conversion error
-            return axz_wstring();
-        }
+        AxzJson::fromUtf8(str.data(), str.size(), result);
+        return result;
     }
     
     inline std::string from_axz_wstring(const axz_wstring& wstr) {
-        if (wstr.empty()) {
-            return std::string();
-        }
-        
         std::string result;
-        result.reserve(wstr.size() + 1); // Extra byte for safety
-        
-        // Safer character-by-character conversion with bounds checking
-        try {
-            for (size_t i = 0; i < wstr.size(); ++i) {
-                wchar_t wc = wstr[i];
-                // Ensure valid wchar_t to char conversion
-                if (wc == L'\0') {
-                    break; // Stop at null terminator
-                } else if (wc <= 255) {
-                    result.push_back(static_cast<char>(wc));
-                } else {
-                    // Replace invalid chars with safe replacement
-                    result.push_back('?');
-                }
-            }
-            
-            return result;
-        } catch (const std::exception&) {
-            // Return empty string on conversion error
-            return std::string();
-        }
+        AxzJson::toUtf8(wstr.data(), wstr.size(), result);
+        return result;
     }
     
+#if JSON_ADAPTER_SIMDJSON_PARSE
+    json parse_ondemand(const std::string& json_str);  // simdjson front end, defined after the backends
+#endif
+    
     // Parse function for AxzDict with better error handling
     inline json parse(const std::string& json_str) {
         if (json_str.empty()) {
             return AxzDictCompat::create_typed(AXZ_DICT_OBJECT);
         }
-        
+#if JSON_ADAPTER_SIMDJSON_PARSE
+        return parse_ondemand(json_str);
+#else
         try {
             AxzDict cached_dict = AxzDictCompat::create_typed(AXZ_DICT_OBJECT);
-            auto wstr = to_axz_wstring(json_str);
-            
-            if (AXZ_SUCCESS(AxzJson::deserialize(wstr, cached_dict))) {
+            if (AXZ_SUCCESS(AxzJson::deserialize(to_axz_wstring(json_str), cached_dict))) {
                 return cached_dict;
             } else {
                 throw std::runtime_error("AxzDict JSON parse error - invalid JSON format");
@@ -854,29 +984,41 @@ inline PerformanceStats& get_perf_stats() noexcept {
         } catch (const std::exception& e) {
             throw std::runtime_error(std::string("AxzDict parse error: ") + e.what());
         }
+#endif
     }
     
     // Dump function for AxzDict with better error handling
     inline std::string dump(const json& j, int indent = -1) {
         try {
-            axz_wstring cached_result;
+            std::string result;
             bool pretty_format = (indent >= 0);
             
-            if (AXZ_SUCCESS(AxzJson::serialize(j, cached_result, pretty_format))) {
-                return from_axz_wstring(cached_result);
+            // UTF-8 written directly, no wide intermediate; compact dumps reuse the text of unchanged containers
+            if (AXZ_SUCCESS(AxzJson::serialize(j, result, pretty_format, true))) {
+                return result;
             } else {
                 return "{}";
             }
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container has no faithful dump
         } catch (const std::exception& e) {
             return "{}"; // Safe fallback
         }
     }
     
+    // Streaming dump: the AxzDict writer encodes UTF-8 straight into chunk-sized pieces
+    inline bool dump_to(const json& j, const dump_sink& sink, int indent = -1, size_t chunk_size = DEFAULT_DUMP_CHUNK) {
+        const axz_rc rc = AxzJson::serialize(j, [&sink](const char* data, size_t size) -> axz_rc {
+            return sink(data, size) ? AXZ_OK : AXZ_ERROR_INVALID_OUTPUT;
+        }, indent >= 0, chunk_size);
+        return AXZ_SUCCESS(rc);
+    }
+    
     // Type checking functions
     inline bool is_null(const json& j) { return j.type() == AXZ_DICT_NULL; }
     inline bool is_bool(const json& j) { return j.type() == AXZ_DICT_BOOL; }
     inline bool is_number(const json& j) { 
-        return j.type() == AXZ_DICT_NUMBER;
+        return j.type() == AXZ_DICT_NUMBER || j.type() == AXZ_DICT_INTEGRAL;
     }
     inline bool is_string(const json& j) { 
         return j.type() == AXZ_DICT_STRING;
@@ -896,7 +1038,7 @@ inline PerformanceStats& get_perf_stats() noexcept {
         return result;
     }
     inline double get_double(const json& j) { 
-        if (j.type() == AXZ_DICT_NUMBER) {
+        if (j.type() == AXZ_DICT_NUMBER || j.type() == AXZ_DICT_INTEGRAL) {
             double result = 0.0;
             j.val(result);  // Ignore return code for now since it seems to work anyway
             return result;
@@ -918,9 +1060,7 @@ inline PerformanceStats& get_perf_stats() noexcept {
     }
     inline std::string get_string(const json& j) { 
         if (j.type() == AXZ_DICT_STRING) {
-            axz_wstring result;
-            j.val(result);
-            return from_axz_wstring(result);
+            return from_axz_wstring(j.stringRef());
         }
         throw std::runtime_error("Value is not a string");
     }
@@ -937,7 +1077,7 @@ inline PerformanceStats& get_perf_stats() noexcept {
     
     // Object operations with safer memory management and proper locking
     inline bool has_key(const json& j, const std::string& key) { 
-        if (key.empty() || !is_object(j)) {
+        if (!is_object(j)) {
             return false;
         }
         
@@ -945,13 +1085,15 @@ inline PerformanceStats& get_perf_stats() noexcept {
             // Create key with proper alignment to avoid AVX2 issues
             axz_wstring cached_key = to_axz_wstring(key);
             return AxzDictCompat::safe_contain(j, cached_key);
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container, not a failed lookup
         } catch (const std::exception&) {
             return false; // Safe fallback
         }
     }
     inline json object_at(const json& j, const std::string& key) { 
-        if (key.empty() || !is_object(j)) {
-            throw std::out_of_range("AxzDict invalid key or not an object: " + key);
+        if (!is_object(j)) {
+            throw std::out_of_range("AxzDict not an object: " + key);
         }
         
         try {
@@ -962,6 +1104,8 @@ inline PerformanceStats& get_perf_stats() noexcept {
             if (AxzDictCompat::safe_val(j, cached_key, cached_result)) {
                 return cached_result;
             }
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container, not a failed lookup
         } catch (const std::exception&) {
             // Fall through to throw error
         }
@@ -1002,28 +1146,24 @@ inline PerformanceStats& get_perf_stats() noexcept {
     
     // Key manipulation functions with safer memory management and proper locking
     inline void set_member(json& obj, const std::string& key, const json& value) {
-        if (key.empty()) {
-            return; // Ignore empty keys
-        }
-        
         try {
             // Create key with proper alignment to avoid AVX2 issues
             axz_wstring cached_key = to_axz_wstring(key);
             obj.set(cached_key, value);
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container is not ignored
         } catch (const std::exception&) {
             // Ignore errors in set operation to prevent crashes
         }
     }
     
     inline void remove_member(json& obj, const std::string& key) {
-        if (key.empty()) {
-            return; // Ignore empty keys
-        }
-        
         try {
             // Create key with proper alignment to avoid AVX2 issues
             axz_wstring cached_key = to_axz_wstring(key);
             obj.remove(cached_key);
+        } catch (const AxzDictDeferredError&) {
+            throw; // invalid text in a deferred container is not ignored
         } catch (const std::exception&) {
             // Ignore errors in remove operation to prevent crashes
         }
@@ -1038,6 +1178,15 @@ inline PerformanceStats& get_perf_stats() noexcept {
         arr.clear();
     }
 
+    // Visit object members in storage order; fn(key, value) must not modify obj
+    template<typename Fn>
+    inline void for_each_member(const json& obj, Fn&& fn) {
+        if (!obj.isObject()) return;
+        for (auto it = obj.begin(); it != obj.end(); ++it) {
+            fn(from_axz_wstring(it.key()), *it);
+        }
+    }
+    
 #elif JSON_ADAPTER_BACKEND == BOOST_JSON
     using json = boost::json::value;
     
@@ -1125,11 +1274,6 @@ inline PerformanceStats& get_perf_stats() noexcept {
     // This would need a more complex wrapper
     #error "sajson backend not fully implemented - it's primarily a parser"
     
-#elif JSON_ADAPTER_BACKEND == SIMDJSON
-    // Note: simdjson is primarily a fast parser, not a full JSON library
-    // This would need a more complex wrapper
-    #error "simdjson backend not fully implemented - it's primarily a fast parser"
-    
 #elif JSON_ADAPTER_BACKEND == CPPREST
     using json = web::json::value;
     
@@ -1212,15 +1356,347 @@ inline PerformanceStats& get_perf_stats() noexcept {
     #error "Unknown JSON backend selected. Please choose from: NLOHMANN_JSON, JSON11, RAPIDJSON, JSONCPP, BOOST_JSON, SAJSON, SIMDJSON, CPPREST"
 #endif
 
+#if JSON_ADAPTER_SIMDJSON_PARSE
+// simdjson On-Demand validates and decodes the text in one pass and hands over each scalar ready-made;
+// the mutable tree is then built from the adapter primitives. Errors throw std::runtime_error.
+namespace simdjson_detail {
+
+[[noreturn]] inline void fail(simdjson::error_code error) {
+    throw std::runtime_error(std::string("JSON parse error: ") + simdjson::error_message(error));
+}
+
+template<typename T, typename Result>
+inline T take(Result&& result) {
+    T value{};
+    if (auto error = std::forward<Result>(result).get(value)) fail(error);
+    return value;
+}
+
+// Keys and strings arrive as views into simdjson's buffer; AxzDict widens them straight from there
+// (and keeps "" keys, which set_member() skips)
+inline void add_member(json& obj, std::string_view key, json&& value) {
+    axz_wstring wide_key;
+    AxzJson::fromUtf8(key.data(), key.size(), wide_key);
+    obj.add(wide_key, std::move(value));
+}
+
+inline void add_element(json& arr, json&& value) { arr.add(std::move(value)); }
+
+inline void reserve_children(json& container, size_t count) { container.reserve(count); }
+
+inline json make_text(std::string_view text) {
+    axz_wstring wide;
+    AxzJson::fromUtf8(text.data(), text.size(), wide);
+    AxzDict result = AxzDictCompat::create_typed(AXZ_DICT_STRING);
+    result = std::move(wide);
+    return result;
+}
+
+inline json make_integer(int64_t value) {
+    return value >= INT32_MIN && value <= INT32_MAX ? make_int(static_cast<int>(value)) : make_double(static_cast<double>(value));
+}
+
+// Children are staged on one stack shared by the whole parse, so each container is sized once when it
+// closes instead of growing element by element. Keys stay views into the parser's string buffer.
+class TreeBuilder {
+public:
+    // Source is the ondemand::document at the root and an ondemand::value below it; both have these accessors
+    template<typename Source>
+    json build(Source& source) {
+        using simdjson::ondemand::json_type;
+        switch (take<json_type>(source.type())) {
+            case json_type::object: {
+                const size_t base = values_.size();
+                for (auto field_result : take<simdjson::ondemand::object>(source.get_object())) {
+                    auto field = take<simdjson::ondemand::field>(std::move(field_result));
+                    const auto key = take<std::string_view>(field.unescaped_key());
+                    json value = build(field.value());
+                    keys_.push_back(key);
+                    values_.push_back(std::move(value));
+                }
+                json result = make_object();
+                reserve_children(result, values_.size() - base);
+                for (size_t i = base; i < values_.size(); ++i) {
+                    add_member(result, keys_[i], std::move(values_[i]));
+                }
+                pop_to(base);
+                return result;
+            }
+            case json_type::array: {
+                const size_t base = values_.size();
+                for (auto element_result : take<simdjson::ondemand::array>(source.get_array())) {
+                    auto element = take<simdjson::ondemand::value>(std::move(element_result));
+                    json value = build(element);
+                    keys_.emplace_back();
+                    values_.push_back(std::move(value));
+                }
+                json result = make_array();
+                reserve_children(result, values_.size() - base);
+                for (size_t i = base; i < values_.size(); ++i) {
+                    add_element(result, std::move(values_[i]));
+                }
+                pop_to(base);
+                return result;
+            }
+            case json_type::number:
+                switch (take<simdjson::ondemand::number_type>(source.get_number_type())) {
+                    case simdjson::ondemand::number_type::signed_integer:
+                        return make_integer(take<int64_t>(source.get_int64()));
+                    case simdjson::ondemand::number_type::unsigned_integer:
+                        return make_double(static_cast<double>(take<uint64_t>(source.get_uint64())));
+                    default:
+                        return make_double(take<double>(source.get_double()));
+                }
+            case json_type::string:
+                return make_text(take<std::string_view>(source.get_string()));
+            case json_type::boolean:
+                return make_bool(take<bool>(source.get_bool()));
+            case json_type::null:
+                if (!take<bool>(source.is_null())) fail(simdjson::N_ATOM_ERROR);
+                return make_null();
+            default:
+                fail(simdjson::INCORRECT_TYPE);
+        }
+    }
+
+private:
+    void pop_to(size_t base) {
+        values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(base), values_.end());
+        keys_.resize(base);
+    }
+
+    std::vector<json> values_;
+    std::vector<std::string_view> keys_;
+};
+
+} // namespace simdjson_detail
+
+inline json parse_ondemand(const std::string& json_str) {
+    // One parser per thread, so its buffers (sized to the largest document seen) are reused
+    thread_local simdjson::ondemand::parser parser;
+    
+    // simdjson reads up to SIMDJSON_PADDING bytes past the end; a string with that much spare capacity
+    // is parsed in place, anything else is copied into a padded buffer first
+    simdjson::padded_string padded;
+    simdjson::padded_string_view input(json_str.data(), json_str.size(), json_str.capacity());
+    if (json_str.capacity() - json_str.size() < simdjson::SIMDJSON_PADDING) {
+        padded = simdjson::padded_string(json_str);
+        input = padded;
+    }
+    
+    simdjson::ondemand::document document;
+    if (auto error = parser.iterate(input).get(document)) simdjson_detail::fail(error);
+    json result = simdjson_detail::TreeBuilder().build(document);
+    if (!document.at_end()) simdjson_detail::fail(simdjson::TRAILING_CONTENT);
+    return result;
+}
+#endif
+
 // Universal convenience functions
 inline json from_string(const std::string& json_str) {
     return parse(json_str);
 }
 
+// Deferred parse. On AxzDict nested objects and arrays are only bracket-matched here and built on first
+// access from the converted text, which the document keeps without another copy; a syntax error inside
+// one throws AxzDictDeferredError from that access. Other backends parse eagerly.
+inline json parse_lazy(const std::string& json_str) {
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    if (json_str.empty()) {
+        return AxzDictCompat::create_typed(AXZ_DICT_OBJECT);
+    }
+    json result;
+    if (AXZ_FAILED(AxzJson::deserialize(to_axz_wstring(json_str), result, true))) {
+        throw std::runtime_error("AxzDict JSON parse error - invalid JSON format");
+    }
+    return result;
+#else
+    return parse(json_str);
+#endif
+}
+
 inline std::string to_string(const json& j, int indent = -1) {
     return dump(j, indent);
 }
 
+// Independent copy of a document, for serializing it after the owner's lock is released.
+// AxzDict copies share their containers, so it is cloned.
+inline json snapshot(const json& j) {
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    return j.clone();
+#else
+    return j;
+#endif
+}
+
+// Whether a number is stored as an integer, so encoders can give it back with the same type.
+// Only the backends json_binary.h and json_snapshot.h support have it.
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON || JSON_ADAPTER_BACKEND == JSONCPP || JSON_ADAPTER_BACKEND == AXZDICT
+inline bool is_integer(const json& j) {
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
+    return j.is_number_integer();
+#elif JSON_ADAPTER_BACKEND == JSONCPP
+    return j.type() == Json::intValue || j.type() == Json::uintValue;
+#else
+    return j.type() == AXZ_DICT_INTEGRAL;
+#endif
+}
+#endif
+
+// Child access without copying: a pointer / reference where the backend stores json values directly,
+// a value for AxzDict (a copy only shares the node, so it stays O(1)).
+// find_member() yields something that tests false when the key is missing; element() does not check bounds.
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
+    inline const json* find_member(const json& obj, const std::string& key) {
+        auto it = obj.find(key);
+        return it == obj.end() ? nullptr : &*it;
+    }
+    inline const json& element(const json& arr, size_t index) { return arr[index]; }
+#elif JSON_ADAPTER_BACKEND == JSONCPP
+    inline const json* find_member(const json& obj, const std::string& key) {
+        return obj.find(key.data(), key.data() + key.size());
+    }
+    inline const json& element(const json& arr, size_t index) { return arr[static_cast<Json::ArrayIndex>(index)]; }
+#else
+    inline std::optional<json> find_member(const json& obj, const std::string& key) {
+        if (!has_key(obj, key)) return std::nullopt;
+        return object_at(obj, key);
+    }
+    inline json element(const json& arr, size_t index) { return array_at(arr, index); }
+#endif
+
+// In-place edits (json_patch.h). with_member() / with_element() run fn on the stored child where the backend
+// hands out mutable children; AxzDict runs it on a copy that is written back afterwards, which is O(1) because
+// the copy shares the node. The member must exist and the index be in range; insert_element() also accepts
+// index == size.
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
+    template<typename Fn>
+    inline void with_member(json& obj, const std::string& key, Fn&& fn) { fn(*obj.find(key)); }
+    template<typename Fn>
+    inline void with_element(json& arr, size_t index, Fn&& fn) { fn(arr[index]); }
+    inline void insert_element(json& arr, size_t index, json value) {
+        arr.insert(arr.begin() + static_cast<std::ptrdiff_t>(index), std::move(value));
+    }
+    inline void erase_element(json& arr, size_t index) { arr.erase(index); }
+#elif JSON_ADAPTER_BACKEND == JSONCPP
+    template<typename Fn>
+    inline void with_member(json& obj, const std::string& key, Fn&& fn) { fn(obj[key]); }
+    template<typename Fn>
+    inline void with_element(json& arr, size_t index, Fn&& fn) { fn(arr[static_cast<Json::ArrayIndex>(index)]); }
+    inline void insert_element(json& arr, size_t index, json value) {
+        arr.insert(static_cast<Json::ArrayIndex>(index), std::move(value));
+    }
+    inline void erase_element(json& arr, size_t index) {
+        Json::Value removed;
+        arr.removeIndex(static_cast<Json::ArrayIndex>(index), &removed);
+    }
+#elif JSON_ADAPTER_BACKEND == AXZDICT
+    // Goes through the const operator[] and set()/insert()/replace(), so serialization caches stay valid
+    template<typename Fn>
+    inline void with_member(json& obj, const std::string& key, Fn&& fn) {
+        const axz_wstring wide_key = to_axz_wstring(key);
+        json child = std::as_const(obj)[wide_key];
+        fn(child);
+        obj.set(wide_key, child);
+    }
+    template<typename Fn>
+    inline void with_element(json& arr, size_t index, Fn&& fn) {
+        json child = std::as_const(arr)[index];
+        fn(child);
+        arr.replace(index, child);
+    }
+    inline void insert_element(json& arr, size_t index, json value) { arr.insert(index, value); }
+    inline void erase_element(json& arr, size_t index) { arr.remove(index); }
+#endif
+
+// Visit array elements in order; AxzDict walks its iterator instead of copying element by element
+template<typename Fn>
+inline void for_each_element(const json& arr, Fn&& fn) {
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    if (!arr.isArray()) return;
+    for (auto it = arr.begin(); it != arr.end(); ++it) {
+        fn(*it);
+    }
+#else
+    for (size_t i = 0, n = array_size(arr); i < n; ++i) {
+        fn(element(arr, i));
+    }
+#endif
+}
+
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON || JSON_ADAPTER_BACKEND == JSONCPP || JSON_ADAPTER_BACKEND == AXZDICT
+// Read-only view of a value inside a document. Reading a scalar through it copies only the scalar;
+// to_json() is the one place a subtree is copied. Valid until the owning document is modified.
+// AxzDict views hold a (shared) handle, the other backends a pointer.
+class json_cref {
+public:
+    json_cref() noexcept = default;
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    json_cref(const json& j) : node_(j), valid_(true) {}
+#else
+    json_cref(const json& j) noexcept : node_(&j) {}
+    explicit json_cref(const json* node) noexcept : node_(node) {}
+#endif
+
+    // False for a view returned by a failed member()/at() lookup
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    explicit operator bool() const noexcept { return valid_; }
+#else
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+#endif
+
+    bool is_null() const { return json_adapter::is_null(node()); }
+    bool is_bool() const { return json_adapter::is_bool(node()); }
+    bool is_number() const { return json_adapter::is_number(node()); }
+    bool is_string() const { return json_adapter::is_string(node()); }
+    bool is_array() const { return json_adapter::is_array(node()); }
+    bool is_object() const { return json_adapter::is_object(node()); }
+
+    bool get_bool() const { return json_adapter::get_bool(node()); }
+    int get_int() const { return json_adapter::get_int(node()); }
+    double get_double() const { return json_adapter::get_double(node()); }
+    std::string get_string() const { return json_adapter::get_string(node()); }
+    size_t array_size() const { return json_adapter::array_size(node()); }
+
+    json_cref member(const std::string& key) const {
+        if (!is_object()) return {};
+        auto found = find_member(node(), key);
+        return found ? json_cref(*found) : json_cref();
+    }
+    json_cref at(size_t index) const {
+        if (!is_array() || index >= array_size()) return {};
+#if JSON_ADAPTER_BACKEND == AXZDICT
+        return json_cref(element(node(), index));
+#else
+        return json_cref(&element(node(), index));
+#endif
+    }
+
+    json to_json() const { return node(); }
+
+    // The wrapped value itself, for calling other adapter functions without a copy
+    const json& node() const noexcept {
+#if JSON_ADAPTER_BACKEND == AXZDICT
+        return node_;
+#else
+        return *node_;
+#endif
+    }
+
+private:
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    json node_;
+    bool valid_ = false;
+#else
+    const json* node_ = nullptr;
+#endif
+};
+
+// Views of a member / element without copying it; the result tests false when it does not exist
+inline json_cref member_ref(const json& obj, const std::string& key) { return json_cref(obj).member(key); }
+inline json_cref element_ref(const json& arr, size_t index) { return json_cref(arr).at(index); }
+#endif
+
 // Universal convenience functions with perfect forwarding
 template<typename StringType>
 [[nodiscard]] JSON_FORCE_INLINE JSON_HOT json from_string(StringType&& json_str) {
@@ -1244,7 +1720,7 @@ template<int Backend = JSON_ADAPTER_BACKEND>
     } else if constexpr (Backend == JSONCPP) {
         return "JsonCpp";
     } else if constexpr (Backend == AXZDICT) {
-        return "AxzDict";
+        return JSON_ADAPTER_SIMDJSON_PARSE ? "simdjson+AxzDict" : "AxzDict";
     } else if constexpr (Backend == BOOST_JSON) {
         return "Boost.JSON";
     } else if constexpr (Backend == SAJSON) {
@@ -1283,6 +1759,7 @@ template<int Backend = JSON_ADAPTER_BACKEND>
     }
 }
 
+} // inline namespace JSON_ADAPTER_ABI_TAG
 } // namespace json_adapter
 
 // Export the json type to global namespace for compatibility
@@ -51,6 +51,18 @@
 
 #include "universal_json_adapter.h"
 
+// Streaming, patches, snapshots and the write-ahead log go through adapter functions that only the
+// nlohmann, JsonCpp and AxzDict backends implement
+#if JSON_ADAPTER_BACKEND == JSON11 || JSON_ADAPTER_BACKEND == RAPIDJSON
+    #error "UniversalObservableJson needs the nlohmann, JsonCpp or AxzDict backend"
+#endif
+
+#include "json_patch.h"
+#include "json_snapshot.h"
+#include "json_binary.h"
+#include "json_wal.h"
+#include "json_async_writer.h"
+
 // Performance optimization includes
 #include <iostream>
 #include <unordered_map>
@@ -64,6 +76,7 @@
 #include <memory>
 #include <chrono>
 #include <future>
+#include <exception>
 #include <optional>
 #include <variant>
 #include <type_traits>
@@ -101,47 +114,35 @@
 #define OBSERVABLE_COLD JSON_COLD
 #define OBSERVABLE_PREFETCH(addr) JSON_PREFETCH(addr, 0, 3)
 
+// The document classes depend on the backend, so they share the adapter's ABI-tagged inline namespace
+#define OBSERVABLE_JSON_NAMESPACE_BEGIN namespace universal_observable_json { inline namespace JSON_ADAPTER_ABI_TAG {
+#define OBSERVABLE_JSON_NAMESPACE_END } }
+
 // Thread-local storage for ultra-fast access
 namespace detail {
     // Thread-local notification buffers for zero-allocation notifications
-    thread_local std::vector<std::string_view> tl_path_cache;
-    thread_local std::vector<std::function<void()>> tl_notification_cache;
-    thread_local std::chrono::high_resolution_clock::time_point tl_last_notification = {};
+    inline thread_local std::vector<std::string_view> tl_path_cache;
+    inline thread_local std::vector<std::function<void()>> tl_notification_cache;
+    inline thread_local std::chrono::high_resolution_clock::time_point tl_last_notification = {};
     
     // Lock-free atomic counters for performance tracking
-    alignas(OBSERVABLE_CACHE_LINE_SIZE) std::atomic<uint64_t> total_notifications{0};
-    alignas(OBSERVABLE_CACHE_LINE_SIZE) std::atomic<uint64_t> total_subscriptions{0};
-    alignas(OBSERVABLE_CACHE_LINE_SIZE) std::atomic<uint64_t> total_modifications{0};
+    alignas(OBSERVABLE_CACHE_LINE_SIZE) inline std::atomic<uint64_t> total_notifications{0};
+    alignas(OBSERVABLE_CACHE_LINE_SIZE) inline std::atomic<uint64_t> total_subscriptions{0};
+    alignas(OBSERVABLE_CACHE_LINE_SIZE) inline std::atomic<uint64_t> total_modifications{0};
     
-    // SIMD-optimized path comparison for ultra-fast path matching
+    // SIMD path comparison (kernel chosen at startup by CPU feature)
     OBSERVABLE_FORCE_INLINE bool compare_paths_simd(const char* path1, const char* path2, size_t len) noexcept {
-#ifdef JSON_HAS_SIMD
-        if (len >= 16) {
-            const __m128i* p1 = reinterpret_cast<const __m128i*>(path1);
-            const __m128i* p2 = reinterpret_cast<const __m128i*>(path2);
-            
-            for (size_t i = 0; i < len / 16; ++i) {
-                __m128i a = _mm_loadu_si128(&p1[i]);
-                __m128i b = _mm_loadu_si128(&p2[i]);
-                __m128i cmp = _mm_cmpeq_epi8(a, b);
-                if (_mm_movemask_epi8(cmp) != 0xFFFF) return false;
-            }
-            
-            // Handle remaining bytes
-            for (size_t i = (len / 16) * 16; i < len; ++i) {
-                if (path1[i] != path2[i]) return false;
-            }
-            return true;
+        if (len < 32) {
+            return std::memcmp(path1, path2, len) == 0;
         }
-#endif
-        return std::memcmp(path1, path2, len) == 0;
+        return json_adapter::simd::kernels().equal(path1, path2, len);
     }
     
     // Thread-safe string pool for path interning
     class PathPool {
         alignas(OBSERVABLE_CACHE_LINE_SIZE) std::array<char, 8192> pool_;
         std::atomic<size_t> offset_{0};
-        std::unordered_map<std::string_view, std::string_view> interned_;
+        std::unordered_map<std::string_view, std::string_view, json_adapter::StringHash> interned_;
         mutable std::shared_mutex mutex_;
         
     public:
@@ -169,7 +170,7 @@ namespace detail {
                 std::memcpy(heap_str, path.data(), path.size());
                 heap_str[path.size()] = '\0';
                 std::string_view interned_view{heap_str, path.size()};
-                interned_[path] = interned_view;
+                interned_.emplace(interned_view, interned_view);  // key must outlive the caller's view
                 return interned_view;
             }
             
@@ -179,7 +180,7 @@ namespace detail {
             offset_.store(old_offset + path.size() + 1, std::memory_order_relaxed);
             
             std::string_view interned_view{dest, path.size()};
-            interned_[path] = interned_view;
+            interned_.emplace(interned_view, interned_view);  // key must outlive the caller's view
             return interned_view;
         }
         
@@ -287,7 +288,7 @@ inline ObservablePerformanceStats& get_performance_stats() {
     return stats;
 }
 
-namespace universal_observable_json {
+OBSERVABLE_JSON_NAMESPACE_BEGIN
 
 // Use the universal JSON adapter
 using json = json_adapter::json;
@@ -432,34 +433,10 @@ public:
         const char* end = start + path.size();
         const char* current = start;
         
-        // SIMD-optimized delimiter search for long paths
+        const auto& kernels = json_adapter::simd::kernels();
         while (current < end) {
             const char* segment_start = current;
-            
-            // Find next delimiter with SIMD when possible
-#ifdef JSON_HAS_SIMD
-            if (end - current >= 16) {
-                const __m128i delimiter = _mm_set1_epi8('/');
-                while (current + 16 <= end) {
-                    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
-                    __m128i cmp = _mm_cmpeq_epi8(chunk, delimiter);
-                    int mask = _mm_movemask_epi8(cmp);
-                    
-                    if (mask != 0) {
-                        // Found delimiter, find exact position
-                        int pos = __builtin_ctz(mask);
-                        current += pos;
-                        break;
-                    }
-                    current += 16;
-                }
-            }
-#endif
-            
-            // Fallback to standard search for remaining bytes
-            while (current < end && *current != '/') {
-                ++current;
-            }
+            current += kernels.find_byte(current, static_cast<size_t>(end - current), '/');
             
             if (current > segment_start) {
                 parts.emplace_back(segment_start, current);
@@ -504,29 +481,10 @@ public:
         const char* data = path.data();
         size_t len = path.size();
         
-        // SIMD-accelerated validation for forbidden characters
-#ifdef JSON_HAS_SIMD
-        if (len >= 16) {
-            const __m128i forbidden1 = _mm_setr_epi8('[', ']', '{', '}', '"', '\\', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0', '\0');
-            
-            for (size_t i = 0; i + 16 <= len; i += 16) {
-                __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
-                
-                // Check for forbidden characters
-                for (int j = 0; j < 6; ++j) { // Check first 6 forbidden chars
-                    __m128i forbidden_char = _mm_set1_epi8(reinterpret_cast<const char*>(&forbidden1)[j]);
-                    __m128i cmp = _mm_cmpeq_epi8(chunk, forbidden_char);
-                    if (_mm_movemask_epi8(cmp) != 0) return false;
-                }
-            }
-        }
-#endif
-        
-        // Standard validation for remaining bytes and edge cases
-        for (char c : path) {
-            if (c == '[' || c == ']' || c == '{' || c == '}' || c == '"' || c == '\\') {
-                return false;
-            }
+        // Forbidden characters
+        static constexpr char forbidden[] = {'[', ']', '{', '}', '"', '\\'};
+        if (json_adapter::simd::kernels().find_any(data, len, forbidden, sizeof(forbidden)) != len) {
+            return false;
         }
         
         // Check for empty segments (consecutive slashes)
@@ -618,8 +576,8 @@ private:
     detail::SafeQueue<std::function<void()>, 512> operation_queue_;
     
     // Thread-local batch buffer for zero-allocation batching
-    static thread_local std::array<std::function<void()>, 64> batch_buffer_;
-    static thread_local size_t batch_count_;
+    static inline thread_local std::array<std::function<void()>, 64> batch_buffer_;
+    static inline thread_local size_t batch_count_ = 0;
     
 public:
     // Thread-safe operation enqueuing
@@ -673,10 +631,6 @@ public:
     }
 };
 
-// Thread-local batch buffer initialization
-thread_local std::array<std::function<void()>, 64> BatchProcessor::batch_buffer_;
-thread_local size_t BatchProcessor::batch_count_ = 0;
-
 // Thread-safe event filter with proper synchronization
 class EventFilter {
 private:
@@ -827,6 +781,63 @@ struct BatchContext {
     }
 };
 
+// Bounded, append-only record of mutations for consumers that poll instead of subscribing.
+// Once full, the oldest entries are overwritten; a reader that fell that far behind is told so.
+class ChangeJournal {
+public:
+    enum class Op : uint8_t { Set, Remove, Merge, Clear, Replace };
+    
+    struct Entry {
+        uint64_t sequence = 0;
+        Op op = Op::Set;
+        std::string path;   // "" for Clear and Replace
+        json value;         // value after the change; null for Remove
+    };
+    
+    struct Batch {
+        std::vector<Entry> entries;     // oldest first
+        bool complete = true;           // false: entries after the requested sequence were already overwritten
+    };
+    
+    explicit ChangeJournal(size_t capacity) : ring_(std::max<size_t>(capacity, 1)) {}
+    
+    // Sequences are consecutive for as long as the journal exists
+    void append(uint64_t sequence, Op op, const std::string& path, json value) {
+        const size_t slot = (head_ + size_) % ring_.size();
+        ring_[slot] = Entry{sequence, op, path, std::move(value)};
+        if (size_ < ring_.size()) {
+            ++size_;
+        } else {
+            head_ = (head_ + 1) % ring_.size();
+        }
+    }
+    
+    Batch read(uint64_t after_sequence, size_t max_entries) const {
+        Batch batch;
+        if (size_ == 0) return batch;
+        
+        const uint64_t oldest = ring_[head_].sequence;
+        batch.complete = after_sequence + 1 >= oldest;
+        const uint64_t skip = batch.complete ? after_sequence + 1 - oldest : 0;
+        if (skip >= size_) return batch;
+        
+        const size_t count = std::min<uint64_t>(size_ - skip, max_entries);
+        batch.entries.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            batch.entries.push_back(ring_[(head_ + skip + i) % ring_.size()]);
+        }
+        return batch;
+    }
+    
+    size_t capacity() const noexcept { return ring_.size(); }
+    size_t size() const noexcept { return size_; }
+    
+private:
+    std::vector<Entry> ring_;
+    size_t head_ = 0;   // slot of the oldest entry
+    size_t size_ = 0;
+};
+
 // THE UNIVERSAL OBSERVABLE JSON CLASS - ENHANCED VERSION
 class UniversalObservableJson final {
 public:
@@ -845,17 +856,26 @@ public:
         : data_(initial_data)
         , notification_system_(std::make_unique<NotificationSystem>(2)) {}
     
+    // Document whose nested containers are parsed on first access (AxzDict), see json_adapter::parse_lazy
+    static UniversalObservableJson from_lazy_string(const std::string& json_str) {
+        return UniversalObservableJson(json_adapter::parse_lazy(json_str));
+    }
+    
     // Copy constructor
     UniversalObservableJson(const UniversalObservableJson& other) 
         : notification_system_(std::make_unique<NotificationSystem>(2)) {
         std::shared_lock<std::shared_mutex> lock(other.data_mutex_);
-        data_ = other.data_;
+        data_ = json_adapter::snapshot(other.data_);   // AxzDict copies would otherwise share nodes
     }
     
-    // Move constructor
+    // Move constructor: takes over the data, subscribers, change journal, sequence and write-ahead log
     UniversalObservableJson(UniversalObservableJson&& other) noexcept 
-        : data_(std::move(other.data_))
-        , notification_system_(std::move(other.notification_system_)) {
+        : notification_system_(std::move(other.notification_system_)) {
+        std::lock_guard<std::shared_mutex> data_lock(other.data_mutex_);
+        data_ = std::move(other.data_);
+        sequence_ = other.sequence_;
+        journal_ = std::move(other.journal_);
+        wal_ = std::move(other.wal_);
         std::lock_guard<std::mutex> lock(other.subscribers_mutex_);
         subscribers_ = std::move(other.subscribers_);
         next_id_ = other.next_id_;
@@ -864,36 +884,57 @@ public:
     // Assignment operators
     UniversalObservableJson& operator=(const UniversalObservableJson& other) {
         if (this != &other) {
-            std::lock(data_mutex_, other.data_mutex_);
-            std::lock_guard<std::shared_mutex> lock1(data_mutex_, std::adopt_lock);
-            std::shared_lock<std::shared_mutex> lock2(other.data_mutex_, std::adopt_lock);
-            
-            json old_data = data_;
-            data_ = other.data_;
-            
-            lock1.~lock_guard();
-            lock2.~shared_lock();
-            
-            notify_subscribers(data_, "", old_data);
+            const bool observed = has_subscriber_for("");
+            json old_data;
+            json new_data;
+            WalTicket durable;
+            {
+                std::lock(data_mutex_, other.data_mutex_);
+                std::lock_guard<std::shared_mutex> lock1(data_mutex_, std::adopt_lock);
+                std::shared_lock<std::shared_mutex> lock2(other.data_mutex_, std::adopt_lock);
+                
+                check_writable();
+                check_loggable(other.data_);
+                old_data = std::move(data_);
+                data_ = json_adapter::snapshot(other.data_);
+                record_change(ChangeJournal::Op::Replace, "", [this] { return data_; });
+                durable = log_change(WalOp::Replace, "", [this] { return data_; });
+                if (observed) new_data = json_adapter::snapshot(data_);   // later writers may change data_
+            }
+            make_durable(durable, [&] {
+                if (observed) notify_subscribers(new_data, "", old_data);
+            });
         }
         return *this;
     }
     
+    // Takes over the other document whole, like the move constructor. This document's own journal and
+    // write-ahead log are dropped; the subscribers taken over hear about the replaced contents.
     UniversalObservableJson& operator=(UniversalObservableJson&& other) noexcept {
         if (this != &other) {
-            std::lock_guard<std::shared_mutex> lock1(data_mutex_);
-            std::lock_guard<std::mutex> lock2(other.subscribers_mutex_);
-            
-            json old_data = data_;
-            data_ = std::move(other.data_);
-            subscribers_ = std::move(other.subscribers_);
-            next_id_ = other.next_id_;
-            notification_system_ = std::move(other.notification_system_);
-            
-            lock1.~lock_guard();
-            lock2.~lock_guard();
-            
-            notify_subscribers(data_, "", old_data);
+            json old_data;
+            json new_data;
+            bool observed = false;
+            {
+                std::lock(data_mutex_, other.data_mutex_);
+                std::lock_guard<std::shared_mutex> lock1(data_mutex_, std::adopt_lock);
+                std::lock_guard<std::shared_mutex> lock2(other.data_mutex_, std::adopt_lock);
+                std::lock(subscribers_mutex_, other.subscribers_mutex_);
+                std::lock_guard<std::mutex> lock3(subscribers_mutex_, std::adopt_lock);
+                std::lock_guard<std::mutex> lock4(other.subscribers_mutex_, std::adopt_lock);
+                
+                old_data = std::move(data_);
+                data_ = std::move(other.data_);
+                sequence_ = other.sequence_;
+                journal_ = std::move(other.journal_);
+                wal_ = std::move(other.wal_);
+                subscribers_ = std::move(other.subscribers_);
+                next_id_ = other.next_id_;
+                notification_system_ = std::move(other.notification_system_);
+                observed = !subscribers_.empty();
+                if (observed) new_data = json_adapter::snapshot(data_);
+            }
+            if (observed) notify_subscribers(new_data, "", old_data);
         }
         return *this;
     }
@@ -911,7 +952,7 @@ public:
         
         subscribers_.emplace(id, CallbackInfo(std::move(callback)));
         auto& info = subscribers_[id];
-        info.path_filter = path_filter;
+        info.path_filter = PathUtils::intern_path(path_filter);  // outlives the caller's string
         
         return id;
     }
@@ -925,7 +966,7 @@ public:
         
         subscribers_.emplace(id, CallbackInfo(std::move(callback)));
         auto& info = subscribers_[id];
-        info.path_filter = path_filter;
+        info.path_filter = PathUtils::intern_path(path_filter);  // outlives the caller's string
         info.debounce_delay = std::chrono::duration_cast<std::chrono::nanoseconds>(debounce_delay);
         
         return id;
@@ -949,49 +990,33 @@ public:
             throw std::invalid_argument("Cannot set empty path");
         }
         
+        // Only first-level keys are stored; a nested path addresses its first segment.
+        // Old and new values are copied only when some subscriber is listening on this path.
+        const std::string& key = parts[0];
+        const bool observed = has_subscriber_for(path);
         json old_value = json_adapter::make_null();
+        json new_value = json_adapter::make_null();
+        WalTicket durable;
         
         {
             std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            check_writable();
+            if constexpr (std::is_same_v<T, json>) check_loggable(value);
             
-            // Handle simple key case (no nested path)
-            if (parts.size() == 1) {
-                const std::string& key = parts[0];
-                
-                // Get old value if exists
-                if (json_adapter::is_object(data_) && json_adapter::has_key(data_, key)) {
-                    old_value = json_adapter::object_at(data_, key);
-                }
-                
-                // Set new value using backend-specific implementation
-                set_value_backend_specific(data_, key, value);
-            } else {
-                // Handle nested path - simplified implementation
-                // For now, just handle single-level paths
-                const std::string& key = parts[0];
-                
-                // Get old value if exists
-                if (json_adapter::is_object(data_) && json_adapter::has_key(data_, key)) {
-                    old_value = json_adapter::object_at(data_, key);
-                }
-                
-                // Set new value
-                set_value_backend_specific(data_, key, value);
-            }
-        }
-        
-        // Get new value and notify
-        json new_value;
-        {
-            std::shared_lock<std::shared_mutex> lock(data_mutex_);
-            if (json_adapter::is_object(data_) && json_adapter::has_key(data_, parts[0])) {
-                new_value = json_adapter::object_at(data_, parts[0]);
-            } else {
-                new_value = json_adapter::make_null();
+            if (observed) {
+                if (auto current = json_adapter::member_ref(data_, key)) old_value = current.to_json();
             }
+            
+            // Set new value using backend-specific implementation
+            set_value_backend_specific(data_, key, value);
+            
+            record_change(ChangeJournal::Op::Set, path, [&] { return json_adapter::member_ref(data_, key).to_json(); });
+            durable = log_change(WalOp::Set, key, [&] { return json_adapter::member_ref(data_, key).to_json(); });
+            if (observed) new_value = json_adapter::member_ref(data_, key).to_json();
         }
-        
-        notify_subscribers(new_value, path, old_value);
+        make_durable(durable, [&] {
+            if (observed) notify_subscribers(new_value, path, old_value);
+        });
     }
     
     // Array operations
@@ -1004,7 +1029,7 @@ public:
         int next_index = 0;
         while (true) {
             std::string indexed_key = array_key + "_" + std::to_string(next_index);
-            if (!json_adapter::has_key(data_, indexed_key)) {
+            if (!json_adapter::member_ref(data_, indexed_key)) {
                 break;
             }
             next_index++;
@@ -1020,34 +1045,46 @@ public:
     template<typename Container>
     void set_batch(const Container& key_value_pairs) {
         std::vector<std::tuple<std::string, json, json>> changes;
+        WalTicket durable;
         
         {
             std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            check_writable();
+            for (const auto& [key, value] : key_value_pairs) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(value)>, json>) check_loggable(value);
+            }
             
             for (const auto& [key, value] : key_value_pairs) {
+                const bool observed = has_subscriber_for(key);
                 json old_value = json_adapter::make_null();
                 
-                if (json_adapter::is_object(data_) && json_adapter::has_key(data_, key)) {
-                    old_value = json_adapter::object_at(data_, key);
+                if (observed) {
+                    if (auto current = json_adapter::member_ref(data_, key)) old_value = current.to_json();
                 }
                 
                 set_value_backend_specific(data_, key, value);
                 
-                json new_value = json_adapter::object_at(data_, key);
-                changes.emplace_back(key, new_value, old_value);
+                record_change(ChangeJournal::Op::Set, key, [&] { return json_adapter::member_ref(data_, key).to_json(); });
+                durable = log_change(WalOp::Set, key, [&] { return json_adapter::member_ref(data_, key).to_json(); });
+                if (observed) {
+                    changes.emplace_back(key, json_adapter::member_ref(data_, key).to_json(), std::move(old_value));
+                }
             }
         }
-        
-        // Notify about all changes
-        for (const auto& [key, new_val, old_val] : changes) {
-            notify_subscribers(new_val, key, old_val);
-        }
+        make_durable(durable, [&] {
+            for (const auto& [key, new_val, old_val] : changes) {
+                notify_subscribers(new_val, key, old_val);
+            }
+        });
     }
     
     // Get value with enhanced path support
     template<typename T = json>
     T get(const std::string& path = "") const {
         std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        if (OBSERVABLE_UNLIKELY(loading_ != nullptr)) {
+            return get_loading<T>(path);
+        }
         
         if (path.empty()) {
             if constexpr (std::is_same_v<T, json>) {
@@ -1070,32 +1107,16 @@ public:
             }
         }
         
-        // Handle simple key case (no nested path)
-        if (parts.size() == 1) {
-            const std::string& key = parts[0];
-            if (json_adapter::is_object(data_) && json_adapter::has_key(data_, key)) {
-                json value = json_adapter::object_at(data_, key);
-                if constexpr (std::is_same_v<T, json>) {
-                    return value;
-                } else {
-                    return extract_value<T>(value);
-                }
-            } else {
-                throw std::runtime_error("Key not found: " + key);
-            }
+        // Read through a view: only the requested scalar (or, for T = json, the member) is copied.
+        // Nested paths resolve to their first segment, like set().
+        auto value = json_adapter::member_ref(data_, parts[0]);
+        if (!value) {
+            throw std::runtime_error(parts.size() == 1 ? "Key not found: " + parts[0] : "Path not found: " + path);
+        }
+        if constexpr (std::is_same_v<T, json>) {
+            return value.to_json();
         } else {
-            // Handle nested path - for now, just check first level
-            const std::string& key = parts[0];
-            if (json_adapter::is_object(data_) && json_adapter::has_key(data_, key)) {
-                json value = json_adapter::object_at(data_, key);
-                if constexpr (std::is_same_v<T, json>) {
-                    return value;
-                } else {
-                    return extract_value<T>(value);
-                }
-            } else {
-                throw std::runtime_error("Path not found: " + path);
-            }
+            return extract_value<T>(value);
         }
     }
     
@@ -1116,13 +1137,11 @@ public:
             return true;
         }
         
-        // Handle simple key case
-        if (parts.size() == 1) {
-            return json_adapter::is_object(data_) && json_adapter::has_key(data_, parts[0]);
-        } else {
-            // Handle nested path - for now, just check first level
-            return json_adapter::is_object(data_) && json_adapter::has_key(data_, parts[0]);
+        // Nested paths check their first segment, like get()
+        if (OBSERVABLE_UNLIKELY(loading_ != nullptr)) {
+            return loading_->root().find(parts[0]).has_value();
         }
+        return static_cast<bool>(json_adapter::member_ref(data_, parts[0]));
     }
     
     // Enhanced remove operation with path support
@@ -1136,29 +1155,26 @@ public:
             return;
         }
         
+        // Nested paths remove their first segment, like set()
+        const std::string& key = parts[0];
+        const bool observed = has_subscriber_for(path);
         json old_value = json_adapter::make_null();
+        WalTicket durable;
         
         {
             std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            check_writable();
             
-            // Handle simple key case
-            if (parts.size() == 1) {
-                const std::string& key = parts[0];
-                if (json_adapter::is_object(data_) && json_adapter::has_key(data_, key)) {
-                    old_value = json_adapter::object_at(data_, key);
-                    remove_key_backend_specific(data_, key);
-                }
-            } else {
-                // Handle nested path - for now, just handle first level
-                const std::string& key = parts[0];
-                if (json_adapter::is_object(data_) && json_adapter::has_key(data_, key)) {
-                    old_value = json_adapter::object_at(data_, key);
-                    remove_key_backend_specific(data_, key);
-                }
+            if (auto current = json_adapter::member_ref(data_, key)) {
+                if (observed) old_value = current.to_json();
+                remove_key_backend_specific(data_, key);
+                record_change(ChangeJournal::Op::Remove, path, [] { return json_adapter::make_null(); });
+                durable = log_change(WalOp::Remove, key);
             }
         }
-        
-        notify_subscribers(json_adapter::make_null(), path, old_value);
+        make_durable(durable, [&] {
+            if (observed) notify_subscribers(json_adapter::make_null(), path, old_value);
+        });
     }
     
     // Async operations
@@ -1186,6 +1202,274 @@ public:
         }
     }
     
+    // How dump_to() reads the document while it streams
+    enum class DumpMode {
+        Locked,     // serialize under the shared lock: no copy, but writers wait until the sink is done
+        Snapshot    // copy the document under the lock, then serialize and write without holding it
+    };
+    
+    // Stream the document into a sink in chunks of at most chunk_size bytes instead of building one string.
+    // Returns false when the sink refused a chunk or serialization failed.
+    bool dump_to(const json_adapter::dump_sink& sink, int indent = -1, DumpMode mode = DumpMode::Locked,
+                 size_t chunk_size = json_adapter::DEFAULT_DUMP_CHUNK) const {
+        if (mode == DumpMode::Snapshot) {
+            json snapshot;
+            {
+                std::shared_lock<std::shared_mutex> lock(data_mutex_);
+                snapshot = json_adapter::snapshot(data_);
+            }
+            return json_adapter::dump_to(snapshot, sink, indent, chunk_size);
+        }
+        
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return json_adapter::dump_to(data_, sink, indent, chunk_size);
+    }
+    
+    // Write the document to `file` through a background writer (json_async_writer.h). The text is produced
+    // by dump_to() from a snapshot on this thread; the I/O, sync and rename happen on the writer's.
+    std::future<void> persist_async(json_adapter::AsyncFileWriter& writer, const std::string& file, int indent = -1) const {
+        std::string text;
+        const bool dumped = dump_to([&text](const char* data, size_t size) {
+            text.append(data, size);
+            return true;
+        }, indent, DumpMode::Snapshot);
+        if (!dumped) throw std::runtime_error("Failed to serialize JSON for " + file);
+        return writer.write_file(file, std::move(text));
+    }
+    
+    // RFC 6902 operations that turn the current document into `target` (e.g. for replicating a batch)
+    json_adapter::JsonPatch diff(const json& target) const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return json_adapter::diff(data_, target);
+    }
+    
+    // Apply an RFC 6902 patch atomically: if any operation fails, nothing changes and the exception propagates.
+    // The patch edits the document in place. Subscribers are notified once per touched path (including "from"
+    // of a move), not for the whole document, and values are copied only for paths someone listens on.
+    void apply_patch(const json_adapter::JsonPatch& patch) {
+        struct Touched {
+            std::vector<std::string> tokens;
+            std::string path;
+            bool observed = false;
+            json old_value;
+            json new_value;
+        };
+        std::vector<Touched> touched;
+        auto touch = [&touched](const std::string& pointer) {
+            auto tokens = json_adapter::patch_detail::split_pointer(pointer);
+            for (const auto& entry : touched) {
+                if (entry.tokens == tokens) return;
+            }
+            Touched entry;
+            entry.path = PathUtils::join_path(tokens);
+            entry.tokens = std::move(tokens);
+            touched.push_back(std::move(entry));
+        };
+        for (const auto& operation : patch) {
+            if (operation.op == json_adapter::PatchOperation::Op::Test) continue;
+            if (operation.op == json_adapter::PatchOperation::Op::Move) touch(operation.from);
+            touch(operation.path);
+        }
+        for (auto& entry : touched) {
+            entry.observed = has_subscriber_for(entry.path);
+        }
+        
+        auto lookup = [](const json& root, const std::vector<std::string>& tokens) {
+            json found = json_adapter::make_null();
+            try {
+                json_adapter::patch_detail::visit_at(root, tokens, 0,
+                                                     [&found](const json& value) { found = json_adapter::snapshot(value); });
+            } catch (const std::exception&) {
+                // absent: reported as null
+            }
+            return found;
+        };
+        
+        WalTicket durable;
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            check_writable();
+            const json logged = wal_ ? json_adapter::patch_to_json(patch) : json_adapter::make_null();
+            check_loggable(logged);
+            for (auto& entry : touched) {
+                if (entry.observed) entry.old_value = lookup(data_, entry.tokens);
+            }
+            json_adapter::apply_patch(data_, patch);
+            
+            for (auto& entry : touched) {
+                const auto op = entry.tokens.empty() ? ChangeJournal::Op::Replace
+                              : json_adapter::patch_detail::contains_at(data_, entry.tokens) ? ChangeJournal::Op::Set
+                              : ChangeJournal::Op::Remove;
+                record_change(op, entry.path, [&] { return lookup(data_, entry.tokens); });
+                if (entry.observed) entry.new_value = lookup(data_, entry.tokens);
+            }
+            durable = log_change(WalOp::Patch, "", [&] { return logged; });
+        }
+        make_durable(durable, [&] {
+            for (const auto& entry : touched) {
+                if (entry.observed) notify_subscribers(entry.new_value, entry.path, entry.old_value);
+            }
+        });
+    }
+    
+    // Write the document as a binary snapshot (json_snapshot.h). Only the copy is taken under the lock.
+    void save_snapshot(const std::string& file) const {
+        json copy;
+        {
+            std::shared_lock<std::shared_mutex> lock(data_mutex_);
+            copy = json_adapter::snapshot(data_);
+        }
+        json_adapter::write_snapshot(copy, file);
+    }
+    
+    // Replace the document with the snapshot's contents, built on a background thread. Until that is done,
+    // get() and has() are served from the reader: its lookups walk the mapped file without parsing it.
+    // Writes made meanwhile go to the old document and are replaced with it when loading completes.
+    std::future<void> load_snapshot_async(std::shared_ptr<const json_adapter::SnapshotReader> reader) {
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            loading_ = reader;
+        }
+        return std::async(std::launch::async, [this, reader = std::move(reader)]() {
+            json loaded;
+            try {
+                loaded = reader->materialize();
+            } catch (...) {
+                std::unique_lock<std::shared_mutex> lock(data_mutex_);
+                if (loading_ == reader) loading_.reset();
+                throw;
+            }
+            const bool observed = has_subscriber_for("");
+            json old_data;
+            json new_data;
+            WalTicket durable;
+            {
+                std::unique_lock<std::shared_mutex> lock(data_mutex_);
+                if (loading_ == reader) loading_.reset();   // a later load may have taken over
+                check_writable();
+                check_loggable(loaded);
+                old_data = std::move(data_);
+                data_ = std::move(loaded);
+                record_change(ChangeJournal::Op::Replace, "", [this] { return data_; });
+                durable = log_change(WalOp::Replace, "", [this] { return data_; });
+                if (observed) new_data = json_adapter::snapshot(data_);   // later writers may change data_
+            }
+            make_durable(durable, [&] {
+                if (observed) notify_subscribers(new_data, "", old_data);
+            });
+        });
+    }
+    
+    using JournalEntry = ChangeJournal::Entry;
+    using JournalBatch = ChangeJournal::Batch;
+    
+    // Record every mutation from now on in a ring of `capacity` entries, replacing any journal kept so far
+    void enable_journal(size_t capacity = 4096) {
+        std::unique_lock<std::shared_mutex> lock(data_mutex_);
+        journal_ = std::make_unique<ChangeJournal>(capacity);
+    }
+    
+    void disable_journal() {
+        std::unique_lock<std::shared_mutex> lock(data_mutex_);
+        journal_.reset();
+    }
+    
+    bool journal_enabled() const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return journal_ != nullptr;
+    }
+    
+    // Sequence number of the latest mutation. It counts from construction, journal or not.
+    uint64_t journal_sequence() const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return sequence_;
+    }
+    
+    // Up to max_entries mutations after `after_sequence`, oldest first; pass the last sequence seen to tail.
+    // An incomplete batch means the ring already dropped some of them: resync from journal_snapshot().
+    JournalBatch read_journal(uint64_t after_sequence, size_t max_entries = 1024) const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        if (!journal_) {
+            JournalBatch batch;
+            batch.complete = after_sequence >= sequence_;
+            return batch;
+        }
+        return journal_->read(after_sequence, max_entries);
+    }
+    
+    // The document together with the sequence it reflects, for starting or resyncing a consumer
+    std::pair<json, uint64_t> journal_snapshot() const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return {json_adapter::snapshot(data_), sequence_};
+    }
+    
+    // Persist every mutation to a write-ahead log in `directory` (json_wal.h); mutators return once their
+    // change is on disk. If the directory already holds a checkpoint and log, they are replayed and replace
+    // the current document; otherwise the current document becomes the first checkpoint. A log record that
+    // cannot be decoded throws, and the document and directory are left as they were.
+    void enable_durability(const std::string& directory, json_adapter::WalOptions options = {}) {
+        std::lock_guard<std::mutex> serial(checkpoint_mutex_);
+        std::filesystem::create_directories(directory);
+        auto recovered = json_adapter::read_checkpoint(directory);
+        
+        json old_data;
+        json new_data;
+        bool replaced = false;
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            if (wal_) throw std::logic_error("Durability is already enabled");
+            
+            json state = recovered ? std::move(recovered->first) : json_adapter::snapshot(data_);
+            size_t replayed = 0;
+            const uint64_t last = json_adapter::WriteAheadLog::replay(directory, recovered ? recovered->second : 0,
+                [&](json_adapter::WriteAheadLog::Record&& record) {
+                    apply_wal_record(state, record);
+                    ++replayed;
+                });
+            
+            replaced = recovered || replayed > 0;
+            if (replaced) {
+                // Sequences keep growing across restarts, so old records never look newer than a checkpoint
+                sequence_ = std::max(sequence_, last);
+                old_data = std::move(data_);
+                data_ = std::move(state);
+                new_data = data_;
+                record_change(ChangeJournal::Op::Replace, "", [this] { return data_; });
+            }
+            
+            // Start from a fresh checkpoint, so nothing recovered here is ever replayed again
+            auto log = std::make_shared<json_adapter::WriteAheadLog>(directory, options);
+            json_adapter::write_checkpoint(directory, data_, sequence_);
+            log->remove_segments_before(log->generation());
+            wal_ = std::move(log);
+        }
+        
+        if (replaced) notify_subscribers(new_data, "", old_data);
+    }
+    
+    // Write everything logged so far and stop logging
+    void disable_durability() {
+        std::lock_guard<std::mutex> serial(checkpoint_mutex_);
+        std::shared_ptr<json_adapter::WriteAheadLog> log;
+        {
+            std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            log = std::move(wal_);
+        }
+        // The log flushes its queue when the last writer waiting on it lets go
+    }
+    
+    bool durability_enabled() const {
+        std::shared_lock<std::shared_mutex> lock(data_mutex_);
+        return wal_ != nullptr;
+    }
+    
+    // Write a checkpoint of the current document and drop the log it makes redundant. Also happens on its
+    // own once the log passes WalOptions::checkpoint_bytes. No-op without durability.
+    void checkpoint() {
+        std::lock_guard<std::mutex> serial(checkpoint_mutex_);
+        checkpoint_locked();
+    }
+    
     // Get subscriber count
     size_t get_subscriber_count() const {
         std::lock_guard<std::mutex> lock(subscribers_mutex_);
@@ -1195,13 +1479,16 @@ public:
     // Clear all data
     void clear() {
         json old_data;
+        WalTicket durable;
         {
             std::unique_lock<std::shared_mutex> lock(data_mutex_);
+            check_writable();
             old_data = std::move(data_);
             data_ = json_adapter::make_object();
+            record_change(ChangeJournal::Op::Clear, "", [] { return json_adapter::make_object(); });
+            durable = log_change(WalOp::Clear, "");
         }
-        
-        notify_subscribers(json_adapter::make_object(), "", old_data);
+        make_durable(durable, [&] { notify_subscribers(json_adapter::make_object(), "", old_data); });
     }
     
     // Advanced operations
@@ -1214,10 +1501,11 @@ public:
                 return data_.object_items().size();
             #elif JSON_ADAPTER_BACKEND == RAPIDJSON
                 return data_.doc.MemberCount();
+            #elif JSON_ADAPTER_BACKEND == JSONCPP || JSON_ADAPTER_BACKEND == AXZDICT
+                return data_.size();
             #else
-                // Fallback: count manually
                 size_t count = 0;
-                // This would require iteration support
+                json_adapter::for_each_member(data_, [&count](const std::string&, const json&) { ++count; });
                 return count;
             #endif
         }
@@ -1230,10 +1518,17 @@ public:
     
     // Merge another observable JSON
     void merge(const UniversalObservableJson& other) {
+        const bool observed = has_subscriber_for("merge");
         std::shared_lock<std::shared_mutex> other_lock(other.data_mutex_);
         std::unique_lock<std::shared_mutex> this_lock(data_mutex_);
+        check_writable();
         
-        json old_data = data_;
+        if (wal_ && json_adapter::is_object(other.data_)) {
+            json_adapter::for_each_member(other.data_, [this](const std::string&, const json& value) { check_loggable(value); });
+        }
+        // data_ is changed in place below (and, after the unlock, by other writers), so the values the
+        // notification reports are copied while the lock is held
+        json old_data = observed ? json_adapter::snapshot(data_) : json_adapter::make_null();
         
         // Simple merge - copy all keys from other
         #if JSON_ADAPTER_BACKEND == NLOHMANN_JSON
@@ -1260,12 +1555,32 @@ public:
                     data_.doc.AddMember(key, value, data_.doc.GetAllocator());
                 }
             }
+        #else
+            if (json_adapter::is_object(other.data_)) {
+                json_adapter::for_each_member(other.data_, [this](const std::string& key, const json& value) {
+                    json_adapter::set_member(data_, key, json_adapter::snapshot(value));
+                });
+            }
         #endif
         
+        WalTicket durable;
+        if (json_adapter::is_object(other.data_)) {
+            json_adapter::for_each_member(other.data_, [this, &durable](const std::string& key, const json& value) {
+                record_change(ChangeJournal::Op::Merge, key, [&] { return value; });
+                durable = log_change(WalOp::Set, key, [&] { return value; });
+            });
+        }
+        
+        json new_data = json_adapter::make_null();
+        if (observed) {
+            new_data = json_adapter::snapshot(data_);
+        }
+        
         this_lock.unlock();
         other_lock.unlock();
-        
-        notify_subscribers(data_, "merge", old_data);
+        make_durable(durable, [&] {
+            if (observed) notify_subscribers(new_data, "merge", old_data);
+        });
     }
     
     // Wait for all pending notifications to complete
@@ -1280,6 +1595,8 @@ public:
         size_t pending_notifications = 0;
         size_t active_subscribers = 0;
         size_t data_size = 0;
+        uint64_t wal_records = 0;       // records logged since durability was enabled
+        uint64_t wal_syncs = 0;         // group writes; wal_records / wal_syncs writers per sync
         std::chrono::steady_clock::time_point last_update;
     };
     
@@ -1291,6 +1608,13 @@ public:
         }
         stats.data_size = size();
         stats.pending_notifications = notification_system_ ? notification_system_->queue_size() : 0;
+        {
+            std::shared_lock<std::shared_mutex> lock(data_mutex_);
+            if (wal_) {
+                stats.wal_records = wal_->records();
+                stats.wal_syncs = wal_->syncs();
+            }
+        }
         stats.last_update = std::chrono::steady_clock::now();
         return stats;
     }
@@ -1302,6 +1626,128 @@ private:
     mutable std::mutex subscribers_mutex_;
     size_t next_id_ = 1;
     std::unique_ptr<NotificationSystem> notification_system_;
+    uint64_t sequence_ = 0;                     // guarded by data_mutex_, like the journal
+    std::unique_ptr<ChangeJournal> journal_;
+    std::shared_ptr<json_adapter::WriteAheadLog> wal_;     // guarded by data_mutex_; waiters hold their own reference
+    std::mutex checkpoint_mutex_;                           // one checkpoint (or enable/disable) at a time
+    std::shared_ptr<const json_adapter::SnapshotReader> loading_;  // see load_snapshot_async(); guarded by data_mutex_
+    
+    using WalOp = json_adapter::WriteAheadLog::Op;
+    
+    struct WalTicket {
+        std::shared_ptr<json_adapter::WriteAheadLog> log;
+        uint64_t position = 0;
+    };
+    
+    // Caller holds data_mutex_ exclusively and has just called record_change(), whose sequence the record takes
+    template<typename ValueFn>
+    WalTicket log_change(WalOp op, const std::string& key, ValueFn&& value) {
+        if (OBSERVABLE_LIKELY(wal_ == nullptr)) return {};
+        const json current = value();
+        return {wal_, wal_->append(sequence_, op, key, &current)};
+    }
+    
+    WalTicket log_change(WalOp op, const std::string& key) {
+        if (OBSERVABLE_LIKELY(wal_ == nullptr)) return {};
+        return {wal_, wal_->append(sequence_, op, key, nullptr)};
+    }
+    
+    // After data_mutex_ is released: returns once the record is on disk, sharing the sync with other writers
+    void make_durable(const WalTicket& ticket) {
+        if (OBSERVABLE_LIKELY(ticket.log == nullptr)) return;
+        ticket.log->wait(ticket.position);
+        if (OBSERVABLE_UNLIKELY(ticket.log->wants_checkpoint())) {
+            std::unique_lock<std::mutex> serial(checkpoint_mutex_, std::try_to_lock);
+            if (serial.owns_lock() && ticket.log->wants_checkpoint()) checkpoint_locked();
+        }
+    }
+    
+    // make_durable(), then notify(). The change is visible already, so subscribers hear about it even when the
+    // log fails; the failure reaches the writer afterwards.
+    template<typename Notify>
+    void make_durable(const WalTicket& ticket, Notify&& notify) {
+        std::exception_ptr failure;
+        try {
+            make_durable(ticket);
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        notify();
+        if (failure) std::rethrow_exception(failure);
+    }
+    
+    // Caller holds data_mutex_ exclusively and has not changed anything yet. Once the log has failed, memory
+    // would drift from disk, so the document turns read-only: writes rethrow the log's error until durability
+    // is disabled, or enabled again, which reloads what the directory holds.
+    void check_writable() const {
+        if (OBSERVABLE_UNLIKELY(wal_ != nullptr)) wal_->throw_if_failed();
+    }
+    
+    // Caller holds data_mutex_ and has not changed anything yet. The log is appended after the change, so a
+    // value it could not replay (json_adapter::WriteAheadLog::check_value) is turned away here instead.
+    void check_loggable(const json& value) const {
+        if (OBSERVABLE_UNLIKELY(wal_ != nullptr)) json_adapter::WriteAheadLog::check_value(value);
+    }
+    
+    // Caller holds checkpoint_mutex_. Writers are held off only while the document is copied.
+    void checkpoint_locked() {
+        std::shared_ptr<json_adapter::WriteAheadLog> log;
+        json state;
+        uint64_t sequence = 0;
+        uint64_t generation = 0;
+        {
+            std::shared_lock<std::shared_mutex> lock(data_mutex_);
+            if (!wal_) return;
+            log = wal_;
+            state = json_adapter::snapshot(data_);
+            sequence = sequence_;
+            generation = log->rotate();
+        }
+        json_adapter::write_checkpoint(log->directory(), state, sequence);
+        log->remove_segments_before(generation);
+    }
+    
+    void apply_wal_record(json& target, const json_adapter::WriteAheadLog::Record& record) {
+        switch (record.op) {
+            case WalOp::Set:     json_adapter::set_member(target, record.key, record.value); break;
+            case WalOp::Remove:  if (json_adapter::has_key(target, record.key)) remove_key_backend_specific(target, record.key); break;
+            case WalOp::Clear:   target = json_adapter::make_object(); break;
+            case WalOp::Replace: target = record.value; break;
+            case WalOp::Patch:   json_adapter::apply_patch(target, json_adapter::patch_from_json(record.value)); break;
+        }
+    }
+    
+    // Caller holds data_mutex_ exclusively. The value is only built when a journal is kept.
+    template<typename ValueFn>
+    void record_change(ChangeJournal::Op op, const std::string& path, ValueFn&& value) {
+        ++sequence_;
+        if (OBSERVABLE_UNLIKELY(journal_ != nullptr)) {
+            journal_->append(sequence_, op, path, json_adapter::snapshot(value()));
+        }
+    }
+    
+    // Caller holds data_mutex_ and loading_ is set. Resolves the path like get(), but in the snapshot:
+    // only the value asked for is materialized.
+    template<typename T>
+    T get_loading(const std::string& path) const {
+        if (!path.empty() && !PathUtils::is_valid_path(path)) {
+            throw std::invalid_argument("Invalid path: " + path);
+        }
+        const auto parts = PathUtils::split_path(path);
+        json value;
+        if (parts.empty()) {
+            value = loading_->materialize();
+        } else if (auto member = loading_->root().find(parts[0])) {
+            value = member->materialize();
+        } else {
+            throw std::runtime_error(parts.size() == 1 ? "Key not found: " + parts[0] : "Path not found: " + path);
+        }
+        if constexpr (std::is_same_v<T, json>) {
+            return value;
+        } else {
+            return extract_value<T>(value);
+        }
+    }
     
     // Backend-specific value setting
     template<typename T>
@@ -1340,6 +1786,8 @@ private:
             } else if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, char>) {
                 // Handle string literals like "Alice"
                 target[key] = Json::Value(std::string(value));
+            } else if constexpr (std::is_same_v<T, json>) {
+                target[key] = value;
             } else {
                 // Try to handle other numeric types
                 if constexpr (std::is_integral_v<T>) {
@@ -1370,6 +1818,8 @@ private:
                 // Handle string literals like "Alice"
                 auto dict = json_adapter::make_string(std::string(value));
                 target.set(json_adapter::to_axz_wstring(key), dict);
+            } else if constexpr (std::is_same_v<T, json>) {
+                target.set(json_adapter::to_axz_wstring(key), json_adapter::snapshot(value));
             } else {
                 // Try to handle other numeric types
                 if constexpr (std::is_integral_v<T>) {
@@ -1437,25 +1887,26 @@ private:
         #endif
     }
     
+    // Reads straight out of the document through the view; nothing but the result is copied
     template<typename T>
-    T extract_value(const json& j) const {
+    T extract_value(json_adapter::json_cref j) const {
         try {
             if constexpr (std::is_same_v<T, bool>) {
-                return json_adapter::get_bool(j);
+                return j.get_bool();
             } else if constexpr (std::is_same_v<T, int>) {
-                return json_adapter::get_int(j);
+                return j.get_int();
             } else if constexpr (std::is_same_v<T, double>) {
-                return json_adapter::get_double(j);
+                return j.get_double();
             } else if constexpr (std::is_same_v<T, std::string>) {
-                return json_adapter::get_string(j);
+                return j.get_string();
             } else if constexpr (std::is_same_v<T, json>) {
-                return j;
+                return j.to_json();
             } else {
                 // For other types, try direct conversion
                 if constexpr (std::is_integral_v<T>) {
-                    return static_cast<T>(json_adapter::get_int(j));
+                    return static_cast<T>(j.get_int());
                 } else if constexpr (std::is_floating_point_v<T>) {
-                    return static_cast<T>(json_adapter::get_double(j));
+                    return static_cast<T>(j.get_double());
                 } else {
                     throw std::runtime_error("Unsupported type extraction");
                 }
@@ -1465,43 +1916,62 @@ private:
         }
     }
     
-    void notify_subscribers(const json& new_value, const std::string& path, const json& old_value) {
+    // Whether a change at `path` would reach any subscriber; lets writers skip copying old/new values.
+    // A subscriber added after this check is treated as having subscribed after the change.
+    bool has_subscriber_for(const std::string& path) const {
         std::lock_guard<std::mutex> lock(subscribers_mutex_);
-        
-        for (auto& [id, callback_info] : subscribers_) {
-            if (callback_info.should_call(path)) {
-                if (notification_system_) {
-                    // Async notification - capture values safely
-                    auto callback_copy = callback_info.callback;
-                    auto callback_id = id;
-                    notification_system_->enqueue_notification([this, callback_copy, new_value, path, old_value, callback_id]() mutable {
-                        try {
-                            callback_copy(new_value, path, old_value);
-                            // Update call count safely
-                            std::lock_guard<std::mutex> lock(subscribers_mutex_);
-                            auto it = subscribers_.find(callback_id);
-                            if (it != subscribers_.end()) {
-                                it->second.mark_called();
+        for (const auto& [id, callback_info] : subscribers_) {
+            if (callback_info.should_call(path)) return true;
+        }
+        return false;
+    }
+    
+    void notify_subscribers(const json& new_value, const std::string& path, const json& old_value) {
+        // Async jobs are queued after subscribers_mutex_ is released: a full queue runs the job inline,
+        // and the job takes that mutex to update its call count.
+        std::vector<std::function<void()>> jobs;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            
+            for (auto& [id, callback_info] : subscribers_) {
+                if (callback_info.should_call(path)) {
+                    if (notification_system_) {
+                        // Async notification - capture values safely
+                        auto callback_copy = callback_info.callback;
+                        auto callback_id = id;
+                        jobs.emplace_back([this, callback_copy, new_value, path, old_value, callback_id]() mutable {
+                            try {
+                                callback_copy(new_value, path, old_value);
+                                // Update call count safely
+                                std::lock_guard<std::mutex> lock(subscribers_mutex_);
+                                auto it = subscribers_.find(callback_id);
+                                if (it != subscribers_.end()) {
+                                    it->second.mark_called();
+                                }
+                            } catch (const std::exception& e) {
+                                std::cerr << "Async callback error: " << e.what() << std::endl;
                             }
+                        });
+                    } else {
+                        // Sync notification
+                        try {
+                            callback_info.callback(new_value, path, old_value);
+                            callback_info.mark_called();
                         } catch (const std::exception& e) {
-                            std::cerr << "Async callback error: " << e.what() << std::endl;
+                            std::cerr << "Callback error: " << e.what() << std::endl;
                         }
-                    });
-                } else {
-                    // Sync notification
-                    try {
-                        callback_info.callback(new_value, path, old_value);
-                        callback_info.mark_called();
-                    } catch (const std::exception& e) {
-                        std::cerr << "Callback error: " << e.what() << std::endl;
                     }
                 }
             }
         }
+        
+        for (auto& job : jobs) {
+            notification_system_->enqueue_notification(std::move(job));
+        }
     }
 };
 
 // Type alias for convenience
 using ObservableJson = UniversalObservableJson;
 
-} // namespace universal_observable_json
+OBSERVABLE_JSON_NAMESPACE_END
@@ -4,17 +4,37 @@
 
 #include "../include/universal_observable_json.h"
 #include "../include/universal_json_adapter.h"  // For backend macros
+#include "../include/mapped_observable_json.h"
+#include "../include/any_observable_json_backend.h"
 #include <iostream>
 #include <cassert>
+#include <algorithm>
+#include <cmath>
+#include <mutex>
 #include <thread>
 #include <chrono>
 #include <vector>
 #include <string>
 #include <atomic>
 #include <future>
+#include <fstream>
 #include <random>
 #include <memory>
+#include <set>
+#include <limits>
+#include <sstream>
 #include <cstdlib>  // For getenv
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#if JSON_ADAPTER_BACKEND == AXZDICT
+#include "axz_simd.h"
+#endif
+#if defined(__linux__)
+#include <csignal>
+#include <sys/resource.h>
+#endif
 
 using namespace universal_observable_json;
 
@@ -690,6 +710,1523 @@ void test_exception_safety() {
         
         std::cout << "[Backend compatibility test passed for: " << backend_name << "] ";
     }
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    // Test 21: AxzDict Lazy Parsing
+    void test_axzdict_lazy_parsing() {
+        const axz_wstring text = L"{\"service\": \"config\", \"limits\": {\"cpu\": 4, \"zones\": [1, 2, 3]}, "
+                                 L"\"broken\": {\"flag\": tru}}";
+        
+        // Eager parsing rejects the malformed subtree up front
+        AxzDict eager;
+        [[maybe_unused]] axz_rc rc = AxzJson::deserialize(text, eager);
+        assert(AXZ_FAILED(rc));
+        
+        // Lazy parsing only matches brackets, so the untouched subtree does not matter
+        AxzDict lazy;
+        rc = AxzJson::deserialize(text, lazy, true);
+        assert(AXZ_SUCCESS(rc));
+        assert(lazy.isObject());
+        assert(lazy.size() == 3);
+        assert(lazy[L"service"].stringVal() == L"config");
+        
+        const AxzDict& limits = lazy[L"limits"];
+        assert(limits.isObject());
+        assert(limits[L"cpu"].intVal() == 4);
+        
+        int32_t sum = 0;
+        for (const auto& zone : limits[L"zones"]) {
+            sum += zone.intVal();
+        }
+        assert(sum == 6);
+        
+        // Copies share the materialized subtree
+        AxzDict copy = lazy;
+        assert(copy[L"limits"][L"zones"].size() == 3);
+        
+        // A malformed subtree keeps its type but throws on every access
+        assert(lazy[L"broken"].isObject());
+        for (int attempt = 0; attempt < 2; ++attempt) {
+            [[maybe_unused]] bool threw = false;
+            try {
+                (void)lazy[L"broken"].size();
+            } catch (const AxzDictDeferredError&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+        
+        // Unbalanced brackets are still caught while scanning
+        AxzDict unbalanced;
+        rc = AxzJson::deserialize(L"{\"a\": [1, 2}", unbalanced, true);
+        assert(AXZ_FAILED(rc));
+        
+        // Serialization walks through the deferred nodes
+        AxzDict valid;
+        rc = AxzJson::deserialize(L"{\"a\": {\"b\": [true, null, \"x\"]}}", valid, true);
+        assert(AXZ_SUCCESS(rc));
+        axz_wstring out;
+        rc = AxzJson::serialize(valid, out);
+        assert(AXZ_SUCCESS(rc));
+        assert(out == L"{\"a\": {\"b\": [true, null, \"x\"]}}");
+        
+        // Public entry points: the adapter and the observable document defer the same way
+        json deferred = json_adapter::parse_lazy(R"({"a": {"b": 7}, "bad": [1, tru]})");
+        assert(json_adapter::member_ref(deferred, "a").member("b").get_int() == 7);
+        
+        auto observable = UniversalObservableJson::from_lazy_string(R"({"limits": {"cpu": 4}, "bad": {"x": }})");
+        assert(json_adapter::member_ref(observable.get<json>("limits"), "cpu").get_int() == 4);
+        [[maybe_unused]] bool threw = false;
+        try {
+            (void)json_adapter::member_ref(observable.get<json>("bad"), "x");
+        } catch (const AxzDictDeferredError&) {
+            threw = true;
+        }
+        assert(threw);
+    }
+    // Test 22: AxzDict Arena Allocation
+    void test_axzdict_arena_allocation() {
+        auto arena = std::make_shared<AxzDictArena>();
+        std::weak_ptr<AxzDictArena> arena_ref = arena;
+        
+        AxzDict doc;
+        {
+            AxzDictArenaScope scope(std::move(arena));
+            [[maybe_unused]] axz_rc rc = AxzJson::deserialize(L"{\"values\": [1000, 2000, 3000.5], \"name\": \"arena\"}", doc);
+            assert(AXZ_SUCCESS(rc));
+            assert(AxzDictArenaScope::current() != nullptr);
+            assert(AxzDictArenaScope::current()->used() > 0);
+        }
+        assert(AxzDictArenaScope::current() == nullptr);
+        
+        // The document works as usual and keeps the arena alive
+        assert(doc[L"values"].size() == 3);
+        assert(doc[L"values"][0].intVal() == 1000);
+        assert(doc[L"name"].stringVal() == L"arena");
+        assert(!arena_ref.expired());
+        
+        // Values created outside the scope go to the heap again
+        doc[L"extra"] = 7777;
+        
+        // Dropping the document releases the whole arena at once
+        doc.drop();
+        assert(arena_ref.expired());
+    }
+    
+    // Test 23: AxzDict Inline Scalars
+    void test_axzdict_inline_scalars() {
+        AxzDict value(42);
+        assert(value.type() == AxzDictType::INTEGRAL);
+        assert(value.intVal() == 42);
+        assert(value.numberVal() == 42.0);
+        
+        // Copies of scalars are independent values
+        AxzDict copy = value;
+        copy = 2.5;
+        assert(value.intVal() == 42);
+        assert(copy.type() == AxzDictType::NUMBER);
+        assert(copy.numberVal() == 2.5);
+        
+        // Moved-from values become null
+        AxzDict moved = std::move(copy);
+        assert(moved.numberVal() == 2.5);
+        assert(copy.isNull());
+        
+        // Scalars reject string and container operations as before
+        AxzDict flag(true);
+        assert(flag.boolVal());
+        axz_wstring text;
+        [[maybe_unused]] axz_rc rc = flag.val(text);
+        assert(rc == AXZ_ERROR_NOT_SUPPORT);
+        [[maybe_unused]] bool threw = false;
+        try { flag.intVal(); } catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        
+        // Switching between scalar and container types
+        flag.become(AxzDictType::ARRAY);
+        rc = flag.add(AxzDict(1));
+        assert(AXZ_SUCCESS(rc));
+        assert(flag.size() == 1);
+        flag = false;
+        assert(flag.type() == AxzDictType::BOOL && !flag.boolVal());
+        
+        AxzDict parsed;
+        rc = AxzJson::deserialize(L"[1, true, null]", parsed);
+        assert(AXZ_SUCCESS(rc));
+        axz_wstring json;
+        rc = AxzJson::serialize(parsed, json);
+        assert(AXZ_SUCCESS(rc));
+        assert(json == L"[1, true, null]");
+        
+#if !AXZDICT_UNSYNCHRONIZED
+        // The one-word lock lets a writer in under a steady read load
+        AxzDict shared(AxzDictType::ARRAY);
+        std::atomic<bool> stop{false};
+        std::vector<std::thread> readers;
+        for (int i = 0; i < 4; ++i) {
+            readers.emplace_back([&]() {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    (void)shared.size();
+                }
+            });
+        }
+        for (int i = 0; i < 100; ++i) {
+            shared.add(AxzDict(i));
+        }
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+        assert(shared.size() == 100);
+#endif
+    }
+    
+    // Test 24: AxzDict Composite Operations (per-node locking)
+    void test_axzdict_composite_operations() {
+        AxzDict doc(AxzDictType::OBJECT);
+        [[maybe_unused]] axz_rc rc = doc.set_path(L"name", AxzDict(L"first"));
+        assert(AXZ_SUCCESS(rc));
+        
+        AxzDict patch(AxzDictType::OBJECT);
+        patch.set(L"name", AxzDict(L"second"));
+        patch.set(L"count", AxzDict(3));
+        doc.merge(patch, false);
+        
+        AxzDict result;
+        rc = doc.get_path(L"name", result);
+        assert(AXZ_SUCCESS(rc));
+        assert(result.stringVal() == L"first");
+        assert(doc.has_path(L"count"));
+        assert(!doc.empty());
+        assert(doc.get_if<int32_t>() == std::nullopt);
+        
+#if AXZDICT_UNSYNCHRONIZED
+        assert(doc.get_access_count() == 0);
+#else
+        assert(doc.get_access_count() > 0);
+#endif
+    }
+    
+    // Test 25: AxzDict Interned Object Keys
+    void test_axzdict_interned_keys() {
+        [[maybe_unused]] const size_t atoms_before = axz_performance::g_string_pool.size();
+        
+        AxzDict first(AxzDictType::OBJECT);
+        AxzDict second(AxzDictType::OBJECT);
+        first.set(L"interned_sensor_reading", AxzDict(1));
+        second.set(L"interned_sensor_reading", AxzDict(2));
+        assert(axz_performance::g_string_pool.size() == atoms_before + 1);
+        
+        // Lookups of unknown keys do not grow the atom table
+        AxzDict missing;
+        [[maybe_unused]] axz_rc rc = first.val(L"interned_never_stored", missing);
+        assert(rc == AXZ_ERROR_NOT_FOUND);
+        assert(!first.has(L"interned_never_stored"));
+        assert(axz_performance::g_string_pool.size() == atoms_before + 1);
+        
+        assert(first[L"interned_sensor_reading"].intVal() == 1);
+        assert(second[L"interned_sensor_reading"].intVal() == 2);
+        assert(first.keys() == axz_dict_keys{L"interned_sensor_reading"});
+        
+        rc = first.remove(L"interned_sensor_reading");
+        assert(AXZ_SUCCESS(rc));
+        assert(first.size() == 0);
+        assert(second.size() == 1);
+        
+        axz_wstring json;
+        rc = AxzJson::serialize(second, json);
+        assert(AXZ_SUCCESS(rc));
+        assert(json == L"{\"interned_sensor_reading\": 2}");
+    }
+    // Test 26: AxzDict Object Shapes
+    void test_axzdict_object_shapes() {
+        // Records with the same keys share a shape; values iterate in insertion order
+        AxzDict records(AxzDictType::ARRAY);
+        for (int32_t i = 0; i < 3; ++i) {
+            AxzDict record(AxzDictType::OBJECT);
+            record.set(L"shape_id", AxzDict(i));
+            record.set(L"shape_name", AxzDict(L"rec"));
+            record.set(L"shape_score", AxzDict(i * 10));
+            [[maybe_unused]] axz_rc rc = records.add(std::move(record));
+            assert(AXZ_SUCCESS(rc));
+        }
+        
+        AxzDict& second = records[1];
+        std::vector<AxzDictType> order;
+        for (const auto& value : second) {
+            order.push_back(value.type());
+        }
+        assert((order == std::vector<AxzDictType>{AxzDictType::INTEGRAL, AxzDictType::STRING, AxzDictType::INTEGRAL}));
+        
+        // Replacing keeps the slot, removing switches only this record to a private layout
+        [[maybe_unused]] axz_rc rc = second.add(L"shape_score", AxzDict(99));
+        assert(rc == AXZ_OK_REPLACED);
+        rc = second.remove(L"shape_name");
+        assert(AXZ_SUCCESS(rc));
+        assert(second.size() == 2);
+        assert(!second.has(L"shape_name"));
+        assert(second[L"shape_score"].intVal() == 99);
+        second.set(L"shape_extra", AxzDict(true));
+        assert(second[L"shape_extra"].boolVal());
+        assert(records[0][L"shape_name"].stringVal() == L"rec");
+        assert(records[2].size() == 3);
+        
+        // Wide objects fall back to dictionary mode and keep working
+        AxzDict wide(AxzDictType::OBJECT);
+        for (int32_t i = 0; i < 100; ++i) {
+            wide.set(L"wide_key_" + std::to_wstring(i), AxzDict(i));
+        }
+        assert(wide.size() == 100);
+        assert(wide[L"wide_key_73"].intVal() == 73);
+        rc = wide.remove(L"wide_key_10");
+        assert(AXZ_SUCCESS(rc));
+        assert(wide.size() == 99);
+        assert(!wide.has(L"wide_key_10"));
+        assert(wide[L"wide_key_99"].intVal() == 99);
+        
+        int32_t expected = 0;
+        for ([[maybe_unused]] const auto& value : wide) {
+            if (expected == 10) ++expected;
+            assert(value.intVal() == expected);
+            ++expected;
+        }
+        assert(expected == 100);
+    }
+    
+    // Test 27: AxzDict Small Object Lookup
+    void test_axzdict_small_object_lookup() {
+        AxzDict small(AxzDictType::OBJECT);
+        small.set(L"", AxzDict(0));
+        small.set(L"ab", AxzDict(1));
+        small.set(L"ac", AxzDict(2));
+        small.set(L"abc", AxzDict(3));
+        
+        int32_t value = -1;
+        [[maybe_unused]] axz_rc rc = small.val(L"ac", value);
+        assert(AXZ_SUCCESS(rc) && value == 2);
+        rc = small.val(L"abc", value);
+        assert(AXZ_SUCCESS(rc) && value == 3);
+        rc = small.val(L"", value);
+        assert(AXZ_SUCCESS(rc) && value == 0);
+        rc = small.val(L"ad", value);
+        assert(rc == AXZ_ERROR_NOT_FOUND);
+        
+        rc = small.add(L"ab", AxzDict(10));
+        assert(rc == AXZ_OK_REPLACED);
+        assert(small[L"ab"].intVal() == 10);
+        assert(small.size() == 4);
+        
+        std::vector<int32_t> values;
+        for (const auto& item : small) {
+            values.push_back(item.intVal());
+        }
+        assert((values == std::vector<int32_t>{0, 10, 2, 3}));
+    }
+    
+    // Test 30: AxzDict JSON Writer
+    void test_axzdict_json_writer() {
+        AxzDict object(AxzDictType::OBJECT);
+        object.set(L"b", AxzDict(0.1));
+        object.set(L"a", AxzDict(2.0));
+        object.set(L"text", AxzDict(L"say \"hi\"\n\x01"));
+        object.set(L"nan", AxzDict(std::numeric_limits<double>::quiet_NaN()));
+        object.set(L"list", AxzDict(AxzDictType::ARRAY));
+        
+        // Insertion order, shortest round-trip doubles, NaN as null
+        axz_wstring json;
+        [[maybe_unused]] axz_rc rc = AxzJson::serialize(object, json);
+        assert(AXZ_SUCCESS(rc));
+        assert(json == L"{\"b\": 0.1, \"a\": 2.0, \"text\": \"say \\\"hi\\\"\\n\\u0001\", \"nan\": null, \"list\": []}");
+        
+        AxzDict parsed;
+        rc = AxzJson::deserialize(json, parsed);
+        assert(AXZ_SUCCESS(rc));
+        assert(parsed[L"b"].isNumber() && parsed[L"b"].numberVal() == 0.1);
+        assert(parsed[L"a"].isNumber() && parsed[L"a"].numberVal() == 2.0);
+        assert(parsed[L"text"].stringRef() == L"say \"hi\"\n\x01");
+        
+        const double values[] = {1.0 / 3.0, 1e300, -2.5e-308, 123456789.125};
+        for (double value : values) {
+            axz_wstring text;
+            rc = AxzJson::serialize(AxzDict(value), text);
+            AxzDict back;
+            rc = AxzJson::deserialize(text, back);
+            assert(AXZ_SUCCESS(rc) && back.numberVal() == value);
+        }
+        
+        std::vector<axz_wstring> keys;
+        for (auto it = object.cbegin(); it != object.cend(); ++it) {
+            keys.push_back(it.key());
+        }
+        assert((keys == std::vector<axz_wstring>{L"b", L"a", L"text", L"nan", L"list"}));
+        
+        axz_wstring nice;
+        AxzDict nested(AxzDictType::OBJECT);
+        nested.set(L"x", AxzDict(AxzDictType::ARRAY));
+        nested[L"x"].add(AxzDict(1));
+        rc = AxzJson::serialize(nested, nice, true);
+        assert(AXZ_SUCCESS(rc));
+        assert(nice == L"{\n    \"x\": [\n        1\n    ]\n}");
+    }
+    
+    // Test 31: AxzDict UTF-8 Output
+    void test_axzdict_utf8_output() {
+        // Non-Latin-1 text survives the adapter in both directions
+        const std::string text = "caf\xC3\xA9 \xE2\x82\xAC \xF0\x9F\x98\x80";
+        auto doc = json_adapter::parse("{\"s\": \"" + text + "\"}");
+        assert(json_adapter::get_string(doc[L"s"]) == text);
+        assert(json_adapter::dump(doc) == "{\"s\": \"" + text + "\"}");
+        
+        // Malformed input and unpaired surrogates become U+FFFD
+        axz_wstring wide;
+        AxzJson::fromUtf8("a\xC0\xAF" "b\xE2\x82", 6, wide);
+        assert(wide == L"a\xFFFD" L"b\xFFFD");
+        std::string utf8;
+        const wchar_t surrogate[] = {L'x', static_cast<wchar_t>(0xD800), L'y'};
+        AxzJson::toUtf8(surrogate, 3, utf8);
+        assert(utf8 == "x\xEF\xBF\xBDy");
+        
+        // The sink gets the same bytes as the string overload, never more than a chunk at a time
+        AxzDict big(AxzDictType::ARRAY);
+        for (int i = 0; i < 5000; ++i) {
+            big.add(AxzDict(L"\x20AC value \x1F600"));
+        }
+        std::string whole;
+        [[maybe_unused]] axz_rc rc = AxzJson::serialize(big, whole, true);
+        assert(AXZ_SUCCESS(rc));
+        std::string streamed;
+        size_t calls = 0;
+        rc = AxzJson::serialize(big, [&](const char* data, size_t size) -> axz_rc {
+            assert(size > 0 && size <= 4096);
+            streamed.append(data, size);
+            ++calls;
+            return AXZ_OK;
+        }, true, 1);
+        assert(AXZ_SUCCESS(rc) && streamed == whole && calls > 1);
+        
+        std::ostringstream out;
+        rc = AxzJson::serialize(big, AxzJson::streamSink(out), true);
+        assert(AXZ_SUCCESS(rc) && out.str() == whole);
+        
+        // A failing sink stops the serialization and its rc comes back
+        calls = 0;
+        rc = AxzJson::serialize(big, [&](const char*, size_t) -> axz_rc {
+            ++calls;
+            return AXZ_ERROR_INVALID_OUTPUT;
+        }, false, 4096);
+        assert(rc == AXZ_ERROR_INVALID_OUTPUT && calls == 1);
+    }
+    
+    // Test 33: AxzDict Serialization Cache
+    void test_axzdict_serialization_cache() {
+        AxzDict doc(AxzDictType::OBJECT);
+        for (const wchar_t* name : {L"a", L"b"}) {
+            AxzDict section(AxzDictType::OBJECT);
+            for (int i = 0; i < 50; ++i) {
+                section.set(L"key" + std::to_wstring(i), AxzDict(L"value " + std::to_wstring(i)));
+            }
+            doc.set(name, section);
+        }
+        const AxzDict& view = doc;
+        [[maybe_unused]] const auto fresh = [&]() {
+            std::string json;
+            AxzJson::serialize(doc, json);
+            return json;
+        };
+        
+        std::string cached;
+        [[maybe_unused]] axz_rc rc = AxzJson::serialize(doc, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached == fresh());
+        const auto root_text = view.jsonCache(nullptr);
+        const auto b_text = view[L"b"].jsonCache(nullptr);
+        assert(root_text && b_text);
+        
+        // A change below "a" drops "a" and the root, and leaves "b" alone
+        AxzDict section_a = view[L"a"];
+        section_a.set(L"key3", AxzDict(3));
+        assert(!view.jsonCache(nullptr) && !view[L"a"].jsonCache(nullptr));
+        assert(view[L"b"].jsonCache(nullptr) == b_text);
+        rc = AxzJson::serialize(doc, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached == fresh() && cached.find("\"key3\": 3") != std::string::npos);
+        assert(view[L"b"].jsonCache(nullptr) == b_text);
+        
+        // Copies share the container, so a change through one reaches the document's cache as well
+        AxzDict alias = view[L"b"];
+        alias.remove(L"key0");
+        assert(!view.jsonCache(nullptr));
+        rc = AxzJson::serialize(doc, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached == fresh() && view[L"b"].size() == 49);
+        
+        // Writes through held references bypass the cache, so containers that handed one out are written afresh
+        AxzDict& held_leaf = doc[L"b"][L"key1"];
+        AxzDict& held_section = doc[L"a"];
+        rc = AxzJson::serialize(doc, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached == fresh());
+        held_leaf = AxzDict(42);
+        rc = AxzJson::serialize(doc, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached == fresh() && cached.find("\"key1\": 42") != std::string::npos);
+        held_section = AxzDict(axz_dict_array{});
+        rc = AxzJson::serialize(doc, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached == fresh() && cached.find("\"a\": []") != std::string::npos);
+        assert(!view.jsonCache(nullptr) && !view[L"b"].jsonCache(nullptr));
+        
+        // Iterators hand out the same references
+        AxzDict list(AxzDictType::ARRAY);
+        for (int i = 0; i < 100; ++i) list.add(AxzDict(L"item " + std::to_wstring(i)));
+        rc = AxzJson::serialize(list, cached, false, true);
+        auto it = list.begin();
+        *it = AxzDict(-1);
+        rc = AxzJson::serialize(list, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached.rfind("[-1, ", 0) == 0);
+        
+        // Containers that never handed out a reference keep caching
+        AxzDict section_c(AxzDictType::OBJECT);
+        for (int i = 0; i < 50; ++i) section_c.set(L"key" + std::to_wstring(i), AxzDict(i));
+        doc.set(L"c", section_c);
+        rc = AxzJson::serialize(doc, cached, false, true);
+        assert(AXZ_SUCCESS(rc) && cached == fresh() && view[L"c"].jsonCache(nullptr));
+    }
+#endif
+    
+    // Test 28: Key Hashing
+    void test_key_hashing() {
+        // Deterministic for a seed, seed-dependent, and every input byte matters at every length
+        const std::string text(100, 'k');
+        std::set<uint64_t> hashes;
+        for (size_t len = 0; len <= text.size(); ++len) {
+            const uint64_t h = json_adapter::hash_bytes(text.data(), len, 1);
+            assert(h == json_adapter::hash_bytes(text.data(), len, 1));
+            assert(h != json_adapter::hash_bytes(text.data(), len, 2));
+            hashes.insert(h);
+            if (len > 0) {
+                std::string flipped = text.substr(0, len);
+                flipped[len / 2] ^= 1;
+                assert(h != json_adapter::hash_bytes(flipped.data(), len, 1));
+            }
+        }
+        assert(hashes.size() == text.size() + 1);
+        assert(json_adapter::StringHash{}(std::string("path.to.key")) == json_adapter::StringHash{}("path.to.key"));
+        
+        // Interned paths own their characters
+        std::string path = "hashing.test.path";
+        [[maybe_unused]] std::string_view interned = detail::get_path_pool().intern(path);
+        path.assign(path.size(), 'x');
+        assert(interned == "hashing.test.path");
+        assert(detail::get_path_pool().intern("hashing.test.path").data() == interned.data());
+        
+#if JSON_ADAPTER_BACKEND == AXZDICT
+        const axz_wstring key = L"sensor_temperature";
+        assert(axz_hash_internal::UltraFastWStringHash{}(key) == axz_hash_internal::UltraFastWStringHash{}(axz_wstring(key)));
+        assert(axz_hash_internal::hash_wstring(key.data(), key.size(), 7) != axz_hash_internal::hash_wstring(key.data(), key.size() - 1, 7));
+#endif
+    }
+    
+    // Test 29: SIMD Kernel Dispatch
+    void test_simd_kernel_dispatch() {
+        using namespace json_adapter::simd;
+        [[maybe_unused]] const Kernels* reference = kernels_for(Isa::Scalar);
+        assert(reference != nullptr);
+        assert(kernels_for(kernels().isa) == &kernels());
+        
+        // Every variant this CPU runs must agree with the scalar kernels at every length and match position
+        [[maybe_unused]] static constexpr char forbidden[] = {'[', ']', '{', '}', '"', '\\'};
+        for (Isa isa : {Isa::SSE2, Isa::AVX2, Isa::AVX512}) {
+            const Kernels* table = kernels_for(isa);
+            if (!table) continue;
+            for (size_t len = 0; len <= 150; len += 7) {
+                for (size_t hit = 0; hit <= len; hit += 5) {
+                    std::string text(len, 'a');
+                    std::string other = text;
+                    if (hit < len) {
+                        text[hit] = (hit % 3 == 0) ? '\x01' : (hit % 3 == 1) ? '"' : '/';
+                        other[hit] = 'b';
+                    }
+                    assert(table->equal(text.data(), other.data(), len) == reference->equal(text.data(), other.data(), len));
+                    assert(table->find_byte(text.data(), len, '/') == reference->find_byte(text.data(), len, '/'));
+                    assert(table->find_escape(text.data(), len) == reference->find_escape(text.data(), len));
+                    assert(table->find_any(text.data(), len, forbidden, sizeof(forbidden)) ==
+                           reference->find_any(text.data(), len, forbidden, sizeof(forbidden)));
+                }
+            }
+        }
+        
+#if JSON_ADAPTER_BACKEND == AXZDICT
+        const std::string selected = AxzSimd::isa();
+        const axz_wstring text = L"plain text long enough for several vectors \"quoted\" back\\slash \t tab \x01 end";
+        for (const char* isa : {"scalar", "sse2", "avx2", "avx512"}) {
+            if (!AxzSimd::selectIsa(isa)) continue;
+            AxzDict object(AxzDictType::OBJECT);
+            object.set(L"text", AxzDict(text.c_str()));
+            axz_wstring json;
+            [[maybe_unused]] axz_rc rc = AxzJson::serialize(object, json);
+            assert(AXZ_SUCCESS(rc));
+            AxzDict parsed;
+            rc = AxzJson::deserialize(json, parsed);
+            assert(AXZ_SUCCESS(rc) && parsed[L"text"].stringVal() == text);
+        }
+        AxzSimd::selectIsa(selected.c_str());
+#endif
+    }
+    
+    // Test 32: Streaming Dump
+    void test_streaming_dump() {
+        UniversalObservableJson obs;
+        for (int i = 0; i < 2000; ++i) {
+            obs.set("key_" + std::to_string(i), std::string("value with \"quotes\" number ") + std::to_string(i));
+        }
+        
+        // Same bytes as dump(), delivered in bounded chunks
+        for (int indent : {-1, 2}) {
+            std::string streamed;
+            size_t largest = 0;
+            [[maybe_unused]] const bool ok = obs.dump_to([&](const char* data, size_t size) {
+                largest = std::max(largest, size);
+                streamed.append(data, size);
+                return true;
+            }, indent, UniversalObservableJson::DumpMode::Locked, 4096);
+            assert(ok && largest <= 4096);
+            assert(streamed == obs.dump(indent));
+        }
+        
+        // Nested and empty containers, escapes and non-ASCII text match as well
+        const json nested = json_adapter::parse(R"({"a":[1,[],{},{"b":[true,null,2.5]}],"t\u00e9xt":"line\nbreak","e":{}})");
+        for (int indent : {-1, 0, 4}) {
+            std::string streamed;
+            [[maybe_unused]] const bool ok = json_adapter::dump_to(nested, [&](const char* data, size_t size) {
+                streamed.append(data, size);
+                return true;
+            }, indent);
+            assert(ok && streamed == json_adapter::dump(nested, indent));
+        }
+        
+        // A refusing sink stops the dump
+        [[maybe_unused]] size_t calls = 0;
+        assert(!obs.dump_to([&](const char*, size_t) { ++calls; return false; }, -1, UniversalObservableJson::DumpMode::Locked, 4096));
+        assert(calls == 1);
+        
+        // Snapshot mode releases the lock before writing, so the sink may even write to the document
+        const std::string before = obs.dump();
+        std::string streamed;
+        [[maybe_unused]] bool wrote = false;
+        assert(obs.dump_to([&](const char* data, size_t size) {
+            if (!wrote) {
+                obs.set("late", 1);
+                wrote = true;
+            }
+            streamed.append(data, size);
+            return true;
+        }, -1, UniversalObservableJson::DumpMode::Snapshot, 4096));
+        assert(wrote && streamed == before && obs.get<int>("late") == 1);
+        
+#if JSON_ADAPTER_BACKEND == AXZDICT
+        // AxzDict copies alias their containers; a snapshot must not
+        AxzDict original(AxzDictType::OBJECT);
+        original.set(L"inner", AxzDict(AxzDictType::ARRAY));
+        AxzDict alias = original;
+        AxzDict copy = json_adapter::snapshot(original);
+        original[L"inner"].add(AxzDict(1));
+        assert(alias[L"inner"].size() == 1 && copy[L"inner"].size() == 0);
+#endif
+        
+#if defined(__unix__) || defined(__APPLE__)
+        FILE* file = std::tmpfile();
+        assert(file);
+        assert(obs.dump_to(json_adapter::fd_sink(fileno(file))));
+        std::rewind(file);
+        std::string from_file;
+        char buffer[4096];
+        for (size_t n; (n = std::fread(buffer, 1, sizeof(buffer), file)) > 0;) {
+            from_file.append(buffer, n);
+        }
+        std::fclose(file);
+        assert(from_file == obs.dump());
+#endif
+    }
+    
+    // Test 34: JSON Patch
+    void test_json_patch() {
+        using json_adapter::PatchOperation;
+        const json from = json_adapter::parse(
+            R"({"name":"a","n":1,"gone":true,"list":[1,2,3],"nested":{"x":1,"y":[true]},"a/b~c":0})");
+        const json to = json_adapter::parse(
+            R"({"name":"b","n":1,"list":[1,5],"nested":{"x":1,"y":[true,null]},"a/b~c":1,"new":{"k":"v"}})");
+        
+        // Only what changed, as pointers with RFC 6901 escaping
+        const auto patch = json_adapter::diff(from, to);
+        std::vector<std::string> paths;
+        for (const auto& operation : patch) {
+            paths.push_back(std::string(json_adapter::patch_op_name(operation.op)) + " " + operation.path);
+        }
+        for ([[maybe_unused]] const char* expected : {"remove /gone", "replace /name", "replace /list/1", "remove /list/2",
+                                     "add /nested/y/1", "replace /a~1b~0c", "add /new"}) {
+            assert(std::find(paths.begin(), paths.end(), expected) != paths.end());
+        }
+        assert(paths.size() == 7);
+        assert(json_adapter::diff(to, to).empty());
+        assert(json_adapter::diff(from, json_adapter::snapshot(from)).empty());
+        
+        // Applying the diff reproduces the target, also after a round trip through the wire form
+        assert(json_adapter::values_equal(json_adapter::patched(from, patch), to));
+        const auto wire = json_adapter::patch_from_json(json_adapter::parse(json_adapter::dump(json_adapter::patch_to_json(patch))));
+        assert(json_adapter::values_equal(json_adapter::patched(from, wire), to));
+        
+        // move, copy and test; a failing operation leaves the document as it was
+        json doc = json_adapter::parse(R"({"a":{"b":1},"list":[1,2]})");
+        json_adapter::apply_patch(doc, json_adapter::patch_from_json(json_adapter::parse(
+            R"([{"op":"copy","from":"/a","path":"/c"},{"op":"move","from":"/a/b","path":"/list/0"},)"
+            R"({"op":"add","path":"/list/-","value":3},{"op":"test","path":"/c/b","value":1}])")));
+        assert(json_adapter::values_equal(doc, json_adapter::parse(R"({"a":{},"c":{"b":1},"list":[1,1,2,3]})")));
+        const std::string before = json_adapter::dump(doc);
+        [[maybe_unused]] bool threw = false;
+        try {
+            json_adapter::apply_patch(doc, {{PatchOperation::Op::Remove, "/c", json_adapter::make_null(), {}},
+                                            {PatchOperation::Op::Remove, "/missing", json_adapter::make_null(), {}}});
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw && json_adapter::dump(doc) == before);
+
+        // A failure after several in-place edits replays the undo log, including moves and array edits
+        const json original = json_adapter::parse(R"({"a":{"b":1},"c":2,"list":[1,2,3],"keep":[{"x":1},{"x":2}]})");
+        json edited = json_adapter::snapshot(original);
+        threw = false;
+        try {
+            json_adapter::apply_patch(edited, json_adapter::patch_from_json(json_adapter::parse(
+                R"([{"op":"remove","path":"/c"},{"op":"add","path":"/list/1","value":9},)"
+                R"({"op":"move","from":"/a/b","path":"/list/-"},{"op":"replace","path":"/keep/1/x","value":5},)"
+                R"({"op":"copy","from":"/keep","path":"/a/k"},{"op":"add","path":"/z","value":0},)"
+                R"({"op":"test","path":"/list/0","value":2}])")));
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw && json_adapter::values_equal(edited, original));
+        
+        // The empty key is an ordinary member, and adding it is undone like any other edit
+        threw = false;
+        try {
+            json_adapter::apply_patch(edited, {{PatchOperation::Op::Add, "/", json_adapter::make_int(7), {}},
+                                               {PatchOperation::Op::Remove, "/missing", json_adapter::make_null(), {}}});
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw && json_adapter::values_equal(edited, original) && !json_adapter::has_key(edited, ""));
+
+        // Leading tests are checked before anything changes; a whole-document replace is undone too
+        threw = false;
+        try {
+            json_adapter::apply_patch(edited, {{PatchOperation::Op::Test, "/c", json_adapter::make_int(3), {}},
+                                               {PatchOperation::Op::Remove, "/c", json_adapter::make_null(), {}}});
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw && json_adapter::values_equal(edited, original));
+        threw = false;
+        try {
+            json_adapter::apply_patch(edited, {{PatchOperation::Op::Replace, "", json_adapter::make_int(1), {}},
+                                               {PatchOperation::Op::Remove, "/c", json_adapter::make_null(), {}}});
+        } catch (const std::out_of_range&) {
+            threw = true;
+        }
+        assert(threw && json_adapter::values_equal(edited, original));
+
+        json_adapter::apply_patch(edited, {{PatchOperation::Op::Replace, "/keep/1/x", json_adapter::make_int(5), {}},
+                                           {PatchOperation::Op::Remove, "/list/0", json_adapter::make_null(), {}}});
+        assert(json_adapter::values_equal(edited, json_adapter::parse(
+            R"({"a":{"b":1},"c":2,"list":[2,3],"keep":[{"x":1},{"x":5}]})")));
+
+#if JSON_ADAPTER_BACKEND == AXZDICT
+        // Edits happen in place: an untouched sibling is the same node afterwards, not a rebuilt copy
+        AxzDict tree = json_adapter::parse(R"({"rows":[{"v":0},{"v":1}],"other":{"k":true}})");
+        const AxzDict other = std::as_const(tree)[L"other"];
+        const AxzDict row1 = std::as_const(tree)[L"rows"][1];
+        json_adapter::apply_patch(tree, {{PatchOperation::Op::Replace, "/rows/0/v", json_adapter::make_int(7), {}}});
+        assert(std::as_const(tree)[L"other"].sharesValue(other));
+        assert(std::as_const(tree)[L"rows"][1].sharesValue(row1));
+        assert(json_adapter::dump(tree) == R"({"rows": [{"v": 7}, {"v": 1}], "other": {"k": true}})");
+#endif
+
+        // The observable notifies each touched path and nothing else
+        UniversalObservableJson obs(from);
+        std::mutex events_mutex;
+        std::vector<std::string> events;
+        obs.subscribe([&](const json&, const std::string& path, const json&) {
+            std::lock_guard<std::mutex> lock(events_mutex);
+            events.push_back(path);
+        });
+        obs.apply_patch(obs.diff(to));
+        obs.wait_for_notifications();
+        assert(json_adapter::values_equal(obs.get(), to));
+        {
+            std::lock_guard<std::mutex> lock(events_mutex);
+            assert(events.size() == 7);
+            assert(std::find(events.begin(), events.end(), "nested/y/1") != events.end());
+        }
+        
+#if JSON_ADAPTER_BACKEND == AXZDICT
+        // Shared AxzDict subtrees are skipped without being compared
+        AxzDict big(AxzDictType::ARRAY);
+        for (int i = 0; i < 1000; ++i) big.add(AxzDict(i));
+        AxzDict left(AxzDictType::OBJECT);
+        AxzDict right(AxzDictType::OBJECT);
+        left.set(L"big", big);
+        right.set(L"big", big);
+        right.set(L"flag", AxzDict(true));
+        const auto shared = json_adapter::diff(left, right);
+        assert(shared.size() == 1 && shared[0].path == "/flag");
+#endif
+    }
+    
+    // Test 35: Change Journal
+    void test_change_journal() {
+        using Op = ChangeJournal::Op;
+        UniversalObservableJson obs;
+        obs.set("before", 1);
+        assert(obs.journal_sequence() == 1);
+        assert(!obs.journal_enabled() && obs.read_journal(0).entries.empty() && !obs.read_journal(0).complete);
+        
+        obs.enable_journal(8);
+        obs.set("a", 1);
+        obs.set("b", std::string("two"));
+        obs.remove("a");
+        obs.remove("missing");      // nothing removed, nothing recorded
+        UniversalObservableJson other;
+        other.set("c", true);
+        obs.merge(other);
+        obs.clear();
+        
+        // Every mutation in order, with consecutive sequences after the one taken before enabling
+        auto batch = obs.read_journal(1);
+        assert(batch.complete && batch.entries.size() == 5);
+        [[maybe_unused]] const Op expected[] = {Op::Set, Op::Set, Op::Remove, Op::Merge, Op::Clear};
+        for (size_t i = 0; i < batch.entries.size(); ++i) {
+            assert(batch.entries[i].sequence == i + 2);
+            assert(batch.entries[i].op == expected[i]);
+        }
+        assert(batch.entries[1].path == "b" && json_adapter::get_string(batch.entries[1].value) == "two");
+        assert(batch.entries[3].path == "c" && json_adapter::get_bool(batch.entries[3].value));
+        assert(obs.journal_sequence() == 6);
+        
+        // Batched catch-up: resume from the last sequence seen
+        std::vector<uint64_t> seen;
+        for (uint64_t last = 1;;) {
+            auto part = obs.read_journal(last, 2);
+            if (part.entries.empty()) break;
+            for (const auto& entry : part.entries) seen.push_back(entry.sequence);
+            last = part.entries.back().sequence;
+        }
+        assert((seen == std::vector<uint64_t>{2, 3, 4, 5, 6}));
+        assert(obs.read_journal(6).complete && obs.read_journal(6).entries.empty());
+        
+        // A consumer that fell behind the ring is told to resync from a snapshot
+        for (int i = 0; i < 20; ++i) obs.set("k" + std::to_string(i), i);
+        auto late = obs.read_journal(6);
+        assert(!late.complete && late.entries.size() == 8 && late.entries.front().sequence == 19);
+        auto [doc, sequence] = obs.journal_snapshot();
+        assert(sequence == 26 && json_adapter::has_key(doc, "k19"));
+        assert(obs.read_journal(sequence).complete && obs.read_journal(sequence).entries.empty());
+        
+        // Replaying the journal reproduces the document
+        UniversalObservableJson replica(json_adapter::dump(doc));
+        obs.set("x", 5);
+        obs.remove("k0");
+        for (const auto& entry : obs.read_journal(sequence).entries) {
+            if (entry.op == Op::Remove) replica.remove(entry.path);
+            else replica.set(entry.path, entry.value);
+        }
+        assert(replica.get<int>("x") == 5 && !replica.has("k0"));
+        
+        obs.disable_journal();
+        obs.set("y", 1);
+        assert(obs.journal_sequence() == 29 && obs.read_journal(29).complete);
+        
+        // Moves carry the journal and its sequence along
+        obs.enable_journal(8);
+        obs.set("z", 2);
+        UniversalObservableJson moved(std::move(obs));
+        assert(moved.journal_enabled() && moved.journal_sequence() == 30);
+        UniversalObservableJson assigned;
+        assigned = std::move(moved);
+        assigned.set("w", 3);
+        assert(assigned.journal_sequence() == 31 && assigned.read_journal(29).entries.size() == 2);
+        
+        // Copies are independent documents: writes to one never show up in the other
+        UniversalObservableJson copied(assigned);
+        copied.set("w", 4);
+        UniversalObservableJson copy_assigned;
+        copy_assigned = assigned;
+        copy_assigned.remove("z");
+        assert(assigned.get<int>("w") == 3 && assigned.has("z"));
+        assert(copied.get<int>("w") == 4 && !copy_assigned.has("z"));
+    }
+    
+    // Test 36: Binary Snapshot
+    void test_binary_snapshot() {
+        const json doc = json_adapter::parse(
+            R"({"name":"svc","count":42,"ratio":0.5,"big":-9000000000,"on":true,"none":null,)"
+            R"("list":[1,"two",[3]],"nested":{"zeta":1,"alpha":{"deep":"x"}},"empty":{}})");
+        const auto file = (std::filesystem::temp_directory_path() /
+                           ("observable_snapshot_" + std::to_string(std::random_device{}()) + ".bin")).string();
+        json_adapter::write_snapshot(doc, file);
+        
+        // Lookups walk the mapped file; only what is asked for becomes json
+        auto reader = std::make_shared<json_adapter::SnapshotReader>(file);
+        assert(reader->has("nested/alpha/deep") && reader->has("list/2/0") && reader->has("empty"));
+        assert(!reader->has("nested/beta") && !reader->has("list/3") && !reader->has("name/x"));
+        assert(json_adapter::get_string(reader->get("nested/alpha/deep")) == "x");
+        assert(reader->find("count")->as_int() == 42 && reader->find("big")->as_int() == -9000000000LL);
+        assert(reader->find("ratio")->as_double() == 0.5 && reader->find("none")->is_null());
+        assert(reader->find("list/1")->as_string() == "two");
+        
+        // Members keep document order; the whole document round-trips
+        std::vector<std::string> order, expected;
+        reader->find("nested")->for_each_member([&](std::string_view key, const json_adapter::SnapshotValue&) {
+            order.emplace_back(key);
+        });
+        json_adapter::for_each_member(json_adapter::object_at(doc, "nested"), [&](const std::string& key, const json&) {
+            expected.push_back(key);
+        });
+        assert(order == expected);
+        assert(json_adapter::values_equal(reader->materialize(), doc));
+        assert(json_adapter::encode_snapshot(doc).size() == reader->file_size());
+        
+        // Integers and floats take the narrowest width that holds them; a double past int64_t does not convert
+        const json numbers = json_adapter::parse(R"([0,-1,300,-70000,5000000000,0.5,0.1,1e300])");
+        json_adapter::SnapshotReader widths(json_adapter::SnapshotReader::FromBuffer{}, json_adapter::encode_snapshot(numbers));
+        assert(json_adapter::values_equal(widths.materialize(), numbers));
+        assert(widths.find("3")->as_int() == -70000 && widths.find("4")->as_int() == 5000000000LL);
+        assert(widths.find("6")->as_double() == 0.1 && widths.find("5")->as_int() == 0);
+        [[maybe_unused]] bool out_of_range = false;
+        try { widths.find("7")->as_int(); } catch (const std::out_of_range&) { out_of_range = true; }
+        assert(out_of_range);
+        
+        // Truncated or foreign data is rejected instead of read out of bounds
+        std::string bytes = json_adapter::encode_snapshot(doc);
+        for (std::string broken : {bytes.substr(0, bytes.size() - 1), std::string("not a snapshot at all")}) {
+            [[maybe_unused]] bool threw = false;
+            try {
+                json_adapter::SnapshotReader bad(json_adapter::SnapshotReader::FromBuffer{}, broken);
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+        
+        // Deep nesting is refused on both sides: a hand-built chain of 200000 one-element arrays, a chain of
+        // 500 two-element arrays whose slots share one child (2^500 values), and a document too deep to write
+        auto chained = [](size_t depth, uint64_t width) {
+            std::string built(24, '\0');
+            uint64_t child = built.size();
+            built.push_back('\0');  // null
+            for (size_t level = 0; level < depth; ++level) {
+                const uint64_t at = built.size();
+                const uint64_t distance = at - child;
+                built.push_back(static_cast<char>(0x36));  // array, 8-byte fields
+                built.append(reinterpret_cast<const char*>(&width), 8);
+                for (uint64_t i = 0; i < width; ++i) built.append(reinterpret_cast<const char*>(&distance), 8);
+                child = at;
+            }
+            const uint64_t total = built.size();
+            std::memcpy(&built[0], "OJSNAP02", 8);
+            std::memcpy(&built[8], &child, 8);
+            std::memcpy(&built[16], &total, 8);
+            return built;
+        };
+        for (std::string hostile : {chained(200000, 1), chained(500, 2)}) {
+            json_adapter::SnapshotReader deep(json_adapter::SnapshotReader::FromBuffer{}, hostile);
+            [[maybe_unused]] bool threw = false;
+            try {
+                deep.materialize();
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            assert(threw);
+        }
+        json nested = json_adapter::make_array();
+        for (int level = 0; level < 600; ++level) {
+            json outer = json_adapter::make_array();
+            json_adapter::append_array(outer, nested);
+            nested = outer;
+        }
+        [[maybe_unused]] bool too_deep = false;
+        try {
+            json_adapter::encode_snapshot(nested);
+        } catch (const std::runtime_error&) {
+            too_deep = true;
+        }
+        assert(too_deep);
+        
+        // The observable saves one and loads it in the background
+        UniversalObservableJson source(doc);
+        source.save_snapshot(file);
+        UniversalObservableJson target;
+        target.set("old", 1);
+        std::atomic<int> notified{0};
+        target.subscribe([&](const json&, const std::string& path, const json&) {
+            if (path.empty()) ++notified;
+        });
+        auto loading = target.load_snapshot_async(std::make_shared<json_adapter::SnapshotReader>(file));
+        // Served from the snapshot whether or not the document is built yet
+        assert(target.get<int>("count") == 42 && !target.has("old"));
+        assert(target.get<std::string>("name") == "svc");
+        loading.get();
+        target.wait_for_notifications();
+        assert(target.get<int>("count") == 42 && target.has("nested") && notified == 1);
+        
+        std::filesystem::remove(file);
+    }
+    
+    // Test 37: MessagePack and CBOR
+    void test_msgpack_cbor() {
+        // Wire bytes fixed by the specifications
+        const json small = json_adapter::parse(R"({"a":[1,-2,true,null,"x"]})");
+        assert((json_adapter::to_msgpack(small) ==
+                std::vector<uint8_t>{0x81, 0xa1, 'a', 0x95, 0x01, 0xfe, 0xc3, 0xc0, 0xa1, 'x'}));
+        assert((json_adapter::to_cbor(small) ==
+                std::vector<uint8_t>{0xa1, 0x61, 'a', 0x85, 0x01, 0x21, 0xf5, 0xf6, 0x61, 'x'}));
+        
+        // Round trips keep every value, including sizes that switch to wider headers
+        json doc = json_adapter::parse(
+            R"({"int":300,"neg":-70000,"big":4294967296,"half":0.5,"pi":3.141592653589793,"text":"h\u00e9llo",)"
+            R"("nested":{"list":[[],{},"",0]},"flag":false})");
+        json_adapter::set_member(doc, "long", json_adapter::make_string(std::string(70000, 'z')));
+        json many = json_adapter::make_array();
+        for (int i = 0; i < 300; ++i) json_adapter::append_array(many, json_adapter::make_int(i));
+        json_adapter::set_member(doc, "many", many);
+        
+        assert(json_adapter::values_equal(json_adapter::from_msgpack(json_adapter::to_msgpack(doc)), doc));
+        assert(json_adapter::values_equal(json_adapter::from_cbor(json_adapter::to_cbor(doc)), doc));
+#if JSON_ADAPTER_BACKEND == NLOHMANN_JSON || JSON_ADAPTER_BACKEND == JSONCPP
+        // Backends with 64-bit integers get them back as integers
+        const json big = json_adapter::object_at(json_adapter::from_cbor(json_adapter::to_cbor(doc)), "big");
+        assert(json_adapter::is_integer(big) && json_adapter::get_double(big) == 4294967296.0);
+#endif
+        assert(json_adapter::to_msgpack(doc).size() < json_adapter::dump(doc).size());
+        
+        // Numbers keep their stored type: a whole double stays a double and -0.0 keeps its sign
+        for (const json& number : {json_adapter::make_double(2.0), json_adapter::make_double(-0.0), json_adapter::make_int(2)}) {
+            for ([[maybe_unused]] const json& back : {json_adapter::from_msgpack(json_adapter::to_msgpack(number)),
+                                     json_adapter::from_cbor(json_adapter::to_cbor(number)),
+                                     json_adapter::SnapshotReader(json_adapter::SnapshotReader::FromBuffer{},
+                                                                  json_adapter::encode_snapshot(number)).materialize()}) {
+                assert(json_adapter::is_integer(back) == json_adapter::is_integer(number));
+                assert(json_adapter::get_double(back) == json_adapter::get_double(number));
+                assert(std::signbit(json_adapter::get_double(back)) == std::signbit(json_adapter::get_double(number)));
+            }
+        }
+        
+        // CBOR from other encoders: indefinite lengths, half floats and tags
+        const std::vector<uint8_t> streamed = {0xbf, 0x61, 'k', 0x9f, 0xf9, 0x3c, 0x00, 0xd8, 0x64, 0x1a, 0x00, 0x00, 0x00, 0x01, 0xff,
+                                               0x7f, 0x62, 'a', 'b', 0x61, 'c', 0xff, 0xf6, 0xff};
+        assert(json_adapter::values_equal(json_adapter::from_cbor(streamed), json_adapter::parse(R"({"k":[1.0,1],"abc":null})")));
+        
+        // Malformed input throws instead of reading past the end
+        [[maybe_unused]] auto rejects = [](auto decode, std::vector<uint8_t> bytes) {
+            try {
+                decode(bytes);
+            } catch (const std::runtime_error&) {
+                return true;
+            }
+            return false;
+        };
+        [[maybe_unused]] auto msgpack = [](const std::vector<uint8_t>& b) { return json_adapter::from_msgpack(b); };
+        [[maybe_unused]] auto cbor = [](const std::vector<uint8_t>& b) { return json_adapter::from_cbor(b); };
+        assert(rejects(msgpack, {0xdb, 0xff, 0xff, 0xff, 0xff, 'a'}));
+        assert(rejects(msgpack, {0xdd, 0x7f, 0xff, 0xff, 0xff}));
+        assert(rejects(msgpack, {0xc0, 0xc0}));
+        assert(rejects(cbor, {0x9f, 0x01}));
+        assert(rejects(cbor, {0xa1, 0x01, 0x02}));
+        assert(rejects(cbor, std::vector<uint8_t>(1000, 0x81)));
+        
+        // Nesting past the depth limit throws instead of exhausting the stack; stacked tags are skipped
+        std::vector<uint8_t> tags(1 << 20, 0xc6);
+        assert(rejects(cbor, tags));
+        tags.push_back(0x07);
+        assert(json_adapter::get_int(json_adapter::from_cbor(tags)) == 7);
+        std::vector<uint8_t> tagged_arrays;
+        for (int i = 0; i < 100000; ++i) tagged_arrays.insert(tagged_arrays.end(), {0xc6, 0x81});
+        assert(rejects(cbor, tagged_arrays));
+        assert(rejects(cbor, std::vector<uint8_t>(1 << 20, 0x81)));
+        assert(rejects(msgpack, std::vector<uint8_t>(1 << 20, 0x91)));
+    }
+    
+    // Test 38: Write-Ahead Log
+    void test_write_ahead_log() {
+        const auto dir = std::filesystem::temp_directory_path() /
+                         ("observable_wal_" + std::to_string(std::random_device{}()));
+        auto segment = [&] {
+            std::filesystem::path last;
+            for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+                if (entry.path().extension() == ".log" && entry.path() > last) last = entry.path();
+            }
+            return last;
+        };
+        
+        // Every mutator is logged; a new instance recovers checkpoint plus log
+        {
+            UniversalObservableJson obs;
+            obs.set("initial", 1);
+            obs.enable_durability(dir.string());
+            assert(obs.durability_enabled());
+            obs.set("name", std::string("svc"));
+            obs.set("count", 1);
+            obs.remove("initial");
+            obs.set_batch(std::vector<std::pair<std::string, int>>{{"a", 1}, {"b", 2}});
+            obs.apply_patch(json_adapter::diff(obs.get(), json_adapter::parse(
+                R"({"name":"svc","count":2,"a":1,"b":2,"list":[1,2]})")));
+            UniversalObservableJson moved(std::move(obs));     // the log moves with the document
+            assert(moved.durability_enabled());
+            moved.set("moved", true);
+        }
+        {
+            UniversalObservableJson obs;
+            std::atomic<int> notified{0};
+            obs.subscribe([&](const json&, const std::string& path, const json&) {
+                if (path.empty()) ++notified;
+            });
+            obs.enable_durability(dir.string());
+            obs.wait_for_notifications();
+            assert(notified == 1 && !obs.has("initial"));
+            assert(obs.get<int>("count") == 2 && obs.get<std::string>("name") == "svc");
+            assert(obs.get<int>("b") == 2 && json_adapter::array_size(obs.get("list")) == 2);
+            assert(obs.get<bool>("moved"));
+            obs.set("after_restart", true);
+        }
+        
+        // A torn record at the tail is dropped, the records before it survive
+        {
+            std::ofstream torn(segment(), std::ios::binary | std::ios::app);
+            torn.write("\x40\x00\x00\x00garbage", 11);
+        }
+        {
+            UniversalObservableJson obs;
+            obs.enable_durability(dir.string());
+            assert(obs.get<bool>("after_restart") && obs.get<int>("count") == 2);
+            
+            // A checkpoint leaves one empty segment behind
+            obs.clear();
+            obs.set("x", 1);
+            obs.checkpoint();
+            assert(std::filesystem::file_size(segment()) == 8);
+        }
+        
+        // Concurrent writers share syncs; all of their writes come back
+        {
+            UniversalObservableJson obs;
+            obs.enable_durability(dir.string());
+            std::vector<std::thread> writers;
+            for (int t = 0; t < 4; ++t) {
+                writers.emplace_back([&obs, t] {
+                    for (int i = 0; i < 25; ++i) obs.set("w" + std::to_string(t) + "_" + std::to_string(i), i);
+                });
+            }
+            for (auto& writer : writers) writer.join();
+        }
+        {
+            UniversalObservableJson obs;
+            obs.enable_durability(dir.string());
+            assert(obs.get<int>("x") == 1 && obs.get<int>("w3_24") == 24 && obs.get<int>("w0_0") == 0);
+            
+            [[maybe_unused]] bool threw = false;
+            try {
+                obs.enable_durability(dir.string());
+            } catch (const std::logic_error&) {
+                threw = true;
+            }
+            assert(threw);
+            obs.disable_durability();
+            assert(!obs.durability_enabled());
+        }
+        
+        // A value nested deeper than the log can replay is refused before the document changes
+        {
+            UniversalObservableJson obs;
+            obs.enable_durability(dir.string());
+            json deep = json_adapter::make_int(1);
+            for (int i = 0; i <= json_adapter::binary_detail::MAX_DEPTH; ++i) {
+                json wrapper = json_adapter::make_array();
+                json_adapter::append_array(wrapper, deep);
+                deep = std::move(wrapper);
+            }
+            [[maybe_unused]] bool refused = false;
+            try {
+                obs.set("deep", deep);
+            } catch (const std::invalid_argument&) {
+                refused = true;
+            }
+            assert(refused && !obs.has("deep"));
+            obs.set("after_deep", 1);
+        }
+        
+        // A record that passes its checksum but does not decode stops recovery; it is not cut off as a torn
+        // tail along with whatever follows it
+        {
+            std::string payload;
+            json_adapter::wal_detail::put<uint64_t>(payload, uint64_t{1} << 40);
+            payload.push_back(1);                                   // Set
+            json_adapter::wal_detail::put<uint32_t>(payload, 1);
+            payload += "k\xc1";                                    // 0xc1 is never valid MessagePack
+            std::string record;
+            json_adapter::wal_detail::put<uint32_t>(record, static_cast<uint32_t>(payload.size()));
+            json_adapter::wal_detail::put<uint32_t>(record, json_adapter::wal_detail::crc32(payload.data(), payload.size()));
+            record += payload;
+            
+            const auto log = segment();
+            const auto intact = std::filesystem::file_size(log);
+            {
+                std::ofstream out(log, std::ios::binary | std::ios::app);
+                out.write(record.data(), static_cast<std::streamsize>(record.size()));
+            }
+            UniversalObservableJson obs;
+            [[maybe_unused]] bool threw = false;
+            try {
+                obs.enable_durability(dir.string());
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            assert(threw && !obs.durability_enabled());
+            assert(std::filesystem::file_size(log) == intact + record.size());
+            
+            std::filesystem::resize_file(log, intact);
+            obs.enable_durability(dir.string());
+            assert(obs.get<int>("after_deep") == 1 && obs.get<int>("x") == 1);
+        }
+        
+#if defined(__linux__)
+        // A failed write: the change is visible, so it is notified and then reported to the writer; the
+        // document refuses further writes until durability is enabled again, which reloads the disk state
+        {
+            UniversalObservableJson obs;
+            obs.enable_durability(dir.string());
+            std::mutex events_mutex;
+            std::vector<std::string> events;
+            obs.subscribe([&](const json&, const std::string& path, const json&) {
+                std::lock_guard<std::mutex> lock(events_mutex);
+                events.push_back(path);
+            });
+            
+            rlimit saved{};
+            getrlimit(RLIMIT_FSIZE, &saved);
+            const auto previous_handler = std::signal(SIGXFSZ, SIG_IGN);
+            rlimit capped = saved;
+            capped.rlim_cur = static_cast<rlim_t>(std::filesystem::file_size(segment()) + 16);
+            setrlimit(RLIMIT_FSIZE, &capped);
+            
+            [[maybe_unused]] bool failed = false;
+            try {
+                obs.set("lost", std::string(4096, 'x'));
+            } catch (const std::runtime_error&) {
+                failed = true;
+            }
+            setrlimit(RLIMIT_FSIZE, &saved);
+            std::signal(SIGXFSZ, previous_handler);
+            
+            obs.wait_for_notifications();
+            assert(failed && obs.has("lost"));
+            {
+                std::lock_guard<std::mutex> lock(events_mutex);
+                assert(std::count(events.begin(), events.end(), "lost") == 1);
+            }
+            
+            [[maybe_unused]] bool refused = false;
+            try {
+                obs.set("after_failure", 1);
+            } catch (const std::runtime_error&) {
+                refused = true;
+            }
+            assert(refused && !obs.has("after_failure"));
+            
+            obs.disable_durability();
+            obs.enable_durability(dir.string());
+            assert(!obs.has("lost") && obs.get<int>("x") == 1);
+            obs.set("after_recovery", 1);
+            obs.wait_for_notifications();
+        }
+#endif
+        
+        std::filesystem::remove_all(dir);
+    }
+    
+    // Test 39: Async File Writer
+    void test_async_file_writer() {
+        const auto dir = std::filesystem::temp_directory_path() /
+                         ("observable_writer_" + std::to_string(std::random_device{}()));
+        std::filesystem::create_directories(dir);
+        auto read = [](const std::filesystem::path& file) {
+            std::ifstream in(file, std::ios::binary);
+            return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        };
+        
+        using Backend = json_adapter::AsyncWriterOptions::Backend;
+        for (Backend backend : {Backend::Auto, Backend::Pwrite}) {
+            json_adapter::AsyncWriterOptions options;
+            options.backend = backend;
+            options.buffer_size = 8192;     // several chunks per file, padded last block
+            options.buffer_count = 3;
+            json_adapter::AsyncFileWriter writer(options);
+            assert(backend == Backend::Auto || std::string(writer.backend_name()) == "pwrite");
+            
+            // Many files in flight share the buffers; each lands whole under its own name
+            std::vector<std::future<void>> pending;
+            std::vector<std::string> expected;
+            for (int i = 0; i < 12; ++i) {
+                expected.push_back(std::string(i * 3001, static_cast<char>('a' + i)));
+                pending.push_back(writer.write_file((dir / ("file" + std::to_string(i))).string(), expected.back()));
+            }
+            for (auto& done : pending) done.get();
+            for (int i = 0; i < 12; ++i) {
+                assert(read(dir / ("file" + std::to_string(i))) == expected[i]);
+                assert(!std::filesystem::exists(dir / ("file" + std::to_string(i) + ".tmp")));
+            }
+            
+            // Failures come back through the future
+            [[maybe_unused]] bool threw = false;
+            try {
+                writer.write_file((dir / "missing" / "file").string(), "x").get();
+            } catch (const std::runtime_error&) {
+                threw = true;
+            }
+            assert(threw);
+            
+            // The observable hands its serialized document to the writer
+            UniversalObservableJson obs;
+            obs.set("name", std::string("svc"));
+            obs.set("count", 3);
+            obs.persist_async(writer, (dir / "doc.json").string()).get();
+            UniversalObservableJson loaded(read(dir / "doc.json"));
+            assert(loaded.get<int>("count") == 3 && loaded.get<std::string>("name") == "svc");
+        }
+        
+        std::filesystem::remove_all(dir);
+    }
+    
+    // Test 40: Memory-Mapped Observable
+    void test_mapped_observable() {
+        const auto file = (std::filesystem::temp_directory_path() /
+                           ("observable_mapped_" + std::to_string(std::random_device{}()) + ".map")).string();
+        {
+            MappedObservableJson doc(file, 8192);     // small, so the file has to grow and be remapped
+            std::vector<std::string> paths;
+            std::mutex paths_mutex;
+            doc.subscribe([&](const json&, const std::string& path, const json&) {
+                std::lock_guard<std::mutex> lock(paths_mutex);
+                paths.push_back(path);
+            }, "users/42/name");
+            
+            // Nested paths resolve at every level; missing objects are created
+            doc.set("users/42/name", std::string("ann"));
+            doc.set("count", 3);
+            doc.set("ratio", 0.25);
+            doc.set("on", true);
+            doc.set("list", json_adapter::parse(R"([1,"two",{"three":3}])"));
+            doc.set("list/3", 4);                     // index == size appends
+            doc.remove("list/0");                     // later elements shift down
+            assert(doc.get<std::string>("users/42/name") == "ann" && doc.get<int>("list/1/three") == 3);
+            assert(doc.get<double>("ratio") == 0.25 && doc.get<bool>("on") && doc.get<int>("list/2") == 4);
+            assert(json_adapter::array_size(doc.get("list")) == 3 && doc.size() == 5);
+            doc.set("list/3/a/b", 5);                 // missing objects under an appended item
+            assert(doc.get<int>("list/3/a/b") == 5);
+            doc.remove("list/3");
+            
+            for (int i = 0; i < 3000; ++i) doc.set("key" + std::to_string(i), i);
+            for (int i = 0; i < 3000; i += 2) doc.remove("key" + std::to_string(i));
+            assert(doc.size() == 1505 && doc.has("key1") && !doc.has("key2"));
+            
+            // Errors match UniversalObservableJson's
+            [[maybe_unused]] bool threw = false;
+            try { doc.get<int>("missing"); } catch (const std::runtime_error&) { threw = true; }
+            assert(threw);
+            threw = false;
+            try { doc.set("count/x", 1); } catch (const std::invalid_argument&) { threw = true; }
+            assert(threw);
+            threw = false;
+            try { doc.set("list/9", 1); } catch (const std::out_of_range&) { threw = true; }
+            assert(threw);
+            
+            doc.wait_for_notifications();
+            assert(paths == std::vector<std::string>{"users/42/name"});
+            doc.flush();
+        }
+        {
+            // Reopening maps the same tree, at whatever address
+            MappedObservableJson doc(file);
+            assert(doc.get<std::string>("users/42/name") == "ann" && doc.get<int>("key2999") == 2999);
+            assert(doc.size() == 1505 && !doc.has("key0"));
+            
+            // Freed blocks are reused, so churn does not grow the file
+            [[maybe_unused]] const uint64_t size = doc.file_size();
+            for (int round = 0; round < 10; ++round) {
+                for (int i = 0; i < 500; ++i) doc.set("tmp" + std::to_string(i), std::string(64, 'x'));
+                for (int i = 0; i < 500; ++i) doc.remove("tmp" + std::to_string(i));
+            }
+            assert(doc.file_size() == size);
+            
+            std::vector<std::pair<std::string, int>> batch{{"b1", 1}, {"b2", 2}};
+            doc.set_batch(batch);
+            doc.clear();
+            assert(doc.empty() && json_adapter::values_equal(doc.get(), json_adapter::make_object()));
+            doc.set("kept", 1);
+        }
+        {
+            // A file longer than its recorded capacity (growth cut short) still opens
+            std::filesystem::resize_file(file, std::filesystem::file_size(file) + 8192);
+            MappedObservableJson doc(file);
+            assert(doc.get<int>("kept") == 1);
+        }
+        {
+            // A root offset past the end is refused rather than followed
+            std::fstream raw(file, std::ios::in | std::ios::out | std::ios::binary);
+            const uint64_t bad_root = uint64_t(1) << 40;
+            raw.seekp(16);
+            raw.write(reinterpret_cast<const char*>(&bad_root), sizeof(bad_root));
+        }
+        [[maybe_unused]] bool refused = false;
+        try { MappedObservableJson doc(file); } catch (const std::runtime_error&) { refused = true; }
+        assert(refused);
+        std::filesystem::remove(file);
+    }
+    
+    // Test 41: Value Views
+    void test_value_views() {
+        const json doc = json_adapter::parse(R"({"n":7,"pi":2.5,"s":"hi","ok":true,"list":[1,{"k":"v"}],"nil":null})");
+        
+        // Views read in place and report missing members / elements instead of throwing
+        [[maybe_unused]] auto list = json_adapter::member_ref(doc, "list");
+        assert(list && list.is_array() && list.array_size() == 2);
+        assert(list.at(0).get_int() == 1 && list.at(1).member("k").get_string() == "v");
+        assert(!list.at(2) && !list.member("k") && !json_adapter::member_ref(doc, "missing"));
+        assert(json_adapter::member_ref(doc, "pi").get_double() == 2.5 && json_adapter::member_ref(doc, "ok").get_bool());
+        assert(json_adapter::member_ref(doc, "nil").is_null() && !json_adapter::member_ref(doc, "n").member("x"));
+        assert(json_adapter::values_equal(list.at(1).to_json(), json_adapter::parse(R"({"k":"v"})")));
+        assert(json_adapter::element_ref(json_adapter::member_ref(doc, "list").to_json(), 0).get_int() == 1);
+        
+        // Typed reads next to a large member, and writes with and without a subscriber on the path
+        UniversalObservableJson obs;
+        json big = json_adapter::make_array();
+        for (int i = 0; i < 10000; ++i) json_adapter::append_array(big, json_adapter::make_string("item" + std::to_string(i)));
+        obs.set("big", big);
+        obs.set("count", 1);
+        assert(obs.get<int>("count") == 1 && obs.get<int>("count/ignored") == 1);
+        assert(json_adapter::array_size(obs.get("big")) == 10000 && obs.has("big") && !obs.has("nope"));
+        
+        std::vector<std::pair<int, int>> seen;
+        std::mutex seen_mutex;
+        auto id = obs.subscribe([&](const json& new_val, const std::string&, const json& old_val) {
+            std::lock_guard<std::mutex> lock(seen_mutex);
+            seen.emplace_back(json_adapter::is_null(new_val) ? -1 : json_adapter::get_int(new_val),
+                              json_adapter::is_null(old_val) ? -1 : json_adapter::get_int(old_val));
+        }, std::string("count"));
+        
+        obs.set("big", 0);           // not observed
+        obs.set("count", 2);
+        std::vector<std::pair<std::string, int>> batch{{"count", 3}, {"other", 9}};
+        obs.set_batch(batch);
+        obs.remove("count");
+        obs.wait_for_notifications();
+        {
+            std::lock_guard<std::mutex> lock(seen_mutex);
+            assert((seen == std::vector<std::pair<int, int>>{{2, 1}, {3, 2}, {-1, 3}}));
+        }
+        assert(obs.get<int>("big") == 0 && obs.get<int>("other") == 9);
+        
+        [[maybe_unused]] bool threw = false;
+        try {
+            obs.get<int>("count");
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        obs.unsubscribe(id);
+    }
+    
+    // Test 42: Parse Fidelity (the simdjson front end must build the same tree as the native parsers)
+    void test_parse_fidelity() {
+        const std::string text = R"({"id":-42,"big":5000000000,"pi":3.25,"ok":false,"none":null,)"
+                                 R"("name":"tab\tq\"\u00e9","list":[1,[2,[3]],{"deep":{"x":"y"}}],"empty":{}})";
+        json doc = json_adapter::parse(text);
+        assert(json_adapter::member_ref(doc, "id").get_int() == -42);
+        assert(json_adapter::member_ref(doc, "big").get_double() == 5000000000.0);
+        assert(json_adapter::member_ref(doc, "pi").get_double() == 3.25);
+        assert(!json_adapter::member_ref(doc, "ok").get_bool() && json_adapter::member_ref(doc, "none").is_null());
+        assert(json_adapter::member_ref(doc, "name").get_string() == "tab\tq\"\xC3\xA9");
+        [[maybe_unused]] auto list = json_adapter::member_ref(doc, "list");
+        assert(list.array_size() == 3 && list.at(1).at(1).at(0).get_int() == 3);
+        assert(list.at(2).member("deep").member("x").get_string() == "y");
+        assert(json_adapter::member_ref(doc, "empty").is_object());
+        
+        // Dump and parse again: the second tree serializes identically
+        const std::string once = json_adapter::dump(doc);
+        assert(json_adapter::dump(json_adapter::parse(once)) == once);
+        
+        for (const char* bad : {R"({"a":})", "[1,2", R"({"a" 1})"}) {
+            [[maybe_unused]] bool threw = false;
+            try { (void)json_adapter::parse(bad); } catch (const std::exception&) { threw = true; }
+            assert(threw);
+        }
+        
+        // The empty string is a key like any other
+        json empty_key = json_adapter::parse(R"({"":1})");
+        assert(json_adapter::has_key(empty_key, "") && json_adapter::member_ref(empty_key, "").get_int() == 1);
+        json_adapter::set_member(empty_key, "", json_adapter::make_int(2));
+        assert(json_adapter::get_int(json_adapter::object_at(empty_key, "")) == 2);
+        json_adapter::remove_member(empty_key, "");
+        assert(!json_adapter::has_key(empty_key, ""));
+        
+#if JSON_ADAPTER_SIMDJSON_PARSE
+        // Trailing text is rejected
+        bool trailing = false;
+        try { (void)json_adapter::parse("{} x"); } catch (const std::exception&) { trailing = true; }
+        assert(trailing);
+        assert(json_adapter::get_backend_name().find("simdjson") == 0);
+#endif
+    }
+    
+    // Test 43: Backend-Neutral Handle (one backend per translation unit, chosen by name at run time)
+    void test_any_observable_handle() {
+        const std::string backend(json_adapter::get_backend_name());
+        auto backends = any_observable_backends();
+        assert(std::find(backends.begin(), backends.end(), backend) != backends.end());
+        
+        auto doc = make_any_observable(backend, R"({"seed":7})");
+        assert(doc->backend_name() == backend && doc->get<int>("seed") == 7);
+        
+        std::vector<std::string> changed;
+        std::mutex changed_mutex;
+        size_t id = doc->subscribe([&](const std::string& path) {
+            std::lock_guard<std::mutex> lock(changed_mutex);
+            changed.push_back(path);
+        });
+        doc->set("flag", true);
+        doc->set("count", 42L);
+        doc->set("ratio", 0.5f);
+        doc->set("name", "handle");
+        doc->set_json("tags", R"(["a","b"])");
+        doc->wait_for_notifications();
+        {
+            std::lock_guard<std::mutex> lock(changed_mutex);
+            assert(changed.size() == 5 && changed.front() == "flag" && changed.back() == "tags");
+        }
+        assert(doc->get<bool>("flag") && doc->get<long>("count") == 42 && doc->get<double>("ratio") == 0.5);
+        assert(doc->get<std::string>("name") == "handle" && doc->size() == 6);
+        assert(json_adapter::array_size(json_adapter::parse(doc->get_json("tags"))) == 2);
+        
+        doc->unsubscribe(id);
+        doc->remove("seed");
+        assert(!doc->has("seed") && doc->size() == 5);
+        [[maybe_unused]] bool missing = false;
+        try { (void)doc->get<int>("seed"); } catch (const std::runtime_error&) { missing = true; }
+        assert(missing);
+        
+        // The typed document behind the handle, for code built against the same backend
+        [[maybe_unused]] auto* typed = dynamic_cast<BackendObservableJson*>(doc.get());
+        assert(typed && typed->document().get<int>("count") == 42);
+        assert(doc->dump() == typed->document().dump());
+        
+        doc->clear();
+        assert(doc->size() == 0 && make_any_observable(backend)->size() == 0);
+        
+        [[maybe_unused]] bool unknown = false;
+        try { (void)make_any_observable("no such backend"); } catch (const std::invalid_argument&) { unknown = true; }
+        assert(unknown);
+    }
 } // namespace tests
 
 // ==================== MAIN TEST RUNNER ====================
@@ -726,6 +2263,31 @@ int main() {
     TestFramework::run_test("Memory and Performance", tests::test_memory_performance);
     TestFramework::run_test("Error Recovery", tests::test_error_recovery);
     TestFramework::run_test("Backend Compatibility", tests::test_backend_compatibility);
+#if JSON_ADAPTER_BACKEND == AXZDICT
+    TestFramework::run_test("AxzDict Lazy Parsing", tests::test_axzdict_lazy_parsing);
+    TestFramework::run_test("AxzDict Arena Allocation", tests::test_axzdict_arena_allocation);
+    TestFramework::run_test("AxzDict Inline Scalars", tests::test_axzdict_inline_scalars);
+    TestFramework::run_test("AxzDict Composite Operations", tests::test_axzdict_composite_operations);
+    TestFramework::run_test("AxzDict Interned Object Keys", tests::test_axzdict_interned_keys);
+    TestFramework::run_test("AxzDict Object Shapes", tests::test_axzdict_object_shapes);
+    TestFramework::run_test("AxzDict Small Object Lookup", tests::test_axzdict_small_object_lookup);
+    TestFramework::run_test("AxzDict JSON Writer", tests::test_axzdict_json_writer);
+    TestFramework::run_test("AxzDict UTF-8 Output", tests::test_axzdict_utf8_output);
+    TestFramework::run_test("AxzDict Serialization Cache", tests::test_axzdict_serialization_cache);
+#endif
+    TestFramework::run_test("Key Hashing", tests::test_key_hashing);
+    TestFramework::run_test("SIMD Kernel Dispatch", tests::test_simd_kernel_dispatch);
+    TestFramework::run_test("Streaming Dump", tests::test_streaming_dump);
+    TestFramework::run_test("JSON Patch", tests::test_json_patch);
+    TestFramework::run_test("Change Journal", tests::test_change_journal);
+    TestFramework::run_test("Binary Snapshot", tests::test_binary_snapshot);
+    TestFramework::run_test("MessagePack and CBOR", tests::test_msgpack_cbor);
+    TestFramework::run_test("Write-Ahead Log", tests::test_write_ahead_log);
+    TestFramework::run_test("Async File Writer", tests::test_async_file_writer);
+    TestFramework::run_test("Memory-Mapped Observable", tests::test_mapped_observable);
+    TestFramework::run_test("Value Views", tests::test_value_views);
+    TestFramework::run_test("Parse Fidelity", tests::test_parse_fidelity);
+    TestFramework::run_test("Backend-Neutral Handle", tests::test_any_observable_handle);
     
     TestFramework::print_summary();
     